@@ -0,0 +1,420 @@
+/*******************************************************************************
+   Filename: arena.c
+
+     Author: David C. Drake (https://davidcdrake.com)
+
+Description: Arena (region) memory allocation for the text-based RPG "Words of
+             Power." Allocations are carved sequentially out of large blocks
+             and are never freed individually: a caller records a mark, makes
+             any number of allocations, then releases everything allocated
+             since the mark in one step. Also provides a string builder that
+             composes text in arena memory, tracking the string's length so
+             that each append costs only the length of what is appended.
+*******************************************************************************/
+
+#include "wop.h"
+
+/*******************************************************************************
+   Function: ArenaAllocate
+
+Description: Allocates a given number of bytes from an arena, adding a new block
+             to the arena if the current block lacks space. The memory is not
+             initialized.
+
+     Inputs: arena - Pointer to the arena of interest.
+             size  - Number of bytes to allocate.
+
+    Outputs: Pointer to the allocated memory (or NULL if allocation fails).
+*******************************************************************************/
+void *ArenaAllocate(arena_t *arena, size_t size) {
+  arena_block_t *block = arena->current;
+  size_t offset;
+
+  if (block != NULL) {
+    offset = (block->used + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+    if (offset + size <= block->size) {
+      block->used = offset + size;
+      return block->data + offset;
+    }
+  }
+  block = AddArenaBlock(arena, size);
+  if (block == NULL) {
+    return NULL;
+  }
+  block->used = size;
+
+  return block->data;
+}
+
+/*******************************************************************************
+   Function: ArenaExtend
+
+Description: Attempts to grow the most recent allocation made from an arena in
+             place (i.e., without moving it).
+
+     Inputs: arena    - Pointer to the arena of interest.
+             memory   - Pointer to the allocation to be extended.
+             old_size - Current size of the allocation in bytes.
+             new_size - Desired size of the allocation in bytes.
+
+    Outputs: true if the allocation now has (at least) the desired size.
+*******************************************************************************/
+bool ArenaExtend(arena_t *arena, void *memory, size_t old_size,
+                 size_t new_size) {
+  arena_block_t *block = arena->current;
+
+  if (block == NULL ||
+      (char *) memory + old_size != block->data + block->used ||
+      (char *) memory - block->data + new_size > block->size) {
+    return false;
+  }
+  block->used = (char *) memory - block->data + new_size;
+
+  return true;
+}
+
+/*******************************************************************************
+   Function: ArenaMark
+
+Description: Records an arena's current position so that everything allocated
+             after this point can later be released via "ArenaRelease".
+
+     Inputs: arena - Pointer to the arena of interest.
+
+    Outputs: The arena's current position.
+*******************************************************************************/
+arena_mark_t ArenaMark(arena_t *arena) {
+  arena_mark_t mark;
+
+  mark.block = arena->current;
+  mark.used = arena->current != NULL ? arena->current->used : 0;
+
+  return mark;
+}
+
+/*******************************************************************************
+   Function: ArenaRelease
+
+Description: Releases everything allocated from an arena since a given mark.
+             Blocks added after the mark are freed, except that an arena's
+             first block is kept (emptied) for reuse.
+
+     Inputs: arena - Pointer to the arena of interest.
+             mark  - A position previously returned by "ArenaMark".
+
+    Outputs: None.
+*******************************************************************************/
+void ArenaRelease(arena_t *arena, arena_mark_t mark) {
+  arena_block_t *block;
+
+  while (arena->current != mark.block) {
+    block = arena->current;
+    if (mark.block == NULL && block->previous == NULL) {
+      block->used = 0;  // Keep the first block for next time.
+      return;
+    }
+    arena->current = block->previous;
+    FreeArenaBlock(block);
+  }
+  if (arena->current != NULL) {
+    arena->current->used = mark.used;
+  }
+}
+
+/*******************************************************************************
+   Function: ResetArena
+
+Description: Releases everything ever allocated from an arena in one step,
+             keeping the arena's first block (emptied) for reuse.
+
+     Inputs: arena - Pointer to the arena of interest.
+
+    Outputs: None.
+*******************************************************************************/
+void ResetArena(arena_t *arena) {
+  arena_mark_t start = {NULL, 0};
+
+  ArenaRelease(arena, start);
+}
+
+/*******************************************************************************
+   Function: DestroyArena
+
+Description: Frees all memory held by an arena. (The arena itself may be reused
+             afterward.)
+
+     Inputs: arena - Pointer to the arena of interest.
+
+    Outputs: None.
+*******************************************************************************/
+void DestroyArena(arena_t *arena) {
+  arena_block_t *block;
+
+  while (arena->current != NULL) {
+    block = arena->current;
+    arena->current = block->previous;
+    FreeArenaBlock(block);
+  }
+}
+
+/*******************************************************************************
+   Function: AddArenaBlock
+
+Description: Adds a new, empty block to an arena. The block is large enough for
+             an allocation of the given size and at least the arena's block
+             size. If the arena wants huge pages, the block is rounded up to a
+             whole number of them and mapped directly; should that fail (e.g.,
+             no huge pages are reserved), an ordinary block is used instead.
+
+     Inputs: arena - Pointer to the arena of interest.
+             size  - Size of the allocation the block must accommodate.
+
+    Outputs: Pointer to the new block (or NULL if allocation fails).
+*******************************************************************************/
+arena_block_t *AddArenaBlock(arena_t *arena, size_t size) {
+  arena_block_t *block = MAP_FAILED;
+  size_t mapped_size;
+
+  if (size < arena->block_size) {
+    size = arena->block_size;
+  }
+  if (size < ARENA_BLOCK_SIZE) {
+    size = ARENA_BLOCK_SIZE;
+  }
+#ifdef MAP_HUGETLB
+  if (arena->huge_pages) {
+    mapped_size = (sizeof(arena_block_t) + size + HUGE_PAGE_SIZE - 1) /
+                  HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    block = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (block != MAP_FAILED) {
+      size = mapped_size - sizeof(arena_block_t);
+      block->mapped = true;
+    }
+  }
+#endif
+  if (block == MAP_FAILED) {
+    block = malloc(sizeof(arena_block_t) + size);
+    if (block == NULL) {
+      return NULL;
+    }
+    block->mapped = false;
+  }
+  block->previous = arena->current;
+  block->size = size;
+  block->used = 0;
+  arena->current = block;
+
+  return block;
+}
+
+/*******************************************************************************
+   Function: FreeArenaBlock
+
+Description: Returns an arena block's memory to the system.
+
+     Inputs: block - Pointer to the block to be freed.
+
+    Outputs: None.
+*******************************************************************************/
+void FreeArenaBlock(arena_block_t *block) {
+  if (block->mapped) {
+    munmap(block, sizeof(arena_block_t) + block->size);
+  } else {
+    free(block);
+  }
+}
+
+/*******************************************************************************
+   Function: InitStringBuilder
+
+Description: Prepares a string builder to compose a new (initially empty)
+             string in a given arena. The string remains valid until the arena
+             is released past the point at which this function was called.
+
+     Inputs: sb    - Pointer to the string builder.
+             arena - Pointer to the arena that will hold the string.
+
+    Outputs: None.
+*******************************************************************************/
+void InitStringBuilder(string_builder_t *sb, arena_t *arena) {
+  sb->arena = arena;
+  sb->data = "";  // Never written to: capacity 0 forces an allocation first.
+  sb->length = 0;
+  sb->capacity = 0;
+  ReserveString(sb, LONG_STR_LEN);
+}
+
+/*******************************************************************************
+   Function: AppendString
+
+Description: Appends a given string to the end of a string builder's string.
+
+     Inputs: sb  - Pointer to the string builder.
+             str - The string to be appended (NULL-terminated).
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int AppendString(string_builder_t *sb, const char *str) {
+  int length = strlen(str);
+
+  if (ReserveString(sb, length) == FAILURE) {
+    return FAILURE;
+  }
+  memcpy(sb->data + sb->length, str, length + 1);
+  sb->length += length;
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: AppendChar
+
+Description: Appends a single character to the end of a string builder's
+             string.
+
+     Inputs: sb - Pointer to the string builder.
+             c  - The character to be appended.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int AppendChar(string_builder_t *sb, char c) {
+  if (ReserveString(sb, 1) == FAILURE) {
+    return FAILURE;
+  }
+  sb->data[sb->length++] = c;
+  sb->data[sb->length] = '\0';
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: AppendInt
+
+Description: Appends the decimal representation of an integer to the end of a
+             string builder's string (without the overhead of "sprintf").
+
+     Inputs: sb    - Pointer to the string builder.
+             value - The integer to be appended.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int AppendInt(string_builder_t *sb, int value) {
+  char digits[SHORT_STR_LEN];
+  int i = SHORT_STR_LEN, length;
+  unsigned int magnitude = value < 0 ? -(unsigned int) value :
+                                       (unsigned int) value;
+
+  do {
+    digits[--i] = '0' + (magnitude % 10);
+    magnitude /= 10;
+  }while (magnitude > 0);
+  if (value < 0) {
+    digits[--i] = '-';
+  }
+  length = SHORT_STR_LEN - i;
+  if (ReserveString(sb, length) == FAILURE) {
+    return FAILURE;
+  }
+  memcpy(sb->data + sb->length, digits + i, length);
+  sb->length += length;
+  sb->data[sb->length] = '\0';
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: AppendFormatted
+
+Description: Appends formatted text (as with "printf") to the end of a string
+             builder's string.
+
+     Inputs: sb     - Pointer to the string builder.
+             format - The format string.
+             ...    - Values to be formatted.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int AppendFormatted(string_builder_t *sb, const char *format, ...) {
+  va_list args, args_copy;
+  int length;
+
+  va_start(args, format);
+  va_copy(args_copy, args);
+  length = vsnprintf(sb->data + sb->length, sb->capacity - sb->length, format,
+                     args);
+  va_end(args);
+  if (length >= sb->capacity - sb->length) {  // Too long: grow and try again.
+    if (ReserveString(sb, length) == FAILURE) {
+      va_end(args_copy);
+      if (sb->capacity > 0) {
+        sb->data[sb->length] = '\0';  // Discard the truncated text.
+      }
+      return FAILURE;
+    }
+    vsnprintf(sb->data + sb->length, length + 1, format, args_copy);
+  }
+  va_end(args_copy);
+  if (length < 0) {
+    return FAILURE;
+  }
+  sb->length += length;
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: ClearString
+
+Description: Empties a string builder's string, keeping its memory for reuse.
+
+     Inputs: sb - Pointer to the string builder.
+
+    Outputs: None.
+*******************************************************************************/
+void ClearString(string_builder_t *sb) {
+  sb->length = 0;
+  if (sb->capacity > 0) {
+    sb->data[0] = '\0';
+  }
+}
+
+/*******************************************************************************
+   Function: ReserveString
+
+Description: Ensures that a string builder can hold a given number of
+             additional characters (plus a NULL-terminator). The string grows
+             in place if it is the arena's most recent allocation; otherwise it
+             is copied to a new, larger allocation.
+
+     Inputs: sb    - Pointer to the string builder.
+             extra - Number of characters to be added.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int ReserveString(string_builder_t *sb, int extra) {
+  int new_capacity;
+  char *new_data;
+
+  if (sb->length + extra + 1 <= sb->capacity) {
+    return SUCCESS;
+  }
+  new_capacity = sb->capacity > 0 ? sb->capacity : LONG_STR_LEN + 1;
+  while (new_capacity < sb->length + extra + 1) {
+    new_capacity *= 2;
+  }
+  if (sb->capacity > 0 &&
+      ArenaExtend(sb->arena, sb->data, sb->capacity, new_capacity)) {
+    sb->capacity = new_capacity;
+    return SUCCESS;
+  }
+  new_data = ArenaAllocate(sb->arena, new_capacity);
+  if (new_data == NULL) {
+    return FAILURE;
+  }
+  memcpy(new_data, sb->data, sb->length + 1);
+  sb->data = new_data;
+  sb->capacity = new_capacity;
+
+  return SUCCESS;
+}
@@ -0,0 +1,529 @@
+/*******************************************************************************
+   Filename: character_types.h
+
+     Author: David C. Drake (https://davidcdrake.com)
+
+Description: Definitions of the game character types of the text-based RPG
+             "Words of Power," one "CHARACTER_TYPE" entry per type. A file that
+             includes this one first defines "CHARACTER_TYPE" to expand each
+             entry as needed (see "character_types" in "characters.c"). Types
+             without an entry cannot be spawned.
+
+             CHARACTER_TYPE(type, name, descriptor, traits,
+                            max HP, physical power, physical defense,
+                            mental power, mental defense, speed, soul,
+                            relationship, level, experience,
+                            minimum gold, maximum gold,
+                            known languages,
+                            known Words of Power,
+                            group)
+
+             Each character's gold is a random amount within the given range
+             (no random number is drawn if the range holds a single value).
+             The group ("GroupType," or UNAFFILIATED) is the type's faction,
+             which decides whom its members defend (see "factions.c").
+*******************************************************************************/
+
+#define L(language) LANGUAGE_BIT(language)
+#define W(word)     WORD_BIT(WORD_OF_ ## word)
+
+CHARACTER_TYPE(PLAYER, "", "", TRAIT_UNIQUE | TRAIT_ACQUAINTED,
+               30, 10, 10, 20, 20, 5, NEUTRAL, GREAT_FRIEND, 1, 0, 10, 10,
+               L(IMPERIAL),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR),
+               UNAFFILIATED)
+
+CHARACTER_TYPE(HUMAN, "Peasant", "peasant", TRAIT_LOCAL_LANGUAGE,
+               30, 10, 10, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 10, 0, 5,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(SOLDIER, "Soldier", "soldier",
+               TRAIT_LOCAL_LANGUAGE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               30, 15, 15, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 10, 1, 5,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(KNIGHT, "Knight", "knight",
+               TRAIT_LOCAL_LANGUAGE | TRAIT_FIGHTS | TRAIT_HELPS,
+               90, 30, 30, 10, 10, 5, NEUTRAL, INDIFFERENT, 10, 50, 10, 30,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(MERCHANT, "Merchant", "merchant", TRAIT_LOCAL_LANGUAGE,
+               30, 10, 10, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 10, 25, 50,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(INNKEEPER, "Innkeeper", "innkeeper",
+               TRAIT_LOCAL_LANGUAGE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               30, 10, 10, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 10, 10, 30,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(NOBLEMAN, "Nobleman", "nobleman", 0,
+               30, 10, 10, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 10, 50, 100,
+               L(VENTARRI) | L(IMPERIAL),
+               0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(FISHERMAN, "Fisherman", "fisherman",
+               TRAIT_LOCAL_LANGUAGE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               30, 10, 10, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 10, 0, 5,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(SAILOR, "Sailor", "sailor",
+               TRAIT_LOCAL_LANGUAGE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               30, 10, 10, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 10, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(SERVANT, "Servant", "servant", TRAIT_LOCAL_LANGUAGE,
+               30, 10, 10, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 10, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(SLAVE, "Slave", "slave", TRAIT_LOCAL_LANGUAGE,
+               20, 6, 6, 6, 6, 5, NEUTRAL, INDIFFERENT, 1, 6, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(THIEF, "Thief", "thief", TRAIT_LOCAL_LANGUAGE,
+               30, 10, 10, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 10, 5, 10,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(PRISONER, "Prisoner", "prisoner", TRAIT_LOCAL_LANGUAGE,
+               15, 5, 5, 5, 5, 5, NEUTRAL, INDIFFERENT, 1, 5, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(FARMER, "Farmer", "farmer",
+               TRAIT_LOCAL_LANGUAGE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               45, 10, 10, 10, 10, 5, GOOD, INDIFFERENT, 1, 10, 0, 5,
+               0, 0,
+               THE_FARMERS)
+
+CHARACTER_TYPE(ILLARUM_PRIEST, "Priest", "priest",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               30, 10, 10, 15, 25, 5, EXTREMELY_GOOD, FRIEND, 2, 30, 0, 0,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(GESH),
+               W(LIGHT) | W(HEALTH) | W(LIFE) | W(HOLINESS),
+               PRIESTS_OF_ILLARUM)
+
+CHARACTER_TYPE(ILLARUM_HIGH_PRIEST, "Yemmul", "high priest",
+               TRAIT_UNIQUE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               75, 10, 10, 50, 150, 5, EXTREMELY_GOOD, FRIEND, 20, 100, 0, 0,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) | L(GESH),
+               W(LIGHT) | W(HEALTH) | W(LIFE) | W(HOLINESS),
+               PRIESTS_OF_ILLARUM)
+
+CHARACTER_TYPE(ILLARUM_KING, "King of Illarum", "king",
+               TRAIT_UNIQUE | TRAIT_FIGHTS | TRAIT_HELPS,
+               60, 20, 20, 20, 20, 5, GOOD, INDIFFERENT, 20, 100, 100, 500,
+               L(ANCIENT_IMPERIAL) | L(VENTARRI),
+               0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(COURT_WIZARD, "Court Wizard", "wizard",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               60, 10, 10, 30, 30, 5, NEUTRAL, INDIFFERENT, 20, 100, 50, 100,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI),
+               ALL_WORDS,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(WIZARD_OF_ELEMENTS, "Wizard of the Elements", "wizard",
+               TRAIT_ACQUAINTED | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               30, 10, 10, 20, 20, 5, NEUTRAL, GOOD_FRIEND, 2, 30, 10, 20,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR),
+               ELEMENTS_GUILD)
+
+CHARACTER_TYPE(ARCHWIZARD_OF_ELEMENTS, "Archememnon", "archwizard",
+               TRAIT_UNIQUE | TRAIT_ACQUAINTED | TRAIT_FIGHTS | TRAIT_FLEES |
+               TRAIT_HELPS,
+               60, 10, 10, 100, 100, 5, EVIL, GOOD_FRIEND, 20, 100, 100, 200,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR),
+               ELEMENTS_GUILD)
+
+CHARACTER_TYPE(DUMMY, "Dummy", "stuffed dummy", TRAIT_INANIMATE,
+               1, 0, 1, 0, 0, 5, NEUTRAL, INDIFFERENT, 1, 1, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(WIZARD_OF_MIND, "Wizard of Mind", "wizard",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               30, 10, 10, 20, 20, 5, EVIL, INDIFFERENT, 2, 30, 20, 30,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI),
+               W(MIND) | W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(SHIELDING),
+               MIND_GUILD)
+
+CHARACTER_TYPE(ARCHWIZARD_OF_MIND, "Kaeloss", "archwizard",
+               TRAIT_UNIQUE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               60, 10, 10, 100, 100, 5, VERY_EVIL, INDIFFERENT,
+               20, 100, 200, 300,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI),
+               W(MIND) | W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(LIGHT) |
+               W(DARKNESS) | W(HEALTH) | W(SICKNESS) | W(GIVING) | W(TAKING) |
+               W(INCREASE) | W(DECREASE) | W(SHIELDING),
+               MIND_GUILD)
+
+CHARACTER_TYPE(VENTARRIS_PRIEST, "Priest", "priest",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               30, 10, 10, 15, 25, 5, GOOD, INDIFFERENT, 2, 30, 0, 0,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI),
+               W(LIGHT) | W(DARKNESS) | W(HEALTH) | W(SICKNESS) | W(LIFE) |
+               W(HOLINESS),
+               PRIESTS_OF_VENTARRIS)
+
+CHARACTER_TYPE(VENTARRIS_HIGH_PRIEST, "Graelmach", "high priest",
+               TRAIT_UNIQUE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               75, 10, 10, 50, 150, 5, VERY_GOOD, INDIFFERENT, 20, 100, 0, 0,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI),
+               W(LIGHT) | W(DARKNESS) | W(HEALTH) | W(SICKNESS) | W(LIFE) |
+               W(DEATH) | W(HOLINESS) | W(EVIL),
+               PRIESTS_OF_VENTARRIS)
+
+CHARACTER_TYPE(VENTARRIS_KING, "King Estvann", "king",
+               TRAIT_UNIQUE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               60, 20, 20, 20, 20, 5, VERY_EVIL, INDIFFERENT, 20, 100, 250, 500,
+               L(IMPERIAL) | L(VENTARRI),
+               0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(BARBARIAN, "Babarian", "barbarian", TRAIT_FIGHTS | TRAIT_HELPS,
+               45, 15, 15, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 12, 0, 0,
+               L(GESH),
+               0,
+               THE_BARBARIANS)
+
+CHARACTER_TYPE(BARBARIAN_WARRIOR, "Barbarian Warrior", "barbarian warrior",
+               TRAIT_FIGHTS | TRAIT_HELPS,
+               60, 30, 30, 10, 10, 5, NEUTRAL, INDIFFERENT, 8, 25, 0, 0,
+               L(GESH),
+               0,
+               THE_BARBARIANS)
+
+CHARACTER_TYPE(BARBARIAN_SHAMAN, "Barbarian Shaman", "barbarian shaman",
+               TRAIT_FIGHTS | TRAIT_HELPS,
+               45, 15, 15, 20, 20, 5, NEUTRAL, INDIFFERENT, 10, 30, 0, 0,
+               L(GESH),
+               W(BODY) | W(FLORA) | W(FAUNA) | W(HEALTH) | W(SICKNESS) |
+               W(GIVING) | W(TAKING) | W(INCREASE) | W(DECREASE) | W(FIRE) |
+               W(EARTH) | W(WATER) | W(AIR),
+               THE_BARBARIANS)
+
+CHARACTER_TYPE(BARBARIAN_CHIEFTAIN, "Telth", "barbarian chieftain",
+               TRAIT_UNIQUE | TRAIT_FIGHTS | TRAIT_HELPS,
+               60, 50, 50, 15, 15, 5, NEUTRAL, INDIFFERENT, 20, 100, 0, 0,
+               L(GESH),
+               W(DEATH),
+               THE_BARBARIANS)
+
+CHARACTER_TYPE(ELF, "Elf", "elf", TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               60, 15, 15, 30, 30, 5, GOOD, INDIFFERENT, 1, 35, 0, 0,
+               L(ELVISH),
+               W(BODY) | W(FLORA) | W(FAUNA) | W(HEALTH) | W(SICKNESS) |
+               W(LIFE) | W(DEATH) | W(GIVING) | W(TAKING) | W(INCREASE) |
+               W(DECREASE) | W(FIRE) | W(EARTH) | W(WATER) | W(AIR),
+               THE_ELVES)
+
+CHARACTER_TYPE(ELF_LOREMASTER, "Elven Loremaster", "elven loremaster",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               60, 15, 15, 50, 50, 5, GOOD, INDIFFERENT, 20, 100, 0, 0,
+               L(ELVISH) | L(ANCIENT_ELVISH),
+               W(BODY) | W(FLORA) | W(FAUNA) | W(HEALTH) | W(SICKNESS) |
+               W(LIFE) | W(DEATH) | W(GIVING) | W(TAKING) | W(INCREASE) |
+               W(DECREASE) | W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(LIGHT) |
+               W(DARKNESS) | W(HOLINESS) | W(BALANCE),
+               THE_ELVES)
+
+CHARACTER_TYPE(DWARF, "Dwarf", "dwarf", TRAIT_FIGHTS | TRAIT_HELPS,
+               45, 20, 20, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 12, 5, 10,
+               L(DWARVISH),
+               0,
+               THE_DWARVES)
+
+CHARACTER_TYPE(DWARF_MERCHANT, "Dwarven Merchant", "dwarven merchant",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               45, 20, 20, 10, 10, 5, NEUTRAL, INDIFFERENT, 1, 12, 50, 100,
+               L(DWARVISH),
+               0,
+               THE_DWARVES)
+
+CHARACTER_TYPE(DWARF_MINER, "Dwarven Miner", "dwarven miner",
+               TRAIT_FIGHTS | TRAIT_HELPS,
+               45, 30, 20, 15, 15, 5, NEUTRAL, INDIFFERENT, 1, 15, 10, 20,
+               L(DWARVISH),
+               0,
+               THE_DWARVES)
+
+CHARACTER_TYPE(DWARF_GUARDIAN, "Dwarven Guardian", "dwarven guardian",
+               TRAIT_FIGHTS | TRAIT_HELPS,
+               90, 40, 40, 15, 15, 5, NEUTRAL, INDIFFERENT, 10, 50, 10, 30,
+               L(DWARVISH),
+               0,
+               THE_DWARVES)
+
+CHARACTER_TYPE(DWARF_LOREMASTER, "Dwarven Loremaster", "dwarven loremaster",
+               TRAIT_FIGHTS | TRAIT_HELPS,
+               45, 20, 20, 50, 50, 5, NEUTRAL, INDIFFERENT, 20, 100, 10, 20,
+               L(DWARVISH) | L(ANCIENT_DWARVISH) | L(GNOMISH),
+               W(BODY) | W(HEALTH) | W(SICKNESS) | W(LIFE) | W(DEATH) |
+               W(GIVING) | W(TAKING) | W(INCREASE) | W(DECREASE) | W(FIRE) |
+               W(EARTH) | W(WATER) | W(AIR) | W(LIGHT) | W(DARKNESS) |
+               W(HOLINESS) | W(FOCUS),
+               THE_DWARVES)
+
+CHARACTER_TYPE(DWARF_PRIEST, "Dwarven Priest", "dwarven priest",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               45, 20, 20, 30, 30, 5, NEUTRAL, INDIFFERENT, 10, 30, 10, 20,
+               L(DWARVISH) | L(ANCIENT_DWARVISH) | L(GNOMISH),
+               W(BODY) | W(HEALTH) | W(SICKNESS) | W(LIFE) | W(DEATH) |
+               W(GIVING) | W(TAKING) | W(INCREASE) | W(DECREASE) | W(FIRE) |
+               W(EARTH) | W(WATER) | W(AIR) | W(LIGHT) | W(DARKNESS) |
+               W(HOLINESS) | W(FOCUS),
+               THE_DWARVES)
+
+CHARACTER_TYPE(DWARF_HIGH_PRIEST, "Dwarven High Priest", "dwarven high priest",
+               TRAIT_FIGHTS | TRAIT_HELPS,
+               45, 20, 20, 50, 50, 5, NEUTRAL, INDIFFERENT, 20, 100, 10, 20,
+               L(DWARVISH) | L(ANCIENT_DWARVISH) | L(GNOMISH),
+               W(BODY) | W(HEALTH) | W(SICKNESS) | W(LIFE) | W(DEATH) |
+               W(GIVING) | W(TAKING) | W(INCREASE) | W(DECREASE) | W(FIRE) |
+               W(EARTH) | W(WATER) | W(AIR) | W(LIGHT) | W(DARKNESS) |
+               W(HOLINESS) | W(FOCUS),
+               THE_DWARVES)
+
+CHARACTER_TYPE(DWARF_KING, "King Beoklast", "dwarven king",
+               TRAIT_FIGHTS | TRAIT_HELPS,
+               120, 50, 50, 15, 20, 5, NEUTRAL, INDIFFERENT, 20, 120, 500, 1000,
+               L(DWARVISH) | L(ANCIENT_DWARVISH) | L(GNOMISH),
+               0,
+               THE_DWARVES)
+
+CHARACTER_TYPE(GNOME, "Gnome", "gnome",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               30, 10, 10, 15, 15, 5, NEUTRAL, INDIFFERENT, 1, 10, 10, 20,
+               L(GNOMISH),
+               0,
+               THE_GNOMES)
+
+CHARACTER_TYPE(GNOME_MINER, "Gnomish Miner", "gnomish miner",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               45, 15, 15, 15, 15, 5, NEUTRAL, INDIFFERENT, 1, 12, 10, 20,
+               L(GNOMISH),
+               0,
+               THE_GNOMES)
+
+CHARACTER_TYPE(DRUID, "Druid", "druid",
+               TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               45, 10, 10, 20, 25, 5, NEUTRAL, INDIFFERENT, 10, 30, 0, 0,
+               L(IMPERIAL) | L(GESH) | L(ELVISH),
+               W(BODY) | W(FLORA) | W(FAUNA) | W(HEALTH) | W(SICKNESS) |
+               W(LIFE) | W(DEATH) | W(GIVING) | W(TAKING) | W(INCREASE) |
+               W(DECREASE) | W(FIRE) | W(EARTH) | W(WATER) | W(AIR),
+               THE_DRUIDS)
+
+CHARACTER_TYPE(ARCHDRUID, "Pann", "archdruid",
+               TRAIT_UNIQUE | TRAIT_FIGHTS | TRAIT_FLEES | TRAIT_HELPS,
+               60, 10, 10, 100, 100, 5, NEUTRAL, INDIFFERENT, 20, 100, 0, 0,
+               L(IMPERIAL) | L(GESH) | L(ELVISH),
+               W(BODY) | W(FLORA) | W(FAUNA) | W(HEALTH) | W(SICKNESS) |
+               W(LIFE) | W(DEATH) | W(GIVING) | W(TAKING) | W(INCREASE) |
+               W(DECREASE) | W(FIRE) | W(EARTH) | W(WATER) | W(AIR),
+               THE_DRUIDS)
+
+CHARACTER_TYPE(RAT, "Rat", "large rat", 0,
+               15, 2, 2, 1, 1, 5, NEUTRAL, ENEMY, 1, 1, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(WOLF, "Wolf", "wolf", 0,
+               60, 30, 20, 1, 1, 5, NEUTRAL, HOSTILE_ENEMY, 1, 25, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(BEAR, "Bear", "bear", 0,
+               60, 30, 20, 1, 1, 5, NEUTRAL, HOSTILE_ENEMY, 1, 25, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(SHARK, "Shark", "shark", 0,
+               60, 30, 20, 1, 1, 5, NEUTRAL, HOSTILE_ENEMY, 1, 25, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(GIANT_SQUID, "Giant Squid", "giant squid", 0,
+               60, 30, 20, 1, 1, 5, NEUTRAL, HOSTILE_ENEMY, 1, 25, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(MERFOLK, "Merfolk", "merfolk", 0,
+               45, 15, 15, 10, 20, 5, NEUTRAL, ENEMY, 1, 12, 0, 0,
+               L(MER),
+               0,
+               THE_MERFOLK)
+
+CHARACTER_TYPE(MERFOLK_SOLDIER, "Merman Soldier", "merman soldier",
+               TRAIT_FIGHTS | TRAIT_HELPS,
+               60, 30, 10, 10, 30, 5, NEUTRAL, ENEMY, 2, 20, 0, 0,
+               L(MER),
+               0,
+               THE_MERFOLK)
+
+CHARACTER_TYPE(MERFOLK_PRIESTESS, "Mermaid Priestess", "mermaid priestess",
+               TRAIT_FIGHTS | TRAIT_HELPS,
+               45, 15, 15, 30, 30, 5, NEUTRAL, ENEMY, 10, 30, 0, 0,
+               L(MER) | L(ANCIENT_MER),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(LIGHT) | W(DARKNESS) | W(SHIELDING) | W(INCREASE) |
+               W(DECREASE) | W(GIVING) | W(TAKING) | W(FLORA) | W(FAUNA) |
+               W(HEALTH) | W(SICKNESS) | W(WAVES),
+               THE_MERFOLK)
+
+CHARACTER_TYPE(MERFOLK_HIGH_PRIESTESS, "Quaelos", "mermaid high priestess",
+               TRAIT_UNIQUE | TRAIT_FIGHTS | TRAIT_HELPS,
+               60, 15, 15, 120, 120, 5, NEUTRAL, ENEMY, 20, 100, 0, 0,
+               L(MER) | L(ANCIENT_MER),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(LIGHT) | W(DARKNESS) | W(SHIELDING) | W(INCREASE) |
+               W(DECREASE) | W(GIVING) | W(TAKING) | W(FLORA) | W(FAUNA) |
+               W(HEALTH) | W(SICKNESS) | W(WAVES),
+               THE_MERFOLK)
+
+CHARACTER_TYPE(MERFOLK_QUEEN, "Queen Serashnul", "mermaid queen",
+               TRAIT_UNIQUE | TRAIT_FIGHTS | TRAIT_HELPS,
+               60, 20, 20, 30, 30, 5, NEUTRAL, ENEMY, 20, 100, 0, 0,
+               L(MER) | L(ANCIENT_MER),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR),
+               THE_MERFOLK)
+
+CHARACTER_TYPE(NECROMANCER, "Necromancer", "necromancer",
+               TRAIT_FIGHTS | TRAIT_FLEES,
+               60, 10, 10, 30, 20, 5, EXTREMELY_EVIL, ENEMY, 10, 35, 25, 50,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(LIGHT) | W(DARKNESS) | W(SHIELDING) | W(INCREASE) |
+               W(DECREASE) | W(GIVING) | W(TAKING) | W(FLORA) | W(FAUNA) |
+               W(HEALTH) | W(SICKNESS) | W(LIFE) | W(DEATH) | W(EVIL),
+               THE_NECROMANCERS)
+
+CHARACTER_TYPE(ARCHNECROMANCER, "Kraathmot", "archnecromancer",
+               TRAIT_FIGHTS | TRAIT_FLEES,
+               90, 15, 15, 50, 40, 5, EXTREMELY_EVIL, ENEMY, 20, 100, 50, 100,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(LIGHT) | W(DARKNESS) | W(SHIELDING) | W(INCREASE) |
+               W(DECREASE) | W(GIVING) | W(TAKING) | W(FLORA) | W(FAUNA) |
+               W(HEALTH) | W(SICKNESS) | W(LIFE) | W(DEATH) | W(EVIL),
+               THE_NECROMANCERS)
+
+CHARACTER_TYPE(LICH, "Velroth", "lich", TRAIT_UNIQUE | TRAIT_FIGHTS,
+               150, 30, 30, 150, 150, 5, EXTREMELY_EVIL, ENEMY,
+               30, 300, 1000, 2000,
+               L(ANCIENT_IMPERIAL) | L(ANCIENT_VENTARRI),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(LIGHT) | W(DARKNESS) | W(SHIELDING) | W(INCREASE) |
+               W(DECREASE) | W(GIVING) | W(TAKING) | W(FLORA) | W(FAUNA) |
+               W(HEALTH) | W(SICKNESS) | W(LIFE) | W(DEATH) | W(EVIL),
+               THE_NECROMANCERS)
+
+CHARACTER_TYPE(ZOMBIE, "Zombie", "zombie", 0,
+               45, 20, 10, 0, 0, 5, EVIL, HOSTILE_ENEMY, 1, 20, 0, 0,
+               L(ANCIENT_VENTARRI),
+               0,
+               THE_NECROMANCERS)
+
+CHARACTER_TYPE(SKELETAL_KNIGHT, "Skeletal Knight", "skeletal knight",
+               TRAIT_FIGHTS,
+               60, 30, 20, 0, 0, 5, EVIL, HOSTILE_ENEMY, 10, 50, 0, 0,
+               L(ANCIENT_VENTARRI),
+               0,
+               THE_NECROMANCERS)
+
+CHARACTER_TYPE(GOBLIN, "Goblin", "goblin", 0,
+               60, 30, 20, 1, 1, 5, NEUTRAL, HOSTILE_ENEMY, 1, 25, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(ORC, "Orc", "orc", 0,
+               60, 30, 20, 1, 1, 5, NEUTRAL, HOSTILE_ENEMY, 1, 25, 0, 0,
+               0, 0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(DRAGON, "Dragon", "dragon", 0,
+               1500, 500, 500, 100, 50, 5, NEUTRAL, HOSTILE_ENEMY,
+               30, 1000, 0, 0,
+               L(ANCIENT_DWARVISH) | L(ANCIENT_GNOMISH) | L(ANCIENT_ELVISH) |
+               L(ANCIENT_IMPERIAL) | L(ANCIENT_VENTARRI),
+               0,
+               UNAFFILIATED)
+
+CHARACTER_TYPE(THE_DARK_RECLUSE, "The Dark Recluse", "black-robed wizard",
+               TRAIT_UNIQUE,
+               120, 15, 15, 150, 150, 5, VERY_EVIL, ENEMY, 40, 400, 0, 0,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(FLORA) | W(FAUNA) | W(LIGHT) | W(DARKNESS) | W(HEALTH) |
+               W(SICKNESS) | W(LIFE) | W(DEATH) | W(GIVING) | W(TAKING) |
+               W(INCREASE) | W(DECREASE) | W(EVIL) | W(SHIELDING),
+               UNAFFILIATED)
+
+CHARACTER_TYPE(THE_HERMIT, "The Hermit", "old, green-robed man", TRAIT_UNIQUE,
+               120, 20, 20, 150, 150, 5, NEUTRAL, ENEMY, 40, 400, 0, 0,
+               L(IMPERIAL) | L(ELVISH) | L(ANCIENT_ELVISH),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(FLORA) | W(FAUNA) | W(LIGHT) | W(DARKNESS) | W(HEALTH) |
+               W(SICKNESS) | W(LIFE) | W(DEATH) | W(GIVING) | W(TAKING) |
+               W(INCREASE) | W(DECREASE) | W(SHIELDING) | W(BALANCE) | W(TIME),
+               UNAFFILIATED)
+
+CHARACTER_TYPE(THE_ANGLER, "The Angler", "old, blue-robed fisherman",
+               TRAIT_UNIQUE,
+               90, 10, 10, 150, 150, 5, GOOD, INDIFFERENT, 40, 400, 1, 10,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI) | L(MER),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(FLORA) | W(FAUNA) | W(LIGHT) | W(DARKNESS) | W(HEALTH) |
+               W(SICKNESS) | W(LIFE) | W(DEATH) | W(GIVING) | W(TAKING) |
+               W(INCREASE) | W(DECREASE) | W(SHIELDING),
+               UNAFFILIATED)
+
+CHARACTER_TYPE(THE_WANDERING_MONK, "The Wandering Monk", "red-robed monk",
+               TRAIT_UNIQUE,
+               120, 30, 30, 150, 150, 5, NEUTRAL, INDIFFERENT, 40, 400, 0, 5,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI) | L(DWARVISH) | L(GNOMISH) | L(GESH),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(FLORA) | W(FAUNA) | W(LIGHT) | W(DARKNESS) | W(HEALTH) |
+               W(SICKNESS) | W(LIFE) | W(DEATH) | W(GIVING) | W(TAKING) |
+               W(INCREASE) | W(DECREASE) | W(HOLINESS) | W(EVIL) |
+               W(SHIELDING) | W(VOID),
+               UNAFFILIATED)
+
+CHARACTER_TYPE(THE_SILENT_SAGE, "The Silent Sage", "old, white-robed man",
+               TRAIT_UNIQUE,
+               90, 10, 10, 200, 200, 5, VERY_GOOD, INDIFFERENT, 50, 500, 1, 10,
+               L(IMPERIAL) | L(ANCIENT_IMPERIAL) | L(VENTARRI) |
+               L(ANCIENT_VENTARRI) | L(ELVISH) | L(ANCIENT_ELVISH) |
+               L(DWARVISH) | L(ANCIENT_DWARVISH) | L(GNOMISH) |
+               L(ANCIENT_GNOMISH),
+               W(FIRE) | W(EARTH) | W(WATER) | W(AIR) | W(BODY) | W(MIND) |
+               W(FLORA) | W(FAUNA) | W(LIGHT) | W(DARKNESS) | W(HEALTH) |
+               W(SICKNESS) | W(LIFE) | W(DEATH) | W(GIVING) | W(TAKING) |
+               W(INCREASE) | W(DECREASE) | W(HOLINESS) | W(EVIL) |
+               W(SHIELDING) | W(TIME),
+               UNAFFILIATED)
+
+#undef L
+#undef W
@@ -9,1507 +9,469 @@ Description: Functions governing the creation, initialization, and analysis of
 
 #include "wop.h"
 
+// The game character types, indexed by type (see "character_types.h"):
+const character_type_t character_types[NUM_GC_TYPES] = {
+#define CHARACTER_TYPE(type, name, descriptor, traits, max_hp, physical_power, \
+                       physical_defense, mental_power, mental_defense, speed, \
+                       soul, relationship, level, experience, min_gold,       \
+                       max_gold, languages, words, group)                     \
+  [type] = {name, descriptor, traits, max_hp, physical_power,                 \
+            physical_defense, mental_power, mental_defense, speed, soul,      \
+            relationship, level, experience, min_gold, max_gold, languages,   \
+            words, group},
+#include "character_types.h"
+#undef CHARACTER_TYPE
+};
+
 /*******************************************************************************
    Function: InitializeCharacter
 
 Description: Initializes a given game character struct according to a given type
-             and assigns it to a given location.
-
-     Inputs: p_gc     - Pointer to the game characer struct to be initialized.
+             and assigns it to a given location. The type's entry in
+             "character_types.h" supplies the character's stats; only its gold
+             and, for some types, its language vary. Unless the character is
+             the player, its name, Words, etc., are shared with every identical
+             character of the same type (see "GetTemplate").
+
+     Inputs: session  - Pointer to the current game session.
+             p_gc     - Pointer to the game characer struct to be initialized.
              type     - Integer representing desired game character type.
              location - The game character's starting location.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int InitializeCharacter(game_character_t *p_gc, int type,
+int InitializeCharacter(game_session_t *session, game_character_t *p_gc,
+                        int type,
                         location_t *location) {
-  int i;
+  int i, result = SUCCESS;
   bool repeat_options;
+  const character_type_t *prototype;
+  static const character_type_t average = {  // An average adult human.
+    "", "", 0, DEFAULT_HP, DEFAULT_PHYSICAL_POWER, DEFAULT_PHYSICAL_DEFENSE,
+    DEFAULT_MENTAL_POWER, DEFAULT_MENTAL_DEFENSE, DEFAULT_SPEED, NEUTRAL,
+    INDIFFERENT, 1, DEFAULT_EXP, 0, 0, 0, 0, UNAFFILIATED
+  };
+
+  if (type >= 0 && type < NUM_GC_TYPES && character_types[type].name != NULL) {
+    prototype = &character_types[type];
+  } else {  // No entry in "character_types.h".
+    PRINT_ERROR_MESSAGE;
+    prototype = &average;
+    result = FAILURE;
+  }
 
-  // Default stats, representative of an average adult human:
   p_gc->type = type;
-  strcpy(p_gc->name, "");
-  strcpy(p_gc->descriptor, "");
-  p_gc->unique = false;
-  p_gc->max_hp = DEFAULT_HP;
-  p_gc->hp = DEFAULT_HP;
-  p_gc->physical_power = DEFAULT_PHYSICAL_POWER;
-  p_gc->physical_defense = DEFAULT_PHYSICAL_DEFENSE;
-  p_gc->mental_power = DEFAULT_MENTAL_POWER;
-  p_gc->mental_defense = DEFAULT_MENTAL_DEFENSE;
-  p_gc->speed = DEFAULT_SPEED;
-  p_gc->soul = NEUTRAL;
-  p_gc->level = 1;
-  p_gc->experience = DEFAULT_EXP;
-  p_gc->knows_player = false;
-  p_gc->known_to_player = false;
-  p_gc->relationship = INDIFFERENT;
-  p_gc->conversations = 0;
+  p_gc->max_hp = prototype->max_hp;
+  p_gc->hp = prototype->max_hp;
+  p_gc->physical_power = prototype->physical_power;
+  p_gc->physical_defense = prototype->physical_defense;
+  p_gc->mental_power = prototype->mental_power;
+  p_gc->mental_defense = prototype->mental_defense;
+  p_gc->speed = prototype->speed;
+  p_gc->soul = prototype->soul;
+  p_gc->relationship = prototype->relationship;
   for (i = 0; i < NUM_STATUS_TYPES; i++) {
     p_gc->status[i] = false;
   }
-  p_gc->gold = 0;
-  for (i = 0; i < NUM_ITEM_TYPES; i++) {
-    p_gc->inventory[i] = 0;
-    p_gc->equipped_items[i] = 0;
+  p_gc->status[INANIMATE] = (prototype->traits & TRAIT_INANIMATE) != 0;
+  p_gc->location = location->id;
+  p_gc->summoned_creature = NO_CHARACTER;
+  p_gc->stack = NULL;
+  p_gc->next = NO_CHARACTER;
+  p_gc->previous = NO_CHARACTER;
+  p_gc->next_fighter = NO_CHARACTER;
+  p_gc->previous_fighter = NO_CHARACTER;
+
+  memset(p_gc->details, 0, sizeof(character_details_t));
+  p_gc->details->knows_player = prototype->traits & TRAIT_ACQUAINTED;
+  p_gc->details->known_to_player = prototype->traits & TRAIT_ACQUAINTED;
+  if (prototype->max_gold > prototype->min_gold) {
+    p_gc->details->gold = RandomInt(session, prototype->min_gold,
+                                    prototype->max_gold);
+  } else {
+    p_gc->details->gold = prototype->min_gold;
   }
-  for (i = 0; i < NUM_LANGUAGE_TYPES; i++) {
-    p_gc->languages[i] = UNKNOWN;
+
+  // The player's template is private; other characters share theirs:
+  if (p_gc == &session->player) {
+    BuildTemplate(p_gc->template, prototype, location);
+    ChangeItemQuantity(session, p_gc, HEALING_POTION, 3);
+    p_gc->location = ILLARUM_SCHOOL;
+    PrintString(session, "You are a wizard who has studied at the city of "
+                "Illarum's School of the Elements for the past five "
+                "years.\0");
+    FlushInput(session);
+    do {
+      PrintFormatted(session, "Choose your name: ");
+      GetStrInput(session, p_gc->template->name, SHORT_STR_LEN + 1);
+      repeat_options = strlen(p_gc->template->name) < 1;
+    }while (repeat_options && !session->player_has_quit);
+  } else {
+    p_gc->template = GetTemplate(session, type, prototype, location);
+    if (p_gc->template == NULL) {
+      PRINT_ERROR_MESSAGE;
+      exit(1);
+    }
+  }
+
+  return result;
+}
+
+/*******************************************************************************
+   Function: GetTemplate
+
+Description: Returns the world's shared template for characters of a given type
+             at a given location, creating it on first use. Every generic NPC
+             of a type thereby shares a single record (or two, for types whose
+             language depends on the region).
+
+     Inputs: session   - Pointer to the current game session.
+             type      - The game character type of interest.
+             prototype - Pointer to the type's defining data.
+             location  - The location where the character is being created.
+
+    Outputs: Pointer to the shared template (or NULL if allocation fails).
+*******************************************************************************/
+character_template_t *GetTemplate(game_session_t *session, int type,
+                                  const character_type_t *prototype,
+                                  location_t *location) {
+  int region = 0;
+  character_template_t **shared;
+
+  if (prototype->traits & TRAIT_LOCAL_LANGUAGE &&
+      InVentarrisTerritory(location)) {
+    region = 1;
   }
-  for (i = 0; i < NUM_WORD_TYPES; i++) {
-    p_gc->words[i] = UNKNOWN;
+  shared = &session->templates[type][region];
+  if (*shared == NULL) {
+    *shared = ArenaAllocate(&session->details_arena,
+                            sizeof(character_template_t));
+    if (*shared != NULL) {
+      BuildTemplate(*shared, prototype, location);
+    }
   }
-  p_gc->location = location->id;
-  p_gc->summoned_creature = NULL;
-  p_gc->next = NULL;
 
-  // Character-specific stats:
-  switch (p_gc->type) {
-    case PLAYER:
-      p_gc->unique = true;
-      p_gc->experience = 0;
-      p_gc->mental_power *= 2;
-      p_gc->mental_defense *= 2;
-      p_gc->knows_player = true;
-      p_gc->known_to_player = true;
-      p_gc->relationship = GREAT_FRIEND;
-      p_gc->gold = 10;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->inventory[HEALING_POTION] = 3;
-      p_gc->location = ILLARUM_SCHOOL;
-      PrintString("You are a wizard who has studied at the city of Illarum's "
-                  "School of the Elements for the past five years.\0");
-      FlushInput();
-      do {
-        printf("Choose your name: ");
-        GetStrInput(p_gc->name, SHORT_STR_LEN + 1);
-        repeat_options = strlen(p_gc->name) < 1;
-      }while (repeat_options);
-      break;
-    case ARCHWIZARD_OF_ELEMENTS:
-      strcpy(p_gc->name, "Archememnon");
-      strcpy(p_gc->descriptor, "archwizard");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->mental_power *= 10;
-      p_gc->mental_defense *= 10;
-      p_gc->soul = EVIL;
-      p_gc->relationship = GOOD_FRIEND;
-      p_gc->knows_player = true;
-      p_gc->known_to_player = true;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      p_gc->gold = RandomInt(100, 200);
-      break;
-    case WIZARD_OF_ELEMENTS:
-      strcpy(p_gc->name, "Wizard of the Elements");
-      strcpy(p_gc->descriptor, "wizard");
-      p_gc->mental_power *= 2;
-      p_gc->mental_defense *= 2;
-      p_gc->relationship = GOOD_FRIEND;
-      p_gc->knows_player = true;
-      p_gc->known_to_player = true;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->level = 2;
-      p_gc->experience *= 3;
-      p_gc->gold = RandomInt(10, 20);
-      break;
-    case ILLARUM_PRIEST:
-      strcpy(p_gc->name, "Priest");
-      strcpy(p_gc->descriptor, "priest");
-      p_gc->mental_power *= 1.5;
-      p_gc->mental_defense *= 2.5;
-      p_gc->soul = EXTREMELY_GOOD;
-      p_gc->relationship = FRIEND;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[GESH] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->level = 2;
-      p_gc->experience *= 3;
-      break;
-    case ILLARUM_HIGH_PRIEST:
-      strcpy(p_gc->name, "Yemmul");
-      strcpy(p_gc->descriptor, "high priest");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2.5;
-      p_gc->hp *= 2.5;
-      p_gc->mental_power *= 5;
-      p_gc->mental_defense *= 15;
-      p_gc->soul = EXTREMELY_GOOD;
-      p_gc->relationship = FRIEND;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[GESH] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      break;
-    case DUMMY:
-      strcpy(p_gc->name, "Dummy");
-      strcpy(p_gc->descriptor, "stuffed dummy");
-      p_gc->max_hp = 1;
-      p_gc->hp = 1;
-      p_gc->physical_power = 0;
-      p_gc->physical_defense = 1;
-      p_gc->mental_power = 0;
-      p_gc->mental_defense = 0;
-      p_gc->experience = 1;
-      p_gc->status[INANIMATE] = true;
-      break;
-    case HUMAN:
-      strcpy(p_gc->name, "Peasant");
-      strcpy(p_gc->descriptor, "peasant");
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->gold = RandomInt(0, 5);
-      break;
-    case THIEF:
-      strcpy(p_gc->name, "Thief");
-      strcpy(p_gc->descriptor, "thief");
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->gold = RandomInt(5, 10);
-      break;
-    case SOLDIER:
-      strcpy(p_gc->name, "Soldier");
-      strcpy(p_gc->descriptor, "soldier");
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->gold = RandomInt(1, 5);
-      break;
-    case MERCHANT:
-      strcpy(p_gc->name, "Merchant");
-      strcpy(p_gc->descriptor, "merchant");
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->gold = RandomInt(25, 50);
-      break;
-    case INNKEEPER:
-      strcpy(p_gc->name, "Innkeeper");
-      strcpy(p_gc->descriptor, "innkeeper");
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->gold = RandomInt(10, 30);
-      break;
-    case ILLARUM_KING:
-      strcpy(p_gc->name, "King of Illarum");
-      strcpy(p_gc->descriptor, "king");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 2;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power *= 2;
-      p_gc->mental_defense *= 2;
-      p_gc->soul = GOOD;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      p_gc->gold = RandomInt(100, 500);
-      break;
-    case COURT_WIZARD:
-      strcpy(p_gc->name, "Court Wizard");
-      strcpy(p_gc->descriptor, "wizard");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->mental_power *= 3;
-      p_gc->mental_defense *= 3;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      for (i = 0; i < NUM_WORD_TYPES; i++) {
-        p_gc->words[i] = KNOWN;
-      }
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      p_gc->gold = RandomInt(50, 100);
-      break;
-    case NOBLEMAN:
-      strcpy(p_gc->name, "Nobleman");
-      strcpy(p_gc->descriptor, "nobleman");
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->gold = RandomInt(50, 100);
-      break;
-    case KNIGHT:
-      strcpy(p_gc->name, "Knight");
-      strcpy(p_gc->descriptor, "knight");
-      p_gc->max_hp *= 3;
-      p_gc->hp *= 3;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 3;
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->level = 10;
-      p_gc->experience *= 5;
-      p_gc->gold = RandomInt(10, 30);
-      break;
-    case SERVANT:
-      strcpy(p_gc->name, "Servant");
-      strcpy(p_gc->descriptor, "servant");
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      break;
-    case PRISONER:
-      strcpy(p_gc->name, "Prisoner");
-      strcpy(p_gc->descriptor, "prisoner");
-      p_gc->max_hp /= 2;
-      p_gc->hp /= 2;
-      p_gc->physical_power /= 2;
-      p_gc->physical_defense /= 2;
-      p_gc->mental_power /= 2;
-      p_gc->mental_defense /= 2;
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->experience /= 2;
-      break;
-    case SLAVE:
-      strcpy(p_gc->name, "Slave");
-      strcpy(p_gc->descriptor, "slave");
-      p_gc->max_hp /= 1.5;
-      p_gc->hp /= 1.5;
-      p_gc->physical_power /= 1.5;
-      p_gc->physical_defense /= 1.5;
-      p_gc->mental_power /= 1.5;
-      p_gc->mental_defense /= 1.5;
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->experience /= 1.5;
-      break;
-    case SAILOR:
-      strcpy(p_gc->name, "Sailor");
-      strcpy(p_gc->descriptor, "sailor");
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      break;
-    case ARCHWIZARD_OF_MIND:
-      strcpy(p_gc->name, "Kaeloss");
-      strcpy(p_gc->descriptor, "archwizard");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->mental_power *= 10;
-      p_gc->mental_defense *= 10;
-      p_gc->soul = VERY_EVIL;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      p_gc->gold = RandomInt(200, 300);
-      break;
-    case WIZARD_OF_MIND:
-      strcpy(p_gc->name, "Wizard of Mind");
-      strcpy(p_gc->descriptor, "wizard");
-      p_gc->mental_power *= 2;
-      p_gc->mental_defense *= 2;
-      p_gc->soul = EVIL;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->level = 2;
-      p_gc->experience *= 3;
-      p_gc->gold = RandomInt(20, 30);
-      break;
-    case VENTARRIS_PRIEST:
-      strcpy(p_gc->name, "Priest");
-      strcpy(p_gc->descriptor, "priest");
-      p_gc->mental_power *= 1.5;
-      p_gc->mental_defense *= 2.5;
-      p_gc->soul = GOOD;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->level = 2;
-      p_gc->experience *= 3;
-      break;
-    case VENTARRIS_HIGH_PRIEST:
-      strcpy(p_gc->name, "Graelmach");
-      strcpy(p_gc->descriptor, "high priest");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2.5;
-      p_gc->hp *= 2.5;
-      p_gc->mental_power *= 5;
-      p_gc->mental_defense *= 15;
-      p_gc->soul = VERY_GOOD;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->words[WORD_OF_EVIL] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      break;
-    case VENTARRIS_KING:
-      strcpy(p_gc->name, "King Estvann");
-      strcpy(p_gc->descriptor, "king");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 2;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power *= 2;
-      p_gc->mental_defense *= 2;
-      p_gc->soul = VERY_EVIL;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      p_gc->gold = RandomInt(250, 500);
-      break;
-    case FARMER:
-      strcpy(p_gc->name, "Farmer");
-      strcpy(p_gc->descriptor, "farmer");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->soul = GOOD;
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->gold = RandomInt(0, 5);
-      break;
-    case FISHERMAN:
-      strcpy(p_gc->name, "Fisherman");
-      strcpy(p_gc->descriptor, "fisherman");
-      if (InVentarrisTerritory(location)) {
-        p_gc->languages[VENTARRI] = KNOWN;
-      } else {
-        p_gc->languages[IMPERIAL] = KNOWN;
-      }
-      p_gc->gold = RandomInt(0, 5);
-      break;
-    case DRUID:
-      strcpy(p_gc->name, "Druid");
-      strcpy(p_gc->descriptor, "druid");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->mental_power *= 2;
-      p_gc->mental_defense *= 2.5;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[GESH] = KNOWN;
-      p_gc->languages[ELVISH] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->level = 10;
-      p_gc->experience *= 3;
-      break;
-    case ARCHDRUID:
-      strcpy(p_gc->name, "Pann");
-      strcpy(p_gc->descriptor, "archdruid");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->mental_power *= 10;
-      p_gc->mental_defense *= 10;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[GESH] = KNOWN;
-      p_gc->languages[ELVISH] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      break;
-    case ELF:
-      strcpy(p_gc->name, "Elf");
-      strcpy(p_gc->descriptor, "elf");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->mental_power *= 3;
-      p_gc->mental_defense *= 3;
-      p_gc->soul = GOOD;
-      p_gc->languages[ELVISH] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->experience *= 3.5;
-      break;
-    case ELF_LOREMASTER:
-      strcpy(p_gc->name, "Elven Loremaster");
-      strcpy(p_gc->descriptor, "elven loremaster");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->mental_power *= 5;
-      p_gc->mental_defense *= 5;
-      p_gc->soul = GOOD;
-      p_gc->languages[ELVISH] = KNOWN;
-      p_gc->languages[ANCIENT_ELVISH] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->words[WORD_OF_BALANCE] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      break;
-    case BARBARIAN:
-      strcpy(p_gc->name, "Babarian");
-      strcpy(p_gc->descriptor, "barbarian");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->languages[GESH] = KNOWN;
-      p_gc->experience *= 1.2;
-      break;
-    case BARBARIAN_WARRIOR:
-      strcpy(p_gc->name, "Barbarian Warrior");
-      strcpy(p_gc->descriptor, "barbarian warrior");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 3;
-      p_gc->languages[GESH] = KNOWN;
-      p_gc->level = 8;
-      p_gc->experience *= 2.5;
-      break;
-    case BARBARIAN_SHAMAN:
-      strcpy(p_gc->name, "Barbarian Shaman");
-      strcpy(p_gc->descriptor, "barbarian shaman");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->mental_power *= 2;
-      p_gc->mental_defense *= 2;
-      p_gc->languages[GESH] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->level = 10;
-      p_gc->experience *= 3;
-      break;
-    case BARBARIAN_CHIEFTAIN:
-      strcpy(p_gc->name, "Telth");
-      strcpy(p_gc->descriptor, "barbarian chieftain");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 5;
-      p_gc->physical_defense *= 5;
-      p_gc->mental_power *= 1.5;
-      p_gc->mental_defense *= 1.5;
-      p_gc->languages[GESH] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      break;
-    case DWARF:
-      strcpy(p_gc->name, "Dwarf");
-      strcpy(p_gc->descriptor, "dwarf");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 2;
-      p_gc->physical_defense *= 2;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->experience *= 1.2;
-      p_gc->gold = RandomInt(5, 10);
-      break;
-    case DWARF_GUARDIAN:
-      strcpy(p_gc->name, "Dwarven Guardian");
-      strcpy(p_gc->descriptor, "dwarven guardian");
-      p_gc->max_hp *= 3;
-      p_gc->hp *= 3;
-      p_gc->physical_power *= 4;
-      p_gc->physical_defense *= 4;
-      p_gc->mental_power *= 1.5;
-      p_gc->mental_defense *= 1.5;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->level = 10;
-      p_gc->experience *= 5;
-      p_gc->gold = RandomInt(10, 30);
-      break;
-    case DWARF_MERCHANT:
-      strcpy(p_gc->name, "Dwarven Merchant");
-      strcpy(p_gc->descriptor, "dwarven merchant");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 2;
-      p_gc->physical_defense *= 2;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->experience *= 1.2;
-      p_gc->gold = RandomInt(50, 100);
-      break;
-    case DWARF_LOREMASTER:
-      strcpy(p_gc->name, "Dwarven Loremaster");
-      strcpy(p_gc->descriptor, "dwarven loremaster");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 2;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power *= 5;
-      p_gc->mental_defense *= 5;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->languages[ANCIENT_DWARVISH] = KNOWN;
-      p_gc->languages[GNOMISH] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->words[WORD_OF_FOCUS] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      p_gc->gold = RandomInt(10, 20);
-      break;
-    case DWARF_PRIEST:
-      strcpy(p_gc->name, "Dwarven Priest");
-      strcpy(p_gc->descriptor, "dwarven priest");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 2;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power *= 3;
-      p_gc->mental_defense *= 3;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->languages[ANCIENT_DWARVISH] = KNOWN;
-      p_gc->languages[GNOMISH] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->words[WORD_OF_FOCUS] = KNOWN;
-      p_gc->level = 10;
-      p_gc->experience *= 3;
-      p_gc->gold = RandomInt(10, 20);
-      break;
-    case DWARF_HIGH_PRIEST:
-      strcpy(p_gc->name, "Dwarven High Priest");
-      strcpy(p_gc->descriptor, "dwarven high priest");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 2;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power *= 5;
-      p_gc->mental_defense *= 5;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->languages[ANCIENT_DWARVISH] = KNOWN;
-      p_gc->languages[GNOMISH] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->words[WORD_OF_FOCUS] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      p_gc->gold = RandomInt(10, 20);
-      break;
-    case DWARF_KING:
-      strcpy(p_gc->name, "King Beoklast");
-      strcpy(p_gc->descriptor, "dwarven king");
-      p_gc->max_hp *= 4;
-      p_gc->hp *= 4;
-      p_gc->physical_power *= 5;
-      p_gc->physical_defense *= 5;
-      p_gc->mental_power *= 1.5;
-      p_gc->mental_defense *= 2;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->languages[ANCIENT_DWARVISH] = KNOWN;
-      p_gc->languages[GNOMISH] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 12;
-      p_gc->gold = RandomInt(500, 1000);
-      break;
-    case DWARF_MINER:
-      strcpy(p_gc->name, "Dwarven Miner");
-      strcpy(p_gc->descriptor, "dwarven miner");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power *= 1.5;
-      p_gc->mental_defense *= 1.5;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->experience *= 1.5;
-      p_gc->gold = RandomInt(10, 20);
-      break;
-    case DRAGON:
-      strcpy(p_gc->name, "Dragon");
-      strcpy(p_gc->descriptor, "dragon");
-      p_gc->max_hp *= 50;
-      p_gc->hp *= 50;
-      p_gc->physical_power *= 50;
-      p_gc->physical_defense *= 50;
-      p_gc->mental_power *= 10;
-      p_gc->mental_defense *= 5;
-      p_gc->relationship = HOSTILE_ENEMY;
-      p_gc->languages[ANCIENT_DWARVISH] = KNOWN;
-      p_gc->languages[ANCIENT_GNOMISH] = KNOWN;
-      p_gc->languages[ANCIENT_ELVISH] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->level = 30;
-      p_gc->experience *= 100;
-      break;
-    case GNOME:
-      strcpy(p_gc->name, "Gnome");
-      strcpy(p_gc->descriptor, "gnome");
-      p_gc->mental_power *= 1.5;
-      p_gc->mental_defense *= 1.5;
-      p_gc->languages[GNOMISH] = KNOWN;
-      p_gc->gold = RandomInt(10, 20);
-      break;
-    case GNOME_MINER:
-      strcpy(p_gc->name, "Gnomish Miner");
-      strcpy(p_gc->descriptor, "gnomish miner");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->mental_power *= 1.5;
-      p_gc->mental_defense *= 1.5;
-      p_gc->languages[GNOMISH] = KNOWN;
-      p_gc->experience *= 1.2;
-      p_gc->gold = RandomInt(10, 20);
-      break;
-    case NECROMANCER:
-      strcpy(p_gc->name, "Necromancer");
-      strcpy(p_gc->descriptor, "necromancer");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->mental_power *= 3;
-      p_gc->mental_defense *= 2;
-      p_gc->relationship = ENEMY;
-      p_gc->soul = EXTREMELY_EVIL;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_EVIL] = KNOWN;
-      p_gc->level = 10;
-      p_gc->experience *= 3.5;
-      p_gc->gold = RandomInt(25, 50);
-      break;
-    case ARCHNECROMANCER:
-      strcpy(p_gc->name, "Kraathmot");
-      strcpy(p_gc->descriptor, "archnecromancer");
-      p_gc->max_hp *= 3;
-      p_gc->hp *= 3;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->mental_power *= 5;
-      p_gc->mental_defense *= 4;
-      p_gc->relationship = ENEMY;
-      p_gc->soul = EXTREMELY_EVIL;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_EVIL] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      p_gc->gold = RandomInt(50, 100);
-      break;
-    case LICH:
-      strcpy(p_gc->name, "Velroth");
-      strcpy(p_gc->descriptor, "lich");
-      p_gc->unique = true;
-      p_gc->max_hp *= 5;
-      p_gc->hp *= 5;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 3;
-      p_gc->mental_power *= 15;
-      p_gc->mental_defense *= 15;
-      p_gc->soul = EXTREMELY_EVIL;
-      p_gc->relationship = ENEMY;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_EVIL] = KNOWN;
-      p_gc->level = 30;
-      p_gc->experience *= 30;
-      p_gc->gold = RandomInt(1000, 2000);
-      break;
-    case ZOMBIE:
-      strcpy(p_gc->name, "Zombie");
-      strcpy(p_gc->descriptor, "zombie");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 2;
-      p_gc->mental_power = 0;
-      p_gc->mental_defense = 0;
-      p_gc->soul = EVIL;
-      p_gc->relationship = HOSTILE_ENEMY;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->experience *= 2;
-      break;
-    case SKELETAL_KNIGHT:
-      strcpy(p_gc->name, "Skeletal Knight");
-      strcpy(p_gc->descriptor, "skeletal knight");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power = 0;
-      p_gc->mental_defense = 0;
-      p_gc->soul = EVIL;
-      p_gc->relationship = HOSTILE_ENEMY;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->level = 10;
-      p_gc->experience *= 5;
-      break;
-    case RAT:
-      strcpy(p_gc->name, "Rat");
-      strcpy(p_gc->descriptor, "large rat");
-      p_gc->max_hp /= 2;
-      p_gc->hp /= 2;
-      p_gc->physical_power /= 5;
-      p_gc->physical_defense /= 5;
-      p_gc->mental_power /= 10;
-      p_gc->mental_defense /= 10;
-      p_gc->relationship = ENEMY;
-      p_gc->experience /= 10;
-      break;
-    case SHARK:
-      strcpy(p_gc->name, "Shark");
-      strcpy(p_gc->descriptor, "shark");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power /= 10;
-      p_gc->mental_defense /= 10;
-      p_gc->relationship = HOSTILE_ENEMY;
-      p_gc->experience *= 2.5;
-      break;
-    case WOLF:
-      strcpy(p_gc->name, "Wolf");
-      strcpy(p_gc->descriptor, "wolf");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power /= 10;
-      p_gc->mental_defense /= 10;
-      p_gc->relationship = HOSTILE_ENEMY;
-      p_gc->experience *= 2.5;
-      break;
-    case BEAR:
-      strcpy(p_gc->name, "Bear");
-      strcpy(p_gc->descriptor, "bear");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power /= 10;
-      p_gc->mental_defense /= 10;
-      p_gc->relationship = HOSTILE_ENEMY;
-      p_gc->experience *= 2.5;
-      break;
-    case GOBLIN:
-      strcpy(p_gc->name, "Goblin");
-      strcpy(p_gc->descriptor, "goblin");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power /= 10;
-      p_gc->mental_defense /= 10;
-      p_gc->relationship = HOSTILE_ENEMY;
-      p_gc->experience *= 2.5;
-      break;
-    case ORC:
-      strcpy(p_gc->name, "Orc");
-      strcpy(p_gc->descriptor, "orc");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power /= 10;
-      p_gc->mental_defense /= 10;
-      p_gc->relationship = HOSTILE_ENEMY;
-      p_gc->experience *= 2.5;
-      break;
-    case GIANT_SQUID:
-      strcpy(p_gc->name, "Giant Squid");
-      strcpy(p_gc->descriptor, "giant squid");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power /= 10;
-      p_gc->mental_defense /= 10;
-      p_gc->relationship = HOSTILE_ENEMY;
-      p_gc->experience *= 2.5;
-      break;
-    case MERFOLK:
-      strcpy(p_gc->name, "Merfolk");
-      strcpy(p_gc->descriptor, "merfolk");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->mental_defense *= 2;
-      p_gc->relationship = ENEMY;
-      p_gc->languages[MER] = KNOWN;
-      p_gc->experience *= 1.2;
-      break;
-    case MERFOLK_SOLDIER:
-      strcpy(p_gc->name, "Merman Soldier");
-      strcpy(p_gc->descriptor, "merman soldier");
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 3;
-      p_gc->mental_defense *= 3;
-      p_gc->level = 2;
-      p_gc->relationship = ENEMY;
-      p_gc->languages[MER] = KNOWN;
-      p_gc->experience *= 2;
-      break;
-    case MERFOLK_HIGH_PRIESTESS:
-      strcpy(p_gc->name, "Quaelos");
-      strcpy(p_gc->descriptor, "mermaid high priestess");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->mental_power *= 12;
-      p_gc->mental_defense *= 12;
-      p_gc->relationship = ENEMY;
-      p_gc->languages[MER] = KNOWN;
-      p_gc->languages[ANCIENT_MER] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_WAVES] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      break;
-    case MERFOLK_PRIESTESS:
-      strcpy(p_gc->name, "Mermaid Priestess");
-      strcpy(p_gc->descriptor, "mermaid priestess");
-      p_gc->max_hp *= 1.5;
-      p_gc->hp *= 1.5;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->mental_power *= 3;
-      p_gc->mental_defense *= 3;
-      p_gc->relationship = ENEMY;
-      p_gc->languages[MER] = KNOWN;
-      p_gc->languages[ANCIENT_MER] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_WAVES] = KNOWN;
-      p_gc->level = 10;
-      p_gc->experience *= 3;
-      break;
-    case MERFOLK_QUEEN:
-      strcpy(p_gc->name, "Queen Serashnul");
-      strcpy(p_gc->descriptor, "mermaid queen");
-      p_gc->unique = true;
-      p_gc->max_hp *= 2;
-      p_gc->hp *= 2;
-      p_gc->physical_power *= 2;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power *= 3;
-      p_gc->mental_defense *= 3;
-      p_gc->relationship = ENEMY;
-      p_gc->languages[MER] = KNOWN;
-      p_gc->languages[ANCIENT_MER] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->level = 20;
-      p_gc->experience *= 10;
-      break;
-    case THE_DARK_RECLUSE:
-      strcpy(p_gc->name, "The Dark Recluse");
-      strcpy(p_gc->descriptor, "black-robed wizard");
-      p_gc->unique = true;
-      p_gc->max_hp *= 4;
-      p_gc->hp *= 4;
-      p_gc->physical_power *= 1.5;
-      p_gc->physical_defense *= 1.5;
-      p_gc->mental_power *= 15;
-      p_gc->mental_defense *= 15;
-      p_gc->soul = VERY_EVIL;
-      p_gc->relationship = ENEMY;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_EVIL] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->level = 40;
-      p_gc->experience *= 40;
-      break;
-    case THE_HERMIT:
-      strcpy(p_gc->name, "The Hermit");
-      strcpy(p_gc->descriptor, "old, green-robed man");
-      p_gc->unique = true;
-      p_gc->max_hp *= 4;
-      p_gc->hp *= 4;
-      p_gc->physical_power *= 2;
-      p_gc->physical_defense *= 2;
-      p_gc->mental_power *= 15;
-      p_gc->mental_defense *= 15;
-      p_gc->relationship = ENEMY;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ELVISH] = KNOWN;
-      p_gc->languages[ANCIENT_ELVISH] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->words[WORD_OF_BALANCE] = KNOWN;
-      p_gc->words[WORD_OF_TIME] = KNOWN;
-      p_gc->level = 40;
-      p_gc->experience *= 40;
-      break;
-    case THE_ANGLER:
-      strcpy(p_gc->name, "The Angler");
-      strcpy(p_gc->descriptor, "old, blue-robed fisherman");
-      p_gc->unique = true;
-      p_gc->max_hp *= 3;
-      p_gc->hp *= 3;
-      p_gc->mental_power *= 15;
-      p_gc->mental_defense *= 15;
-      p_gc->soul = GOOD;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->languages[MER] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->level = 40;
-      p_gc->experience *= 40;
-      p_gc->gold = RandomInt(1, 10);
-      break;
-    case THE_WANDERING_MONK:
-      strcpy(p_gc->name, "The Wandering Monk");
-      strcpy(p_gc->descriptor, "red-robed monk");
-      p_gc->unique = true;
-      p_gc->max_hp *= 4;
-      p_gc->hp *= 4;
-      p_gc->physical_power *= 3;
-      p_gc->physical_defense *= 3;
-      p_gc->mental_power *= 15;
-      p_gc->mental_defense *= 15;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->languages[GNOMISH] = KNOWN;
-      p_gc->languages[GESH] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->words[WORD_OF_EVIL] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->words[WORD_OF_VOID] = KNOWN;
-      p_gc->level = 40;
-      p_gc->experience *= 40;
-      p_gc->gold = RandomInt(0, 5);
-      break;
-    case THE_SILENT_SAGE:
-      strcpy(p_gc->name, "The Silent Sage");
-      strcpy(p_gc->descriptor, "old, white-robed man");
-      p_gc->unique = true;
-      p_gc->max_hp *= 3;
-      p_gc->hp *= 3;
-      p_gc->mental_power *= 20;
-      p_gc->mental_defense *= 20;
-      p_gc->soul = VERY_GOOD;
-      p_gc->languages[IMPERIAL] = KNOWN;
-      p_gc->languages[ANCIENT_IMPERIAL] = KNOWN;
-      p_gc->languages[VENTARRI] = KNOWN;
-      p_gc->languages[ANCIENT_VENTARRI] = KNOWN;
-      p_gc->languages[ELVISH] = KNOWN;
-      p_gc->languages[ANCIENT_ELVISH] = KNOWN;
-      p_gc->languages[DWARVISH] = KNOWN;
-      p_gc->languages[ANCIENT_DWARVISH] = KNOWN;
-      p_gc->languages[GNOMISH] = KNOWN;
-      p_gc->languages[ANCIENT_GNOMISH] = KNOWN;
-      p_gc->words[WORD_OF_FIRE] = KNOWN;
-      p_gc->words[WORD_OF_EARTH] = KNOWN;
-      p_gc->words[WORD_OF_WATER] = KNOWN;
-      p_gc->words[WORD_OF_AIR] = KNOWN;
-      p_gc->words[WORD_OF_BODY] = KNOWN;
-      p_gc->words[WORD_OF_MIND] = KNOWN;
-      p_gc->words[WORD_OF_FLORA] = KNOWN;
-      p_gc->words[WORD_OF_FAUNA] = KNOWN;
-      p_gc->words[WORD_OF_LIGHT] = KNOWN;
-      p_gc->words[WORD_OF_DARKNESS] = KNOWN;
-      p_gc->words[WORD_OF_HEALTH] = KNOWN;
-      p_gc->words[WORD_OF_SICKNESS] = KNOWN;
-      p_gc->words[WORD_OF_LIFE] = KNOWN;
-      p_gc->words[WORD_OF_DEATH] = KNOWN;
-      p_gc->words[WORD_OF_GIVING] = KNOWN;
-      p_gc->words[WORD_OF_TAKING] = KNOWN;
-      p_gc->words[WORD_OF_INCREASE] = KNOWN;
-      p_gc->words[WORD_OF_DECREASE] = KNOWN;
-      p_gc->words[WORD_OF_HOLINESS] = KNOWN;
-      p_gc->words[WORD_OF_EVIL] = KNOWN;
-      p_gc->words[WORD_OF_SHIELDING] = KNOWN;
-      p_gc->words[WORD_OF_TIME] = KNOWN;
-      p_gc->level = 50;
-      p_gc->experience *= 50;
-      p_gc->gold = RandomInt(1, 10);
-      break;
-    default:
-      PRINT_ERROR_MESSAGE;
+  return *shared;
+}
+
+/*******************************************************************************
+   Function: BuildTemplate
+
+Description: Fills in a character template from a game character type's
+             defining data.
+
+     Inputs: template  - Pointer to the template to be filled in.
+             prototype - Pointer to the type's defining data.
+             location  - The location where the character is being created.
+
+    Outputs: None.
+*******************************************************************************/
+void BuildTemplate(character_template_t *template,
+                   const character_type_t *prototype, location_t *location) {
+  strcpy(template->name, prototype->name);
+  strcpy(template->descriptor, prototype->descriptor);
+  template->unique = prototype->traits & TRAIT_UNIQUE;
+  template->level = prototype->level;
+  template->experience = prototype->experience;
+  template->known_languages = prototype->languages;
+  if (prototype->traits & TRAIT_LOCAL_LANGUAGE) {
+    template->known_languages |=
+      LANGUAGE_BIT(InVentarrisTerritory(location) ? VENTARRI : IMPERIAL);
+  }
+  template->known_words = prototype->words;
+  template->partially_known_words = 0;
+}
+
+/*******************************************************************************
+   Function: AllocateCharacter
+
+Description: Allocates memory for a new game character belonging to the current
+             world, reusing a deleted character if one is available. Otherwise,
+             the character's frequently scanned fields come from the world
+             arena, where they sit close to those of other characters, while
+             its details come from a separate arena.
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: Pointer to the new, uninitialized game character (or NULL if
+             allocation fails). Its "handle" is already valid.
+*******************************************************************************/
+game_character_t *AllocateCharacter(game_session_t *session) {
+  character_pool_t *pool = &session->characters;
+  game_character_t *p_gc;
+
+  if (pool->free_list == 0 && ReserveCharacters(session, 1) == FAILURE) {
+    return NULL;
+  }
+  p_gc = pool->slots[pool->free_list].p_gc;
+  pool->free_list = p_gc->next;
+  p_gc->template = NULL;  // Assigned by "InitializeCharacter".
+  pool->num_in_use++;
+  if (pool->num_in_use > pool->high_water_mark) {
+    pool->high_water_mark = pool->num_in_use;
+  }
+
+  return p_gc;
+}
+
+/*******************************************************************************
+   Function: ReleaseCharacter
+
+Description: Returns a deleted game character to the session's character pool
+             for reuse by "AllocateCharacter". Advancing the generation of the
+             character's slot invalidates every existing handle to it.
+
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character being released.
+
+    Outputs: None.
+*******************************************************************************/
+void ReleaseCharacter(game_session_t *session, game_character_t *p_gc) {
+  int index = p_gc->handle & HANDLE_INDEX_MASK;
+  character_slot_t *slot = &session->characters.slots[index];
+
+  DiscardStack(p_gc);  // Its members, if any, go with it.
+  slot->generation = slot->generation % (UINT32_MAX >> HANDLE_INDEX_BITS) + 1;
+  p_gc->handle = (slot->generation << HANDLE_INDEX_BITS) | index;
+  p_gc->next = session->characters.free_list;  // A slot index, not a handle.
+  p_gc->previous = NO_CHARACTER;
+  session->characters.free_list = index;
+  session->characters.num_in_use--;
+}
+
+/*******************************************************************************
+   Function: ReserveCharacters
+
+Description: Allocates memory for a number of game characters in advance,
+             adding them to the session's character pool so that creating
+             characters later (e.g., mid-combat) allocates nothing.
+
+     Inputs: session - Pointer to the current game session.
+             amount  - Number of characters to set aside.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int ReserveCharacters(game_session_t *session, int amount) {
+  int i;
+  game_character_t *p_gc;
+
+  for (i = 0; i < amount; i++) {
+    p_gc = ArenaAllocate(&session->world_arena, sizeof(game_character_t));
+    if (p_gc == NULL) {
+      return FAILURE;
+    }
+    p_gc->details = ArenaAllocate(&session->details_arena,
+                                  sizeof(character_details_t));
+    if (p_gc->details == NULL ||
+        AddCharacterSlot(session, p_gc) == FAILURE) {
       return FAILURE;
+    }
+    p_gc->next = session->characters.free_list;
+    session->characters.free_list = p_gc->handle & HANDLE_INDEX_MASK;
   }
 
   return SUCCESS;
 }
 
 /*******************************************************************************
-   Function: AddCompanion
+   Function: AddCharacterSlot
 
-Description: Removes a game character from the current location's list of
-             inhabitants and adds that character to the player's list of
-             companions.
+Description: Adds a game character to the world's character table, growing the
+             table as needed, and assigns the character its handle.
 
-     Inputs: companion - Pointer to the player's new companion.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character of interest.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int AddCompanion(game_character_t *companion) {
-  game_character_t *p_gc1, *p_gc2 = NULL;
+int AddCharacterSlot(game_session_t *session, game_character_t *p_gc) {
+  int new_capacity;
+  character_pool_t *pool = &session->characters;
+  character_slot_t *slot, *new_slots;
 
-  if (companion == NULL) {
-    PRINT_ERROR_MESSAGE;
-    return FAILURE;
+  if (pool->num_slots == 0) {
+    pool->num_slots = 1;  // Slot 0 is reserved for "NO_CHARACTER".
   }
+  if (pool->num_slots >= pool->capacity) {
+    new_capacity = pool->capacity > 0 ? pool->capacity * 2 :
+                                        CHARACTER_TABLE_CAPACITY;
+    if (new_capacity > (int) (HANDLE_INDEX_MASK + 1)) {
+      return FAILURE;
+    }
+    new_slots = realloc(pool->slots, new_capacity * sizeof(character_slot_t));
+    if (new_slots == NULL) {
+      return FAILURE;
+    }
+    memset(new_slots + pool->capacity, 0,
+           (new_capacity - pool->capacity) * sizeof(character_slot_t));
+    pool->slots = new_slots;
+    pool->capacity = new_capacity;
+  }
+  slot = &pool->slots[pool->num_slots];
+  slot->p_gc = p_gc;
 
-  // Add "companion" to player's list of companions:
-  if (g_player.next == NULL) {
-    g_player.next = companion;
-  } else {
-    for (p_gc1 = g_player.next;
-         p_gc1->next != NULL;
-         p_gc1 = p_gc1->next)
-      ;
-    p_gc1->next = companion;
+  // Continue from the slot's previous generation (if any), so that handles
+  // left over from an earlier world never match:
+  slot->generation = slot->generation % (UINT32_MAX >> HANDLE_INDEX_BITS) + 1;
+  p_gc->handle = (slot->generation << HANDLE_INDEX_BITS) | pool->num_slots;
+  pool->num_slots++;
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: GetCharacter
+
+Description: Resolves a handle to the game character it refers to.
+
+     Inputs: session - Pointer to the current game session.
+             handle  - Handle of the game character of interest.
+
+    Outputs: Pointer to the game character, or NULL if the handle is
+             NO_CHARACTER or its character has since been deleted.
+*******************************************************************************/
+game_character_t *GetCharacter(game_session_t *session,
+                               character_handle_t handle) {
+  character_slot_t *slot;
+
+  if ((handle & HANDLE_INDEX_MASK) >=
+      (character_handle_t) session->characters.num_slots) {
+    return NULL;
+  }
+  slot = &session->characters.slots[handle & HANDLE_INDEX_MASK];
+  if (slot->generation != handle >> HANDLE_INDEX_BITS) {
+    return NULL;  // Includes "NO_CHARACTER" (slot 0 has generation 0).
   }
 
-  // Remove "companion" from current location's list of inhabitants:
-  for (p_gc1 = g_world[g_player.location]->inhabitants;
-       p_gc1 != NULL;
-       p_gc2 = p_gc1, p_gc1 = p_gc1->next) {
-    if (p_gc1 == companion && p_gc2 != NULL) {
-      if (p_gc1->next == NULL) {
-        p_gc2->next = NULL;
-      } else {
-        p_gc2->next = p_gc1->next;
-      }
-      break;
-    }
+  return slot->p_gc;
+}
+
+/*******************************************************************************
+   Function: AppendCharacter
+
+Description: Adds a game character to the end of a doubly-linked list of game
+             characters in constant time.
+
+     Inputs: session - Pointer to the current game session.
+             head    - Pointer to the list's head.
+             tail    - Pointer to the list's tail.
+             p_gc    - Pointer to the game character to be added (which must
+                       not currently belong to any list).
+
+    Outputs: None.
+*******************************************************************************/
+void AppendCharacter(game_session_t *session, character_handle_t *head,
+                     character_handle_t *tail, game_character_t *p_gc) {
+  game_character_t *last = GetCharacter(session, *tail);
+
+  p_gc->next = NO_CHARACTER;
+  p_gc->previous = *tail;
+  if (last == NULL) {
+    *head = p_gc->handle;
+  } else {
+    last->next = p_gc->handle;
   }
+  *tail = p_gc->handle;
+}
 
-  companion->next = NULL;
+/*******************************************************************************
+   Function: UnlinkCharacter
 
-  if (p_gc1 == NULL) {  // If true, "companion" wasn't at current location.
-    PRINT_ERROR_MESSAGE;
+Description: Removes a game character from a doubly-linked list of game
+             characters in constant time.
+
+     Inputs: session - Pointer to the current game session.
+             head    - Pointer to the list's head.
+             tail    - Pointer to the list's tail.
+             p_gc    - Pointer to the game character to be removed.
+
+    Outputs: SUCCESS, or FAILURE if "p_gc" does not belong to the list.
+*******************************************************************************/
+int UnlinkCharacter(game_session_t *session, character_handle_t *head,
+                    character_handle_t *tail, game_character_t *p_gc) {
+  game_character_t *previous = GetCharacter(session, p_gc->previous),
+                   *next = GetCharacter(session, p_gc->next);
+
+  if ((previous == NULL ? *head : previous->next) != p_gc->handle ||
+      (next == NULL ? *tail : next->previous) != p_gc->handle) {
     return FAILURE;
   }
+  if (previous == NULL) {
+    *head = p_gc->next;
+  } else {
+    previous->next = p_gc->next;
+  }
+  if (next == NULL) {
+    *tail = p_gc->previous;
+  } else {
+    next->previous = p_gc->previous;
+  }
+  p_gc->next = NO_CHARACTER;
+  p_gc->previous = NO_CHARACTER;
 
   return SUCCESS;
 }
 
 /*******************************************************************************
-   Function: RemoveCompanion
+   Function: AddCompanion
 
-Description: Removes a game character from the player's list of companions and
-             adds that character to the current location's list of inhabitants.
+Description: Removes a game character from the current location's list of
+             inhabitants and adds that character to the player's list of
+             companions.
 
-     Inputs: companion - Pointer to the companion to be removed.
+     Inputs: session   - Pointer to the current game session.
+             companion - Pointer to the player's new companion.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int RemoveCompanion(game_character_t *companion) {
-  game_character_t *p_gc1, *p_gc2 = NULL;
+int AddCompanion(game_session_t *session, game_character_t *companion) {
+  location_t *location;
 
   if (companion == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  // Add "companion" to current location's list of inhabitants:
-  if (g_world[g_player.location]->inhabitants == NULL) {
-    g_world[g_player.location]->inhabitants = companion;
-  } else {
-    for (p_gc1 = g_world[g_player.location]->inhabitants;
-         p_gc1->next != NULL;
-         p_gc1 = p_gc1->next)
-      ;
-    p_gc1->next = companion;
+  // Move "companion" from the current location to the player's companions:
+  location = session->world[session->player.location];
+  if (UnlinkInhabitant(session, location, companion) == FAILURE) {
+    PRINT_ERROR_MESSAGE;  // "companion" wasn't at current location.
+    return FAILURE;
   }
+  AppendCharacter(session, &session->player.next, &session->last_companion,
+                  companion);
 
-  // Remove "companion" from player's list of companions:
-  for (p_gc1 = g_player.next;
-       p_gc1 != NULL;
-       p_gc2 = p_gc1, p_gc1 = p_gc1->next) {
-    if (p_gc1 == companion && p_gc2 != NULL) {
-      if (p_gc1->next == NULL) {
-        p_gc2->next = NULL;
-      } else {
-        p_gc2->next = p_gc1->next;
-      }
-      break;
-    }
-  }
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: RemoveCompanion
+
+Description: Removes a game character from the player's list of companions and
+             adds that character to the current location's list of inhabitants.
 
-  companion->next = NULL;
+     Inputs: session   - Pointer to the current game session.
+             companion - Pointer to the companion to be removed.
 
-  if (p_gc1 == NULL) {  // If true, "companion" wasn't player's companion.
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int RemoveCompanion(game_session_t *session, game_character_t *companion) {
+  location_t *location;
+
+  if (companion == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
+  // Move "companion" from the player's companions to the current location:
+  if (UnlinkCharacter(session, &session->player.next, &session->last_companion,
+                      companion) == FAILURE) {
+    PRINT_ERROR_MESSAGE;  // "companion" wasn't player's companion.
+    return FAILURE;
+  }
+  location = session->world[session->player.location];
+  LinkInhabitant(session, location, companion);
+
   return SUCCESS;
 }
 
@@ -1517,43 +479,29 @@ int RemoveCompanion(game_character_t *companion) {
    Function: DeleteCompanion
 
 Description: Removes a game character from the player's list of companions and
-             deallocates associated memory.
+             returns it to the session's character pool.
 
-     Inputs: companion - Pointer to the companion to be removed.
+     Inputs: session   - Pointer to the current game session.
+             companion - Pointer to the companion to be removed.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int DeleteCompanion(game_character_t *companion) {
-  game_character_t *p_gc1, *p_gc2 = NULL;
-
+int DeleteCompanion(game_session_t *session, game_character_t *companion) {
   if (companion == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  // Remove "companion" from player's list of companions:
-  for (p_gc1 = g_player.next;
-       p_gc1 != NULL;
-       p_gc2 = p_gc1, p_gc1 = p_gc1->next) {
-    if (p_gc1 == companion && p_gc2 != NULL) {
-      if (p_gc1->next == NULL) {
-        p_gc2->next = NULL;
-      } else {
-        p_gc2->next = p_gc1->next;
-      }
-      break;
-    }
-  }
-  if (p_gc1 == NULL) {  // If true, "companion" wasn't player's companion.
-    PRINT_ERROR_MESSAGE;
+  if (UnlinkCharacter(session, &session->player.next, &session->last_companion,
+                      companion) == FAILURE) {
+    PRINT_ERROR_MESSAGE;  // "companion" wasn't player's companion.
     return FAILURE;
   }
 
-  // Deallocate associated memory:
-  if (companion->summoned_creature != NULL) {
-    DeleteCreatureSummonedBy(companion);
+  if (companion->summoned_creature != NO_CHARACTER) {
+    DeleteCreatureSummonedBy(session, companion);
   }
-  free(companion);
+  ReleaseCharacter(session, companion);
 
   return SUCCESS;
 }
@@ -1563,25 +511,37 @@ int DeleteCompanion(game_character_t *companion) {
 
 Description: Creates a new, summoned game character and associates it with its
              summoner. (If the summoner already had a summoned creature, that
-             creature is deleted.)
+             creature is deleted.) During combat, the creature joins the
+             battle on its summoner's side.
 
-     Inputs: summoner - Pointer to the character that summoned the creature.
+     Inputs: session  - Pointer to the current game session.
+             summoner - Pointer to the character that summoned the creature.
              type     - Integer representing the summoned creature's type.
 
     Outputs: Pointer to the summoned creature.
 *******************************************************************************/
-game_character_t *AddSummonedCreature(game_character_t *summoner, int type) {
+game_character_t *AddSummonedCreature(game_session_t *session,
+                                      game_character_t *summoner, int type) {
+  bool hostile;
   game_character_t *newGC = NULL;
 
   if (summoner == NULL) {
     PRINT_ERROR_MESSAGE;
   } else {
-    if (summoner->summoned_creature != NULL) {
-      DeleteCreatureSummonedBy(summoner);
+    if (summoner->summoned_creature != NO_CHARACTER) {
+      DeleteCreatureSummonedBy(session, summoner);
     }
-    newGC = malloc(sizeof(game_character_t));
+    newGC = AllocateCharacter(session);
     if (newGC != NULL) {
-      InitializeCharacter(newGC, type, g_world[summoner->location]);
+      InitializeCharacter(session, newGC, type,
+                          session->world[summoner->location]);
+      summoner->summoned_creature = newGC->handle;
+      if (session->player.status[IN_COMBAT]) {  // Joins the battle.
+        hostile = summoner != &session->player &&
+                  summoner->status[IN_COMBAT];
+        newGC->status[IN_COMBAT] = hostile;  // As enemies' turns require.
+        ScheduleCombatant(session, newGC, hostile);
+      }
     } else {
       PRINT_ERROR_MESSAGE;
       exit(1);
@@ -1594,25 +554,25 @@ game_character_t *AddSummonedCreature(game_character_t *summoner, int type) {
 /*******************************************************************************
    Function: DeleteCreatureSummonedBy
 
-Description: Removes a summoned creature from its summoner's struct and
-             deallocates associated memory.
+Description: Removes a summoned creature from its summoner's struct and returns
+             the creature to the session's character pool.
 
-     Inputs: summoner - Pointer to the character who summoned the creature to be
+     Inputs: session  - Pointer to the current game session.
+             summoner - Pointer to the character who summoned the creature to be
                         deleted.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int DeleteCreatureSummonedBy(game_character_t *summoner) {
-  game_character_t *creature;
-
-  if (summoner == NULL || summoner->summoned_creature == NULL) {
+int DeleteCreatureSummonedBy(game_session_t *session,
+                             game_character_t *summoner) {
+  if (summoner == NULL || summoner->summoned_creature == NO_CHARACTER) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  creature = summoner->summoned_creature;
-  summoner->summoned_creature = NULL;
-  free(creature);
+  ReleaseCharacter(session,
+                   GetCharacter(session, summoner->summoned_creature));
+  summoner->summoned_creature = NO_CHARACTER;
 
   return SUCCESS;
 }
@@ -1623,41 +583,47 @@ int DeleteCreatureSummonedBy(game_character_t *summoner) {
 Description: Displays detailed information about a given game character (and the
              character's summoned creature and/or companions, if any).
 
-     Inputs: p_gc - Game character of interest.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Game character of interest.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int DisplayCharacterData(game_character_t *p_gc) {
+int DisplayCharacterData(game_session_t *session, game_character_t *p_gc) {
+  game_character_t *summoned_creature;
+
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  printf("Name: %s\n", p_gc->name);
-  printf("Level: %d\n", p_gc->level);
-  printf("Experience: %d\n", p_gc->experience);
-  printf("HP: %d/%d\n", p_gc->hp, p_gc->max_hp);
-  printf("Physical power: %d\n", p_gc->physical_power);
-  printf("Physical defense: %d\n", p_gc->physical_defense);
-  printf("Speed: %d\n", p_gc->speed);
-  printf("Mental power: %d\n", p_gc->mental_power);
-  printf("Mental defense: %d\n", p_gc->mental_defense);
-  printf("Soul: ");
-  PrintSoulDescription(p_gc);
-  printf("\n");
-  printf("Languages learned: %d\n", NumberOfLanguagesKnown(p_gc));
-  printf("Words of Power acquired: %d\n", NumberOfWordsKnown(p_gc));
-  printf("Gold: %d\n", p_gc->gold);
-  PrintInventory(p_gc);
+  PrintFormatted(session, "Name: %s\n", p_gc->template->name);
+  PrintFormatted(session, "Level: %d\n", p_gc->template->level);
+  PrintFormatted(session, "Experience: %d\n", p_gc->template->experience);
+  PrintFormatted(session, "HP: %d/%d\n", p_gc->hp, p_gc->max_hp);
+  PrintFormatted(session, "Physical power: %d\n", p_gc->physical_power);
+  PrintFormatted(session, "Physical defense: %d\n", p_gc->physical_defense);
+  PrintFormatted(session, "Speed: %d\n", p_gc->speed);
+  PrintFormatted(session, "Mental power: %d\n", p_gc->mental_power);
+  PrintFormatted(session, "Mental defense: %d\n", p_gc->mental_defense);
+  PrintFormatted(session, "Soul: ");
+  PrintSoulDescription(session, p_gc);
+  PrintFormatted(session, "\n");
+  PrintFormatted(session, "Languages learned: %d\n",
+                 NumberOfLanguagesKnown(session, p_gc));
+  PrintFormatted(session, "Words of Power acquired: %d\n",
+                 NumberOfWordsKnown(session, p_gc));
+  PrintFormatted(session, "Gold: %d\n", p_gc->details->gold);
+  PrintInventory(session, p_gc);
   //PrintStatus(p_gc);
-  if (p_gc->summoned_creature != NULL) {
-    printf("Summoned creature: %s (%d/%d, ",
-           p_gc->summoned_creature->name,
-           p_gc->summoned_creature->hp,
-           p_gc->summoned_creature->max_hp);
-    //PrintStatus(p_gc->summoned_creature);
+  summoned_creature = GetCharacter(session, p_gc->summoned_creature);
+  if (summoned_creature != NULL) {
+    PrintFormatted(session, "Summoned creature: %s (%d/%d, ",
+                   summoned_creature->template->name,
+                   summoned_creature->hp,
+                   summoned_creature->max_hp);
+    //PrintStatus(summoned_creature);
   }
-  FlushInput();
+  FlushInput(session);
 
   return SUCCESS;
 }
@@ -1668,28 +634,29 @@ int DisplayCharacterData(game_character_t *p_gc) {
 Description: Prints one or two words describing the general state of a given
              game character's soul (e.g., "good", "evil", etc.).
 
-     Inputs: p_gc - Game character of interest.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Game character of interest.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int PrintSoulDescription(game_character_t *p_gc) {
+int PrintSoulDescription(game_session_t *session, game_character_t *p_gc) {
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   } else if (p_gc->soul <= EXTREMELY_EVIL) {
-    printf("Extremely Evil");
+    PrintFormatted(session, "Extremely Evil");
   } else if (p_gc->soul <= VERY_EVIL) {
-    printf("Very Evil");
+    PrintFormatted(session, "Very Evil");
   } else if (p_gc->soul <= EVIL) {
-    printf("Evil");
+    PrintFormatted(session, "Evil");
   } else if (p_gc->soul >= EXTREMELY_GOOD) {
-    printf("Extremely Good");
+    PrintFormatted(session, "Extremely Good");
   } else if (p_gc->soul >= VERY_GOOD) {
-    printf("Very Good");
+    PrintFormatted(session, "Very Good");
   } else if (p_gc->soul >= GOOD) {
-    printf("Good");
+    PrintFormatted(session, "Good");
   } else {
-    printf("Neutral");
+    PrintFormatted(session, "Neutral");
   }
 
   return SUCCESS;
@@ -1740,26 +707,19 @@ bool IsNeutral(game_character_t *p_gc) {
 
 Description: Returns the number of languages a given game character knows.
 
-     Inputs: p_gc - Game character of interest.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Game character of interest.
 
     Outputs: Number of languages the game character knows (or -1 if an error is
              encountered).
 *******************************************************************************/
-int NumberOfLanguagesKnown(game_character_t *p_gc) {
-  int i, numLanguages = 0;
-
+int NumberOfLanguagesKnown(game_session_t *session, game_character_t *p_gc) {
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return -1;
   }
 
-  for (i = 0; i < NUM_LANGUAGE_TYPES; i++) {
-    if (p_gc->languages[i] == KNOWN) {
-      numLanguages++;
-    }
-  }
-
-  return numLanguages;
+  return __builtin_popcount(p_gc->template->known_languages);
 }
 
 /*******************************************************************************
@@ -1767,26 +727,19 @@ int NumberOfLanguagesKnown(game_character_t *p_gc) {
 
 Description: Returns the number of Words of Power a given game character knows.
 
-     Inputs: p_gc - Game character of interest.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Game character of interest.
 
     Outputs: Number of Words the game character knows (or -1 if an error is
              encountered).
 *******************************************************************************/
-int NumberOfWordsKnown(game_character_t *p_gc) {
-  int i, numWords = 0;
-
+int NumberOfWordsKnown(game_session_t *session, game_character_t *p_gc) {
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return -1;
   }
 
-  for (i = 0; i < NUM_WORD_TYPES; i++) {
-    if (p_gc->words[i] == KNOWN) {
-      numWords++;
-    }
-  }
-
-  return numWords;
+  return __builtin_popcount(p_gc->template->known_words);
 }
 
 /*******************************************************************************
@@ -1795,24 +748,25 @@ int NumberOfWordsKnown(game_character_t *p_gc) {
 Description: Returns either a name or a generic descriptor preceded by "the" for
              a given game character.
 
-     Inputs: p_gc - Pointer to the game character of interest.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character of interest.
 
     Outputs: The game character's definite name/descriptor as a pointer to an
              array of characters.
 *******************************************************************************/
-char *GetNameDefinite(game_character_t *p_gc) {
-  static char name[SHORT_STR_LEN + 1];
+char *GetNameDefinite(game_session_t *session, game_character_t *p_gc) {
+  char *name = session->name_definite;
 
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return NULL;
   }
 
-  if (p_gc->unique && p_gc->known_to_player) {
-    return p_gc->name;
+  if (p_gc->template->unique && p_gc->details->known_to_player) {
+    return p_gc->template->name;
   }
   strcpy(name, "the ");
-  strcat(name, p_gc->descriptor);
+  strcat(name, p_gc->template->descriptor);
 
   return name;
 }
@@ -1823,36 +777,37 @@ char *GetNameDefinite(game_character_t *p_gc) {
 Description: Returns either a name or a generic descriptor preceded by "a" or
              "an" for a given game character.
 
-     Inputs: p_gc - Pointer to the game character of interest.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character of interest.
 
     Outputs: The game character's indefinite name/descriptor as a pointer to an
              array of characters.
 *******************************************************************************/
-char *GetNameIndefinite(game_character_t *p_gc) {
-  static char name[SHORT_STR_LEN + 1];
+char *GetNameIndefinite(game_session_t *session, game_character_t *p_gc) {
+  char *name = session->name_indefinite;
 
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return NULL;
   }
 
-  if (p_gc->unique && p_gc->known_to_player) {
-    return p_gc->name;
-  } else if (p_gc->descriptor[0] == 'a' ||
-             p_gc->descriptor[0] == 'e' ||
-             p_gc->descriptor[0] == 'i' ||
-             p_gc->descriptor[0] == 'o' ||
-             p_gc->descriptor[0] == 'u' ||
-             p_gc->descriptor[0] == 'A' ||
-             p_gc->descriptor[0] == 'E' ||
-             p_gc->descriptor[0] == 'I' ||
-             p_gc->descriptor[0] == 'O' ||
-             p_gc->descriptor[0] == 'U') {
+  if (p_gc->template->unique && p_gc->details->known_to_player) {
+    return p_gc->template->name;
+  } else if (p_gc->template->descriptor[0] == 'a' ||
+             p_gc->template->descriptor[0] == 'e' ||
+             p_gc->template->descriptor[0] == 'i' ||
+             p_gc->template->descriptor[0] == 'o' ||
+             p_gc->template->descriptor[0] == 'u' ||
+             p_gc->template->descriptor[0] == 'A' ||
+             p_gc->template->descriptor[0] == 'E' ||
+             p_gc->template->descriptor[0] == 'I' ||
+             p_gc->template->descriptor[0] == 'O' ||
+             p_gc->template->descriptor[0] == 'U') {
     strcpy(name, "an ");
   } else {
     strcpy(name, "a ");
   }
-  strcat(name, p_gc->descriptor);
+  strcat(name, p_gc->template->descriptor);
 
   return name;
 }
@@ -1863,15 +818,16 @@ char *GetNameIndefinite(game_character_t *p_gc) {
 Description: Returns the plural form of a given game character's generic
              descriptor.
 
-     Inputs: p_gc - Pointer to the game character whose name/description is to
-                    be made plural.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character whose name/description is
+                       to be made plural.
 
     Outputs: The game character's plural name/descriptor as a pointer to an
              array of characters.
 *******************************************************************************/
-char *GetNamePlural(game_character_t *p_gc) {
+char *GetNamePlural(game_session_t *session, game_character_t *p_gc) {
   int name_length;
-  static char name[SHORT_STR_LEN + 1];
+  char *name = session->name_plural;
 
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
@@ -1907,7 +863,7 @@ char *GetNamePlural(game_character_t *p_gc) {
       strcpy(name, "stuffed dummies");
       break;
     default:  // Add 's' to the end of the descriptor.
-      strcpy(name, p_gc->descriptor);
+      strcpy(name, p_gc->template->descriptor);
       name_length = strlen(name);
       if (name_length >= SHORT_STR_LEN - 1) {  // Ensure there's room for 's'.
         PRINT_ERROR_MESSAGE;
@@ -1925,53 +881,61 @@ char *GetNamePlural(game_character_t *p_gc) {
    Function: CheckStatus
 
 Description: Checks player's HP and status to see if anything needs to be
-             adjusted or reported.
+             adjusted or reported. (In silent mode, adjustments are made but no
+             report is composed.) Outside combat, also advances timed statuses
+             by one round (see "TickStatusEffects").
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: Returns 'true' if the player is still alive.
 *******************************************************************************/
-bool CheckStatus(void) {
-  bool player_is_alive = true;
-  int i;
-  char output[LONG_STR_LEN + 1] = "";
-
-  if (g_player.status[IN_COMBAT] == true) {
-    for (i = 0; i < NumberOfEnemies(); i++) {
-      if (g_enemies[i]->hp <= 0) {
-        strcat(output, Capitalize(GetNameDefinite(g_enemies[i])));
-        if (g_enemies[i]->status[INANIMATE]) {
-          strcat(output, " has been destroyed.\n");
-        } else {
-          strcat(output, " is dead.\n");
-        }
-        g_num_kills[g_enemies[i]->type]++;
-        DeleteEnemy(g_enemies[i]);
-        i--;  // Because "g_enemies" has been left-shifted.
-      }
+bool CheckStatus(game_session_t *session) {
+  bool player_is_alive = true, report = false;
+  string_builder_t output;
+  arena_mark_t mark = ArenaMark(&session->scratch);
+
+  InitStringBuilder(&output, &session->scratch);
+
+  if (session->player.status[IN_COMBAT] == false) {
+    TickStatusEffects(session);  // Outside combat, each turn is a round.
+  } else {
+    if (RemoveDeadEnemies(session, &output) > 0) {
+      report = true;
     }
-    PrintString(output);
-    FlushInput();
+    PrintString(session, output.data);
+    FlushInput(session);
   }
-  if (g_player.hp <= 0) {
-    if (g_enemies[0] != NULL && g_enemies[0]->type == DUMMY) {  // In tutorial.
-      sprintf(output,
-              "%s: \"You have fallen due to severe backlash from your spell! "
-              "This is often caused by speaking the same elemental Word more "
-              "than once, or by combining three or more elemental Words in a "
-              "single spell. We will bring you back to full health for now, "
-              "but you must be more cautious in the future.\"",
-              FindInhabitant(ARCHWIZARD_OF_ELEMENTS)->name);
-      g_player.hp = g_player.max_hp;
+  if (session->player.hp <= 0) {
+    report = true;
+    if (session->num_enemies > 0 &&
+        GetEnemy(session, 0)->type == DUMMY) {  // In tutorial.
+      if (!session->silent) {
+        ClearString(&output);
+        AppendFormatted(&output,
+                        "%s: \"You have fallen due to severe backlash from "
+                        "your spell! This is often caused by speaking the "
+                        "same elemental Word more than once, or by combining "
+                        "three or more elemental Words in a single spell. We "
+                        "will bring you back to full health for now, but you "
+                        "must be more cautious in the future.\"",
+                        FindInhabitant(session,
+                                       ARCHWIZARD_OF_ELEMENTS)->template->name);
+      }
+      session->player.hp = session->player.max_hp;
     } else {  // Not in tutorial mode: death is permanent.
-      sprintf(output, "Alas, %s has perished!\n", g_player.name);
+      if (!session->silent) {
+        ClearString(&output);
+        AppendFormatted(&output, "Alas, %s has perished!\n",
+                        session->player.template->name);
+      }
       player_is_alive = false;
     }
   }
-  if (strlen(output) > 0) {
-    PrintString(output);
-    FlushInput();
+  if (report) {
+    PrintString(session, output.data);
+    FlushInput(session);
   }
+  ArenaRelease(&session->scratch, mark);
 
   return player_is_alive;
 }
@@ -1981,34 +945,39 @@ bool CheckStatus(void) {
 
 Description: Updates the game character counter to accurately reflect the number
              of each GC type currently visible to the player. If in combat, only
-             enemies will be counted. (Summoned creatures are counted.)
+             enemies will be counted. (Summoned creatures and the members of
+             stacks are counted.)
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
-    Outputs: None. (Modifies the global "g_num_visible_of_type" array.)
+    Outputs: None. (Modifies the session's "num_visible_of_type" array.)
 *******************************************************************************/
-void UpdateVisibleGameCharCounter(void) {
+void UpdateVisibleGameCharCounter(game_session_t *session) {
   int i;
-  game_character_t *p_gc;
+  game_character_t *p_gc, *summoned_creature;
 
   for (i = 0; i < NUM_GC_TYPES; i++) {  // Clear the visible GC counter.
-    g_num_visible_of_type[i] = 0;
+    session->num_visible_of_type[i] = 0;
   }
-  if (g_player.status[IN_COMBAT]) {  // Combat mode: only count enemies.
-    for (i = 0; i < NumberOfEnemies(); i++) {
-      g_num_visible_of_type[g_enemies[i]->type]++;
-      if (g_enemies[i]->summoned_creature != NULL) {
-        g_num_visible_of_type[g_enemies[i]->summoned_creature->type]++;
+  if (session->player.status[IN_COMBAT]) {  // Combat mode: only count enemies.
+    for (i = 0; i < NumberOfEnemies(session); i++) {
+      session->num_visible_of_type[GetEnemy(session, i)->type] +=
+        StackSize(GetEnemy(session, i));
+      summoned_creature = GetCharacter(session,
+                                       GetEnemy(session, i)->summoned_creature);
+      if (summoned_creature != NULL) {
+        session->num_visible_of_type[summoned_creature->type]++;
       }
     }
   } else {  // Not in combat mode: count all local inhabitants.
-    for (p_gc = g_world[g_player.location]->inhabitants;
+    for (p_gc = FirstLocalInhabitant(session);
          p_gc != NULL;
-         p_gc = p_gc->next) {
+         p_gc = GetCharacter(session, p_gc->next)) {
       if (p_gc->status[INVISIBLE] == false) {
-        g_num_visible_of_type[p_gc->type]++;
-        if (p_gc->summoned_creature != NULL) {
-          g_num_visible_of_type[p_gc->summoned_creature->type]++;
+        session->num_visible_of_type[p_gc->type]++;
+        summoned_creature = GetCharacter(session, p_gc->summoned_creature);
+        if (summoned_creature != NULL) {
+          session->num_visible_of_type[summoned_creature->type]++;
         }
       }
     }
@@ -2020,11 +989,11 @@ void UpdateVisibleGameCharCounter(void) {
 
 Description: Takes the player through the process of selecting a target.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: Pointer to the targeted game character.
 *******************************************************************************/
-game_character_t *GetTarget(void) {
+game_character_t *GetTarget(game_session_t *session) {
   game_character_t *target = NULL;
 
   return target;
@@ -2034,19 +1003,19 @@ game_character_t *GetTarget(void) {
    Function: IsTargeted
 
 Description: Determines whether a given game character is currently being
-             targeted (i.e., being pointed to by an array of pointers to
-             targets).
+             targeted (i.e., its handle appears in an array of targets).
 
      Inputs: p_gc    - Pointer to the game character of interest.
-             targets - Array of pointers to targeted game characters.
+             targets - Array of handles of targeted game characters, ending
+                       with NO_CHARACTER.
 
     Outputs: true if "p_gc" is being targeted, otherwise false.
 *******************************************************************************/
-bool IsTargeted(game_character_t *p_gc, game_character_t *targets[]) {
+bool IsTargeted(game_character_t *p_gc, character_handle_t targets[]) {
   int i;
 
-  for (i = 0; i < MAX_TARGETS && targets[i] != NULL; i++) {
-    if (targets[i] == p_gc) {
+  for (i = 0; targets[i] != NO_CHARACTER; i++) {
+    if (targets[i] == p_gc->handle) {
       return true;
     }
   }
@@ -2061,13 +1030,15 @@ Description: Causes a given game character to regain a certain number of hit
              points (always at least 1). Will not allow current HP to exceed
              maximum HP.
 
-     Inputs: p_gc   - Pointer to the game character to be healed.
-             amount - Number of hit points to be recovered. If zero or negative,
-                      it will be converted to 1.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character to be healed.
+             amount  - Number of hit points to be recovered. If zero or
+                       negative, it will be converted to 1.
 
     Outputs: Number of hit points regained (or -1 if an error is encountered).
 *******************************************************************************/
-int HealGameCharacter(game_character_t *p_gc, int amount) {
+int HealGameCharacter(game_session_t *session, game_character_t *p_gc,
+                      int amount) {
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return -1;
@@ -2090,13 +1061,15 @@ int HealGameCharacter(game_character_t *p_gc, int amount) {
 Description: Causes a given game character to lose a certain number of hit
              points (always at least 1).
 
-     Inputs: p_gc   - Pointer to the game character to be damaged.
-             amount - Number of hit points to be lost. If zero or negative, it
-                      will be converted to 1.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character to be damaged.
+             amount  - Number of hit points to be lost. If zero or negative, it
+                       will be converted to 1.
 
     Outputs: Number of hit points lost (or -1 if an error is encountered).
 *******************************************************************************/
-int DamageGameCharacter(game_character_t *p_gc, int amount) {
+int DamageGameCharacter(game_session_t *session, game_character_t *p_gc,
+                        int amount) {
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return -1;
@@ -2119,19 +1092,20 @@ int DamageGameCharacter(game_character_t *p_gc, int amount) {
 Description: Increases the player's experience by a given amount and checks for
              level-up(s).
 
-     Inputs: amount - Number of experience points to be gained.
+     Inputs: session - Pointer to the current game session.
+             amount  - Number of experience points to be gained.
 
     Outputs: Number of level-ups.
 *******************************************************************************/
-int GainExperience(int amount) {
+int GainExperience(game_session_t *session, int amount) {
   int i, level_up_counter = 0;
 
-  printf("%d experience points earned!\n", amount);
-  FlushInput();
+  PrintFormatted(session, "%d experience points earned!\n", amount);
+  FlushInput(session);
   for (i = 0; i < amount; i++) {
-    g_player.experience++;
-    if (g_player.experience % EXP_PER_LEVEL == 0) {
-      LevelUp();
+    session->player.template->experience++;
+    if (session->player.template->experience % EXP_PER_LEVEL == 0) {
+      LevelUp(session);
       level_up_counter++;
     }
   }
@@ -2144,78 +1118,86 @@ int GainExperience(int amount) {
 
 Description: Increases the player's level and relevant stats.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: None.
 *******************************************************************************/
-void LevelUp(void) {
+void LevelUp(game_session_t *session) {
   int temp;
 
-  g_player.level++;
-  printf("%s has reached Level %d!\n", g_player.name, g_player.level);
-  FlushInput();
+  session->player.template->level++;
+  PrintFormatted(session, "%s has reached Level %d!\n",
+                 session->player.template->name,
+                 session->player.template->level);
+  FlushInput(session);
   temp = HP_LEVEL_UP_VALUE;
   if (temp > 0) {
-    g_player.max_hp += temp;
-    HealGameCharacter(&g_player, temp);
-    printf("Maximum hit points increased by %d.\n", temp);
+    session->player.max_hp += temp;
+    HealGameCharacter(session, &session->player, temp);
+    PrintFormatted(session, "Maximum hit points increased by %d.\n", temp);
   }
   temp = PHYSICAL_LEVEL_UP_VALUE;
   if (temp > 0) {
-    g_player.physical_power += temp;
-    printf("Physical power increased by %d.\n", temp);
+    session->player.physical_power += temp;
+    PrintFormatted(session, "Physical power increased by %d.\n", temp);
   }
   temp = PHYSICAL_LEVEL_UP_VALUE;
   if (temp > 0) {
-    g_player.physical_defense += temp;
-    printf("Physical defense increased by %d.\n", temp);
+    session->player.physical_defense += temp;
+    PrintFormatted(session, "Physical defense increased by %d.\n", temp);
   }
   temp = PHYSICAL_LEVEL_UP_VALUE;
   if (temp > 0) {
-    g_player.speed += temp;
-    printf("Speed increased by %d.\n", temp);
+    session->player.speed += temp;
+    PrintFormatted(session, "Speed increased by %d.\n", temp);
   }
   temp = MENTAL_LEVEL_UP_VALUE;
   if (temp > 0) {
-    g_player.mental_power += temp;
-    printf("Mental power increased by %d.\n", temp);
+    session->player.mental_power += temp;
+    PrintFormatted(session, "Mental power increased by %d.\n", temp);
   }
   temp = MENTAL_LEVEL_UP_VALUE;
   if (temp > 0) {
-    g_player.mental_defense += temp;
-    printf("Mental defense increased by %d.\n", temp);
+    session->player.mental_defense += temp;
+    PrintFormatted(session, "Mental defense increased by %d.\n", temp);
   }
-  FlushInput();
+  FlushInput(session);
 }
 
 /*******************************************************************************
    Function: LearnLanguage
 
-Description: Sets one of the player's languages to KNOWN.
+Description: Adds a language to those the player knows.
 
-     Inputs: language - Integer representing the language learned.
+     Inputs: session  - Pointer to the current game session.
+             language - Integer representing the language learned.
 
     Outputs: None.
 *******************************************************************************/
-void LearnLanguage(int language) {
-  g_player.languages[language] = KNOWN;
-  printf("%s has learned the %s  language!\n", g_player.name,
-         LanguageName(language));
-  FlushInput();
+void LearnLanguage(game_session_t *session, int language) {
+  session->player.template->known_languages |= LANGUAGE_BIT(language);
+  PrintFormatted(session, "%s has learned the %s  language!\n",
+                 session->player.template->name,
+                 LanguageName(session, language));
+  FlushInput(session);
 }
 
 /*******************************************************************************
    Function: LearnWord
 
-Description: Sets one of the player's Words of Power to KNOWN.
+Description: Adds a Word of Power to those the player knows.
 
-     Inputs: word - Integer representing the Word learned.
+     Inputs: session - Pointer to the current game session.
+             word    - Integer representing the Word learned.
 
     Outputs: None.
 *******************************************************************************/
-void LearnWord(int word) {
-  g_player.words[word] = KNOWN;
-  printf("%s has learned %s, the Word of %s!\n", g_player.name, GetWord(word),
-         GetWordName(word));
-  FlushInput();
+void LearnWord(game_session_t *session, int word) {
+  session->player.template->known_words |= WORD_BIT(word);
+  session->player.template->partially_known_words &= ~WORD_BIT(word);
+  PrintFormatted(session, "%s has learned %s, the Word of %s!\n",
+                 session->player.template->name,
+                 GetWord(session, word),
+                 GetWordName(session, word));
+  FlushInput(session);
 }
@@ -0,0 +1,195 @@
+/*******************************************************************************
+   Filename: check.c
+
+     Author: David C. Drake (https://davidcdrake.com)
+
+Description: Checks of the combat engine of the text-based RPG "Words of
+             Power," run by "make check" (as "wop-check") alongside the
+             simulator's own check. Each check plays out part of a battle in a
+             silent session and reports what it expected but did not find.
+*******************************************************************************/
+
+#include "wop.h"
+
+/*******************************************************************************
+   Function: main
+
+Description: Main function for "wop-check": runs every check and reports the
+             result.
+
+     Inputs: argc - Number of command-line arguments.
+             argv - The command-line arguments.
+
+    Outputs: Number of failed checks.
+*******************************************************************************/
+int main(int argc, char *argv[]) {
+  int failures = 0;
+
+  (void) argc;  // Takes no options.
+  failures += CheckEnemySummonActs(false);
+  failures += CheckEnemySummonActs(true);
+  failures += CheckEnemyStack();
+  printf("%s: %d check(s) failed.\n", argv[0], failures);
+
+  return failures;
+}
+
+/*******************************************************************************
+   Function: CheckEnemySummonActs
+
+Description: Checks that a creature summoned by an enemy is given turns on the
+             battle's timeline, on its summoner's side, and that it leaves the
+             battle along with its summoner.
+
+     Inputs: mid_battle - If true, the creature is summoned once the battle is
+                          under way; otherwise, before it begins.
+
+    Outputs: Number of failed checks (0 or 1).
+*******************************************************************************/
+int CheckEnemySummonActs(bool mid_battle) {
+  int round, turns = 0, hostile_turns = 0;
+  bool hostile;
+  io_backend_t *io = CreateRepeatingBackend(SIM_PLAYER_NAME);
+  game_session_t *session = CreateSession(CHECK_SEED, io);
+  game_character_t *enemy, *summoned_creature = NULL, *p_gc;
+
+  if (session == NULL) {
+    printf("ERROR: Unable to create game session.\n");
+    DestroyBackend(io);
+    return 1;
+  }
+  session->silent = true;
+  CreateWorld(session);
+  InitializeCharacter(session, &session->player, PLAYER,
+                      session->world[ILLARUM_SCHOOL]);
+  enemy = AddInhabitant(session, session->world[ILLARUM_SCHOOL], WOLF);
+  AddEnemy(session, enemy);
+  if (!mid_battle) {
+    summoned_creature = AddSummonedCreature(session, enemy, WOLF);
+  }
+  session->player.status[IN_COMBAT] = true;
+  StartInitiative(session);
+  if (mid_battle) {
+    summoned_creature = AddSummonedCreature(session, enemy, WOLF);
+  }
+
+  // Take every turn of a few rounds, counting the creature's:
+  for (round = 1; round <= 3; round++) {
+    while ((p_gc = NextCombatant(session, round * ROUND_TICKS,
+                                 &hostile)) != NULL) {
+      if (p_gc == summoned_creature) {
+        turns++;
+        hostile_turns += hostile;
+      }
+    }
+  }
+
+  // Once its summoner has fled, the creature should take no more turns:
+  RemoveEnemy(session, enemy);
+  while ((p_gc = NextCombatant(session, (round + 3) * ROUND_TICKS,
+                               &hostile)) != NULL) {
+    if (p_gc == summoned_creature) {
+      turns = -1;
+    }
+  }
+  session->player.status[IN_COMBAT] = false;
+  DestroySession(session);
+  DestroyBackend(io);
+
+  if (turns < 3 || hostile_turns != turns) {
+    printf("FAILED: A creature summoned by an enemy %s took %d turns "
+           "(%d as a foe) in three rounds.\n",
+           mid_battle ? "mid-battle" : "before battle", turns, hostile_turns);
+    return 1;
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+   Function: CheckEnemyStack
+
+Description: Checks that identical enemies fight as a single stack, which
+             keeps one character for all of them, loses its dead members, and
+             splits into individuals when its leader is afflicted by a status
+             or leaves the battle.
+
+     Inputs: None.
+
+    Outputs: Number of failed checks (0 or 1).
+*******************************************************************************/
+int CheckEnemyStack(void) {
+  int i, in_use, num_wolves = 0, failed_step = 0;
+  io_backend_t *io = CreateRepeatingBackend(SIM_PLAYER_NAME);
+  game_session_t *session = CreateSession(CHECK_SEED, io);
+  location_t *location;
+  game_character_t *leader, *heir, *p_gc;
+  string_builder_t report;
+
+  if (session == NULL) {
+    printf("ERROR: Unable to create game session.\n");
+    DestroyBackend(io);
+    return 1;
+  }
+  session->silent = true;
+  CreateWorld(session);
+  InitializeCharacter(session, &session->player, PLAYER,
+                      session->world[ILLARUM_SCHOOL]);
+  location = session->world[PLAINS_NORTH];
+  in_use = session->characters.num_in_use;
+  for (i = 0; i < 5; i++) {
+    AddEnemy(session, AddInhabitant(session, location, WOLF));
+  }
+
+  // Five wolves make one stack, led by the first of them:
+  leader = GetEnemy(session, 0);
+  StackEnemies(session);
+  if (NumberOfEnemies(session) != 1 || StackSize(leader) != 5 ||
+      session->characters.num_in_use != in_use + 1) {
+    failed_step = 1;
+  }
+
+  // A dead leader is replaced by a member:
+  leader->hp = 0;
+  InitStringBuilder(&report, &session->scratch);
+  if (failed_step == 0 &&
+      (RemoveDeadEnemies(session, &report) != 1 ||
+       NumberOfEnemies(session) != 1 || GetEnemy(session, 0) != leader ||
+       leader->hp != leader->max_hp || StackSize(leader) != 4 ||
+       session->num_kills[WOLF] != 1)) {
+    failed_step = 2;
+  }
+
+  // An afflicted leader leaves the stack to a member, who joins the battle:
+  ApplyStatus(session, leader, ASLEEP, 2);
+  heir = GetEnemy(session, NumberOfEnemies(session) - 1);
+  if (failed_step == 0 &&
+      (NumberOfEnemies(session) != 2 || heir == leader ||
+       StackSize(leader) != 1 || StackSize(heir) != 3 ||
+       heir->status[ASLEEP] || leader->status[ASLEEP] == false)) {
+    failed_step = 3;
+  }
+
+  // The members of a stack leaving the battle become inhabitants again:
+  RemoveEnemy(session, heir);
+  for (p_gc = GetCharacter(session, location->inhabitants);
+       p_gc != NULL;
+       p_gc = GetCharacter(session, p_gc->next)) {
+    num_wolves += p_gc->type == WOLF;
+  }
+  if (failed_step == 0 &&
+      (heir->stack != NULL || num_wolves != 4 ||
+       NumberOfEnemies(session) != 1)) {
+    failed_step = 4;
+  }
+  DestroySession(session);
+  DestroyBackend(io);
+
+  if (failed_step > 0) {
+    printf("FAILED: A stack of enemies misbehaved at step %d.\n",
+           failed_step);
+    return 1;
+  }
+
+  return 0;
+}
@@ -13,47 +13,58 @@ Description: Functions governing enemies and combat for the text-based RPG
    Function: AddEnemy
 
 Description: Given an already existing game character, adds a pointer to it in
-             the global "g_enemies" array.
+             the session's "enemies" array, growing the array as needed. If a
+             battle is in progress, the character's first turn is scheduled.
 
-     Inputs: p_gc - Pointer to the game character to be added.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character to be added.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int AddEnemy(game_character_t *p_gc) {
-  int i;
+int AddEnemy(game_session_t *session, game_character_t *p_gc) {
+  int new_capacity;
+  character_handle_t *new_enemies;
 
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
-
-  for (i = 0; i < MAX_ENEMIES; i++) {
-    if (g_enemies[i] == NULL) {
-      g_enemies[i] = p_gc;
-      p_gc->status[IN_COMBAT] = true;
-
-      return SUCCESS;
+  if (session->num_enemies == session->enemies_capacity) {
+    new_capacity = session->enemies_capacity > 0 ?
+                   session->enemies_capacity * 2 : ENEMY_ROSTER_CAPACITY;
+    new_enemies = realloc(session->enemies,
+                          new_capacity * sizeof(character_handle_t));
+    if (new_enemies == NULL) {
+      PRINT_ERROR_MESSAGE;
+      return FAILURE;
     }
+    session->enemies = new_enemies;
+    session->enemies_capacity = new_capacity;
   }
 
-  // If we reach this point, "g_enemies" was full and the add failed.
-  PRINT_ERROR_MESSAGE;
-  return FAILURE;
+  session->enemies[session->num_enemies++] = p_gc->handle;
+  p_gc->status[IN_COMBAT] = true;
+  if (session->player.status[IN_COMBAT]) {  // Joining a battle in progress.
+    return ScheduleCombatant(session, p_gc, true);
+  }
+
+  return SUCCESS;
 }
 
 /*******************************************************************************
    Function: AddRandomEnemy
 
 Description: Creates a new game character and adds a pointer to it in the local
-             "inhabitants" array as well as the the global "g_enemies" array,
+             "inhabitants" array as well as the session's "enemies" array,
              unless no random enemy is associated with the given location, in
              which case nothing happens.
 
-     Inputs: location - Pointer to the location in which to add a random enemy.
+     Inputs: session  - Pointer to the current game session.
+             location - Pointer to the location in which to add a random enemy.
 
     Outputs: SUCCESS if an enemy is added, otherwise FAILURE.
 *******************************************************************************/
-int AddRandomEnemy(location_t *location) {
+int AddRandomEnemy(game_session_t *session, location_t *location) {
   game_character_t *newEnemy = NULL;
 
   if (location == NULL) {
@@ -63,13 +74,13 @@ int AddRandomEnemy(location_t *location) {
 
   switch (location->id) {
     case ILLARUM_ENTRANCE:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case ILLARUM_MARKET:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case ILLARUM_INN:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case ILLARUM_SCHOOL:
       break;
@@ -80,13 +91,13 @@ int AddRandomEnemy(location_t *location) {
     case ILLARUM_PRISON:
       break;
     case VENTARRIS_ENTRANCE:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case VENTARRIS_MARKET:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case VENTARRIS_INN:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case VENTARRIS_SCHOOL:
       break;
@@ -97,37 +108,37 @@ int AddRandomEnemy(location_t *location) {
     case VENTARRIS_PRISON:
       break;
     case VENTARRIS_DOCKS:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case PLAINS_NORTH:
-      newEnemy = AddInhabitant(location, WOLF);
+      newEnemy = AddInhabitant(session, location, WOLF);
       break;
     case NORTHERN_FARMS:
       break;
     case BRILL_OUTSKIRTS:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case BRILL_MARKET:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case BRILL_INN:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case BRILL_DOCKS:
-      newEnemy = AddInhabitant(location, THIEF);
+      newEnemy = AddInhabitant(session, location, THIEF);
       break;
     case PLAINS_SOUTH:
-      newEnemy = AddInhabitant(location, WOLF);
+      newEnemy = AddInhabitant(session, location, WOLF);
       break;
     case SOUTHERN_FARMS:
       break;
     case SILENT_SAGE_HOME:
       break;
     case FOREST:
-      if (g_player.soul <= EVIL) {
-        newEnemy = AddInhabitant(location, ELF);
+      if (session->player.soul <= EVIL) {
+        newEnemy = AddInhabitant(session, location, ELF);
       } else {
-        newEnemy = AddInhabitant(location, BEAR);
+        newEnemy = AddInhabitant(session, location, BEAR);
       }
       break;
     case DRUIDS_GROVE:
@@ -135,101 +146,101 @@ int AddRandomEnemy(location_t *location) {
     case HERMIT_HUT:
       break;
     case WYNNFAER_ENTRANCE:
-      if (g_player.soul <= EVIL) {
-        newEnemy = AddInhabitant(location, ELF);
+      if (session->player.soul <= EVIL) {
+        newEnemy = AddInhabitant(session, location, ELF);
       }
       break;
     case WYNNFAER_PLAZA:
-      if (g_player.soul <= EVIL) {
-        newEnemy = AddInhabitant(location, ELF);
+      if (session->player.soul <= EVIL) {
+        newEnemy = AddInhabitant(session, location, ELF);
       }
       break;
     case WYNNFAER_PALACE:
-      if (g_player.soul <= EVIL) {
-        newEnemy = AddInhabitant(location, ELF);
+      if (session->player.soul <= EVIL) {
+        newEnemy = AddInhabitant(session, location, ELF);
       }
       break;
     case MOUNTAINS:
-      newEnemy = AddInhabitant(location, GOBLIN);
+      newEnemy = AddInhabitant(session, location, GOBLIN);
       break;
     case GESHTAL:
-      if (g_player.soul <= EVIL) {
-        newEnemy = AddInhabitant(location, BARBARIAN);
+      if (session->player.soul <= EVIL) {
+        newEnemy = AddInhabitant(session, location, BARBARIAN);
       }
       break;
     case TORR_ENTRANCE:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, DWARF);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, DWARF);
       }
       break;
     case TORR_MARKET:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, DWARF);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, DWARF);
       }
       break;
     case TORR_SCHOOL:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, DWARF);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, DWARF);
       }
       break;
     case TORR_TEMPLE:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, DWARF);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, DWARF);
       }
       break;
     case TORR_THRONE_ROOM:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, DWARF);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, DWARF);
       }
       break;
     case TORR_MINE:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, DWARF);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, DWARF);
       }
       break;
     case TORR_VAULT:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, DWARF);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, DWARF);
       }
       break;
     case TORR_PRISON:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, DWARF);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, DWARF);
       }
       break;
     case GUGGENHOLM_ENTRANCE:
-      newEnemy = AddInhabitant(location, GOBLIN);
+      newEnemy = AddInhabitant(session, location, GOBLIN);
       break;
     case GUGGENHOLM_MAIN:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, GNOME);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, GNOME);
       }
       break;
     case GUGGENHOLM_MINE:
-      if (g_player.soul <= VERY_EVIL) {
-        newEnemy = AddInhabitant(location, GNOME);
+      if (session->player.soul <= VERY_EVIL) {
+        newEnemy = AddInhabitant(session, location, GNOME);
       }
       break;
     case SWAMP:
-      newEnemy = AddInhabitant(location, ZOMBIE);
+      newEnemy = AddInhabitant(session, location, ZOMBIE);
       break;
     case NECROMANCERS_CIRCLE:
-      newEnemy = AddInhabitant(location, ZOMBIE);
+      newEnemy = AddInhabitant(session, location, ZOMBIE);
       break;
     case ISHTARR_ENTRANCE:
-      newEnemy = AddInhabitant(location, ZOMBIE);
+      newEnemy = AddInhabitant(session, location, ZOMBIE);
       break;
     case ISHTARR_EAST_WING:
-      newEnemy = AddInhabitant(location, ZOMBIE);
+      newEnemy = AddInhabitant(session, location, ZOMBIE);
       break;
     case ISHTARR_WEST_WING:
-      newEnemy = AddInhabitant(location, ZOMBIE);
+      newEnemy = AddInhabitant(session, location, ZOMBIE);
       break;
     case ISHTARR_CENTRAL_TOWER:
-      newEnemy = AddInhabitant(location, ZOMBIE);
+      newEnemy = AddInhabitant(session, location, ZOMBIE);
       break;
     case ISHTARR_DUNGEON:
-      newEnemy = AddInhabitant(location, ZOMBIE);
+      newEnemy = AddInhabitant(session, location, ZOMBIE);
       break;
     case SHORE_NE:
       break;
@@ -240,32 +251,32 @@ int AddRandomEnemy(location_t *location) {
     case OCEAN_SURFACE:
       break;
     case OCEAN_SHALLOW:
-      newEnemy = AddInhabitant(location, SHARK);
+      newEnemy = AddInhabitant(session, location, SHARK);
       break;
     case OCEAN_DEEP:
-      newEnemy = AddInhabitant(location, GIANT_SQUID);
+      newEnemy = AddInhabitant(session, location, GIANT_SQUID);
       break;
     case OCEAN_TRENCH:
-      newEnemy = AddInhabitant(location, GIANT_SQUID);
+      newEnemy = AddInhabitant(session, location, GIANT_SQUID);
       break;
     case QUELACENTUS_ENTRANCE:
-      newEnemy = AddInhabitant(location, MERFOLK_SOLDIER);
+      newEnemy = AddInhabitant(session, location, MERFOLK_SOLDIER);
       break;
     case QUELACENTUS_PLAZA:
-      newEnemy = AddInhabitant(location, MERFOLK_SOLDIER);
+      newEnemy = AddInhabitant(session, location, MERFOLK_SOLDIER);
       break;
     case QUELACENTUS_TEMPLE:
-      newEnemy = AddInhabitant(location, MERFOLK_SOLDIER);
+      newEnemy = AddInhabitant(session, location, MERFOLK_SOLDIER);
       break;
     case QUELACENTUS_PALACE:
-      newEnemy = AddInhabitant(location, MERFOLK_SOLDIER);
+      newEnemy = AddInhabitant(session, location, MERFOLK_SOLDIER);
       break;
     default:
       PRINT_ERROR_MESSAGE;
       break;
   }
   if (newEnemy != NULL) {
-    AddEnemy(newEnemy);
+    AddEnemy(session, newEnemy);
     return SUCCESS;
   }
 
@@ -275,16 +286,21 @@ int AddRandomEnemy(location_t *location) {
 /*******************************************************************************
    Function: RemoveEnemy
 
-Description: Removes a pointer to a given enemy from the global "g_enemies"
+Description: Removes a pointer to a given enemy from the session's "enemies"
              array (does NOT remove the enemy from the "world" or deallocate
-             associated memory).
+             associated memory). The last enemy takes the removed enemy's
+             place, so the order of the remaining enemies may change. If the
+             enemy leads a stack, the stack's members are split off as
+             individual inhabitants of the enemy's location.
 
-     Inputs: p_gc - Pointer to the game character to be removed.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character to be removed.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int RemoveEnemy(game_character_t *p_gc) {
-  int i, j;
+int RemoveEnemy(game_session_t *session, game_character_t *p_gc) {
+  int i;
+  game_character_t *summoned_creature;
 
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
@@ -292,16 +308,17 @@ int RemoveEnemy(game_character_t *p_gc) {
   }
 
   p_gc->status[IN_COMBAT] = false;
-  for (i = 0; i < MAX_ENEMIES; i++) {
-    if (g_enemies[i] == p_gc) {
-      g_enemies[i] = NULL;
-      // If any active pointers existed past "p_gc", shift them left:
-      for (j = i + 1;
-           j < MAX_ENEMIES && g_enemies[j] != NULL;
-           j++, i++) {
-        g_enemies[i] = g_enemies[j];
-        g_enemies[j] = NULL;
-      }
+  summoned_creature = GetCharacter(session, p_gc->summoned_creature);
+  if (summoned_creature != NULL) {
+    summoned_creature->status[IN_COMBAT] = false;  // Leaves with its summoner.
+  }
+  while (p_gc->stack != NULL) {
+    SplitFromStack(session, p_gc);
+  }
+  for (i = 0; i < session->num_enemies; i++) {
+    if (session->enemies[i] == p_gc->handle) {
+      session->num_enemies--;
+      session->enemies[i] = session->enemies[session->num_enemies];
       return SUCCESS;
     }
   }
@@ -314,17 +331,18 @@ int RemoveEnemy(game_character_t *p_gc) {
 /*******************************************************************************
    Function: DeleteEnemy
 
-Description: Removes a pointer to a given enemy from the global "g_enemies"
+Description: Removes a pointer to a given enemy from the session's "enemies"
              array, then removes the enemy from the "world" and deallocates
              associated memory.
 
-     Inputs: p_gc - Pointer to the game character to be removed.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character to be removed.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int DeleteEnemy(game_character_t *p_gc) {
-  if (RemoveEnemy(p_gc) == SUCCESS) {
-    DeleteInhabitant(g_world[p_gc->location], p_gc);
+int DeleteEnemy(game_session_t *session, game_character_t *p_gc) {
+  if (RemoveEnemy(session, p_gc) == SUCCESS) {
+    DeleteInhabitant(session, session->world[p_gc->location], p_gc);
   } else {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
@@ -336,40 +354,149 @@ int DeleteEnemy(game_character_t *p_gc) {
 /*******************************************************************************
    Function: NumberOfEnemies
 
-Description: Returns the number of enemies pointed to by "g_enemies".
+Description: Returns the number of enemies pointed to by "enemies".
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
-    Outputs: The number of active pointers in "g_enemies".
+    Outputs: The number of active pointers in "enemies".
 *******************************************************************************/
-int NumberOfEnemies(void) {
-  int i;
+int NumberOfEnemies(game_session_t *session) {
+  return session->num_enemies;
+}
+
+/*******************************************************************************
+   Function: RemoveDeadEnemies
+
+Description: Deletes every enemy whose HP has run out, in a single pass that
+             closes the gaps in "enemies" while keeping the survivors in order.
+             (Enemies that no longer exist are simply dropped.) The dead
+             members of stacks are swept as well (see "SweepStack").
 
-  for (i = 0; i < MAX_ENEMIES && g_enemies[i] != NULL; i++)
-    ;
+     Inputs: session - Pointer to the current game session.
+             report  - String builder to which a line announcing each death is
+                       appended (nothing is appended in silent mode).
 
-  return i;
+    Outputs: The number of enemies killed.
+*******************************************************************************/
+int RemoveDeadEnemies(game_session_t *session, string_builder_t *report) {
+  int i, num_survivors = 0, num_killed = 0;
+  game_character_t *p_gc;
+
+  for (i = 0; i < session->num_enemies; i++) {
+    p_gc = GetEnemy(session, i);
+    if (p_gc != NULL && p_gc->stack != NULL) {
+      num_killed += SweepStack(session, p_gc, report);
+    }
+    if (p_gc != NULL && p_gc->hp > 0) {
+      session->enemies[num_survivors++] = session->enemies[i];
+    } else if (p_gc != NULL) {
+      if (!session->silent) {
+        AppendString(report, Capitalize(GetNameDefinite(session, p_gc)));
+        if (p_gc->status[INANIMATE]) {
+          AppendString(report, " has been destroyed.\n");
+        } else {
+          AppendString(report, " is dead.\n");
+        }
+      }
+      session->num_kills[p_gc->type]++;
+      p_gc->status[IN_COMBAT] = false;
+      DeleteInhabitant(session, session->world[p_gc->location], p_gc);
+      num_killed++;
+    }
+  }
+  session->num_enemies = num_survivors;
+
+  return num_killed;
+}
+
+/*******************************************************************************
+   Function: SweepStack
+
+Description: Removes a stack's dead members from its "hp" array. If the stack's
+             leader is dead, a living member takes its place (i.e., the
+             leader's record, along with its place in the battle, is given the
+             member's HP), so a stack's leader only dies with the last member.
+
+     Inputs: session - Pointer to the current game session.
+             leader  - Pointer to the enemy leading the stack.
+             report  - String builder to which a line announcing the deaths
+                       is appended (nothing is appended in silent mode).
+
+    Outputs: The number of members killed, including any leader replaced.
+*******************************************************************************/
+int SweepStack(game_session_t *session, game_character_t *leader,
+               string_builder_t *report) {
+  int i, num_survivors = 0, num_killed;
+  enemy_stack_t *stack = leader->stack;
+
+  for (i = 0; i < stack->count; i++) {
+    if (stack->hp[i] > 0) {
+      stack->hp[num_survivors++] = stack->hp[i];
+    }
+  }
+  num_killed = stack->count - num_survivors;
+  if (leader->hp <= 0 && num_survivors > 0) {
+    leader->hp = stack->hp[--num_survivors];
+    num_killed++;
+  }
+  stack->count = num_survivors;
+  if (num_killed > 0 && !session->silent) {
+    if (num_killed == 1) {
+      AppendString(report, Capitalize(GetNameDefinite(session, leader)));
+    } else {
+      AppendInt(report, num_killed);
+      AppendChar(report, ' ');
+      AppendString(report, GetNamePlural(session, leader));
+    }
+    if (leader->status[INANIMATE]) {
+      AppendString(report, num_killed == 1 ? " has been destroyed.\n" :
+                                             " have been destroyed.\n");
+    } else {
+      AppendString(report, num_killed == 1 ? " is dead.\n" : " are dead.\n");
+    }
+  }
+  session->num_kills[leader->type] += num_killed;
+  if (stack->count == 0) {
+    DiscardStack(leader);
+  }
+
+  return num_killed;
+}
+
+/*******************************************************************************
+   Function: GetEnemy
+
+Description: Returns a pointer to one of the enemies listed in "enemies".
+
+     Inputs: session - Pointer to the current game session.
+             index   - Index of the enemy of interest within "enemies".
+
+    Outputs: Pointer to the enemy (or NULL if no such enemy exists).
+*******************************************************************************/
+game_character_t *GetEnemy(game_session_t *session, int index) {
+  return GetCharacter(session, session->enemies[index]);
 }
 
 /*******************************************************************************
    Function: VisibleEnemies
 
-Description: Returns the number of visible enemies.
+Description: Returns the number of visible enemies, counting every member of
+             each stack.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: The number of visible enemies.
 *******************************************************************************/
-int VisibleEnemies(void) {
+int VisibleEnemies(game_session_t *session) {
   int i, count = 0;
 
-  if (g_player.status[IN_COMBAT] == false) {
+  if (session->player.status[IN_COMBAT] == false) {
     PRINT_ERROR_MESSAGE;
     return count;
   } else {
-    for (i = 0; i < MAX_ENEMIES && g_enemies[i] != NULL; i++) {
-      if (g_enemies[i]->status[INVISIBLE] == false) {
-        count++;
+    for (i = 0; i < session->num_enemies; i++) {
+      if (GetEnemy(session, i)->status[INVISIBLE] == false) {
+        count += StackSize(GetEnemy(session, i));
       }
     }
   }
@@ -381,131 +508,642 @@ int VisibleEnemies(void) {
    Function: Combat
 
 Description: Handles combat situations by displaying relevant information,
-             presenting options, etc.
+             presenting options, etc. Within each round, every combatant acts
+             whenever its turn comes up on the battle's timeline, so faster
+             combatants act sooner and more often (see "NextCombatant").
+             Identical generic enemies are first gathered into stacks, each of
+             which takes its turns as one (see "StackEnemies").
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: Returns the number of enemies remaining (usually 0).
 *******************************************************************************/
-int Combat(void) {
-  int i, round = 1;
-  char input;
-  bool repeat_options, playerFirst;
+int Combat(game_session_t *session) {
+  int round = 1;
+  bool hostile;
   game_character_t *p_gc;
+  string_builder_t report;
+  arena_mark_t mark;
 
-  if (NumberOfEnemies() == 0) {
+  if (NumberOfEnemies(session) == 0) {
     PRINT_ERROR_MESSAGE;
     return 0;
   }
 
-  g_player.status[IN_COMBAT] = true;
-  playerFirst = RandomBool();  // Determine who gets the first round.
+  session->player.status[IN_COMBAT] = true;
+  StackEnemies(session);
+  StartInitiative(session);  // Determine who acts when.
 
   do {
-    printf("  ___________\n_/ENEMY STATS\\_____________________________________"
-           "____________________________\n");
-    for (i = 0; i < MAX_ENEMIES; i++) {
-      if (g_enemies[i] == NULL) {
+    PrintFormatted(session,
+                   "  ___________\n_/ENEMY STATS\\_____________________________"
+                   "____________________________________\n");
+    PrintEnemyStats(session);
+    PrintFormatted(session,
+                   "  ____________\n_/PLAYER STATS\\___________________________"
+                   "_____________________________________\n");
+    for (p_gc = &session->player;
+         p_gc != NULL;
+         p_gc = GetCharacter(session, p_gc->next)) {
+      PrintCombatStatus(session, p_gc);
+    }
+    if (session->player.summoned_creature != NO_CHARACTER) {
+      PrintCombatStatus(session,
+                        GetCharacter(session,
+                                     session->player.summoned_creature));
+    }
+    PrintFormatted(session, "\n");
+
+    // Each combatant whose turn falls within this round acts, in turn order:
+    while ((p_gc = NextCombatant(session, round * ROUND_TICKS,
+                                 &hostile)) != NULL) {
+      if (p_gc == &session->player) {
+        // Enemies killed since the player's last turn (e.g., by an ally) are
+        // cleared away first, so only the living are offered as targets:
+        mark = ArenaMark(&session->scratch);
+        InitStringBuilder(&report, &session->scratch);
+        if (RemoveDeadEnemies(session, &report) > 0) {
+          PrintString(session, report.data);
+        }
+        ArenaRelease(&session->scratch, mark);
+        if (NumberOfEnemies(session) == 0) {
+          break;
+        }
+        if (HandleCombatMenuInput(session) == FAILURE ||
+            CheckStatus(session) == false) {
+          break;  // The player has fled, quit or fallen.
+        }
+      } else if (hostile) {
+        EnemyAI(session, p_gc);
+      } else {
+        AllyAI(session, p_gc);
+      }
+      if (NumberOfEnemies(session) == 0 || session->player.hp <= 0 ||
+          GameInterrupted(session)) {
         break;
       }
-      PrintCombatStatus(g_enemies[i]);
-      if (g_enemies[i]->summoned_creature != NULL) {
-        printf("%s's summoned creature: ", g_enemies[i]->name);
-        PrintCombatStatus(g_enemies[i]->summoned_creature);
-      }
-    }
-    printf("  ____________\n_/PLAYER STATS\\___________________________________"
-           "_____________________________\n");
-    for (p_gc = &g_player; p_gc != NULL; p_gc = p_gc->next) {
-      PrintCombatStatus(p_gc);
-    }
-    if (g_player.summoned_creature != NULL) {
-      PrintCombatStatus(g_player.summoned_creature);
-    }
-    printf("\n");
-
-    if (round > 1 || playerFirst) {  // Check initiative only on 1st round.
-        /* --PLAYER'S TURN-- */
-      do {
-        repeat_options = false;
-        printf("Choose an action:\n"
-               "[A]ttack\n"
-               "[C]ast a Spell\n"
-               "[U]se an Item\n"
-               "[F]lee\n"
-               "[Q]uit (Return to Main Menu)\n");
-        GetCharInput(&input);
-        switch (input) {
-          case 'A':  // Attack
-            if (HandleAttackMenuInput() == FAILURE) {
-              repeat_options = true;
-            }
-            break;
-          case 'C':  // Cast a Spell
-            if (HandleSpellMenuInput() == FAILURE) {
-              repeat_options = true;
-            }
-            break;
-          case 'U':  // Use an Item
-            if (HandleItemMenuInput() == FAILURE) {
-              repeat_options = true;
-            }
-            break;
-          case 'F':  // Flee
-            if (g_enemies[0]->type == DUMMY) {  // Indicates tutorial mode.
-              printf("%s: \"Come on, destroy the dummy already!\"\n",
-                     FindInhabitant(ARCHWIZARD_OF_ELEMENTS)->name);
-              FlushInput();
-              repeat_options = true;
-            } else if (RandomInt(1, 3) == 1) {
-              printf("You have successfully fled.\n");
-              FlushInput();
-              while (NumberOfEnemies() > 0) {
-                RemoveEnemy(g_enemies[0]);
-              }
-              g_player.status[IN_COMBAT] = false;
-              HandleMovementMenuInput();
-            } else {
-              printf("Your attempt to escape has failed.\n");
-              FlushInput();
-            }
-            break;
-          case 'Q':  // Quit
-            if (GetExitConfirmation()) {
-              return 0;
-            } else {
-              repeat_options = true;
-            }
-            break;
-          default:
-            printf("Invalid response.\n\n");
-            repeat_options = true;
-            break;
+    }
+    PrintFormatted(session, "\n");
+    TickStatusEffects(session);
+    round++;
+  }while (CheckStatus(session) && NumberOfEnemies(session) > 0 &&
+           !GameInterrupted(session));
+  session->player.status[IN_COMBAT] = false;
+
+  return NumberOfEnemies(session);
+}
+
+/*******************************************************************************
+   Function: HandleCombatMenuInput
+
+Description: Handles the player's turn in combat, presenting the combat menu
+             (unless the player is unable to act or is being played by a
+             "player_policy_t").
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: FAILURE if the player has left combat (by fleeing or quitting),
+             otherwise SUCCESS.
+*******************************************************************************/
+int HandleCombatMenuInput(game_session_t *session) {
+  char input;
+  bool repeat_options;
+
+  do {
+    repeat_options = false;
+    if (CanAct(&session->player) == false) {
+      PrintFormatted(session, "You are unable to act!\n\n");
+      FlushInput(session);
+      return SUCCESS;
+    }
+    if (session->policy != NULL) {  // Scripted player (see "sim.c").
+      session->policy->take_turn(session, session->policy);
+      return SUCCESS;
+    }
+    PrintFormatted(session,
+                   "Choose an action:\n"
+                   "[A]ttack\n"
+                   "[C]ast a Spell\n"
+                   "[U]se an Item\n"
+                   "[F]lee\n"
+                   "[Q]uit (Return to Main Menu)\n");
+    GetCharInput(session, &input);
+    switch (input) {
+      case 'A':  // Attack
+        if (HandleAttackMenuInput(session) == FAILURE) {
+          repeat_options = true;
+        }
+        break;
+      case 'C':  // Cast a Spell
+        if (HandleSpellMenuInput(session) == FAILURE) {
+          repeat_options = true;
+        }
+        break;
+      case 'U':  // Use an Item
+        if (HandleItemMenuInput(session) == FAILURE) {
+          repeat_options = true;
         }
-      }while (repeat_options);
+        break;
+      case 'F':  // Flee
+        if (GetEnemy(session, 0)->type == DUMMY) {  // Tutorial mode.
+          PrintFormatted(session,
+                         "%s: \"Come on, destroy the dummy already!\"\n",
+                         FindInhabitant(
+                             session,
+                             ARCHWIZARD_OF_ELEMENTS)->template->name);
+          FlushInput(session);
+          repeat_options = true;
+        } else if (RandomInt(session, 1, 3) == 1) {
+          PrintFormatted(session, "You have successfully fled.\n");
+          FlushInput(session);
+          while (NumberOfEnemies(session) > 0) {
+            RemoveEnemy(session, GetEnemy(session, 0));
+          }
+          session->player.status[IN_COMBAT] = false;
+          HandleMovementMenuInput(session);
+        } else {
+          PrintFormatted(session, "Your attempt to escape has failed.\n");
+          FlushInput(session);
+        }
+        break;
+      case 'Q':  // Quit
+        if (GetExitConfirmation(session)) {
+          return FAILURE;
+        } else {
+          repeat_options = true;
+        }
+        break;
+      default:
+        PrintFormatted(session, "Invalid response.\n\n");
+        repeat_options = true;
+        break;
+    }
+  }while (repeat_options && !GameInterrupted(session));
+
+  if (session->player.status[IN_COMBAT] == false) {
+    return FAILURE;  // The player has fled.
+  }
+
+  return SUCCESS;
+}
 
-      // Increment "round" here if the NPCs had the initiative:
-      if (!playerFirst) {
-        round++;
+/*******************************************************************************
+   Function: StartInitiative
+
+Description: Schedules the first turn of every combatant: the player, the
+             player's companions, the enemies, and any creatures summoned by
+             them. Each first turn falls at random within the combatant's
+             first delay (see "TurnDelay"), so faster combatants tend to act
+             first.
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: None.
+*******************************************************************************/
+void StartInitiative(game_session_t *session) {
+  int i;
+  game_character_t *p_gc;
+
+  session->initiative.num_turns = 0;
+  session->initiative.now = 0;
+  session->initiative.next_order = 0;
+  for (p_gc = &session->player;
+       p_gc != NULL;
+       p_gc = GetCharacter(session, p_gc->next)) {
+    ScheduleCombatant(session, p_gc, false);
+    ScheduleCombatant(session, GetCharacter(session, p_gc->summoned_creature),
+                      false);
+  }
+  for (i = 0; i < NumberOfEnemies(session); i++) {
+    p_gc = GetEnemy(session, i);
+    ScheduleCombatant(session, p_gc, true);
+    p_gc = GetCharacter(session, p_gc->summoned_creature);
+    if (p_gc != NULL) {
+      p_gc->status[IN_COMBAT] = true;  // Fights as long as its summoner does.
+      ScheduleCombatant(session, p_gc, true);
+    }
+  }
+}
+
+/*******************************************************************************
+   Function: ScheduleCombatant
+
+Description: Schedules the first turn of a combatant joining the current
+             battle, at random within the combatant's first delay from now.
+
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the joining combatant (if NULL, nothing
+                       happens).
+             hostile - True if the combatant is one of the player's foes.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int ScheduleCombatant(game_session_t *session, game_character_t *p_gc,
+                      bool hostile) {
+  if (p_gc == NULL) {
+    return SUCCESS;
+  }
+
+  return ScheduleTurn(session, p_gc,
+                      session->initiative.now +
+                        RandomInt(session, 0, TurnDelay(p_gc) - 1),
+                      hostile);
+}
+
+/*******************************************************************************
+   Function: ScheduleTurn
+
+Description: Adds a turn to the battle's schedule in O(log n) time, growing the
+             schedule as needed.
+
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the combatant taking the turn.
+             tick    - When the turn is to be taken, on the battle's timeline.
+             hostile - True if the combatant is one of the player's foes.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int ScheduleTurn(game_session_t *session, game_character_t *p_gc, int tick,
+                 bool hostile) {
+  int i, parent, new_capacity;
+  turn_t turn, *new_turns;
+  initiative_t *initiative = &session->initiative;
+
+  if (initiative->num_turns == initiative->capacity) {
+    new_capacity = initiative->capacity > 0 ? initiative->capacity * 2 :
+                                              INITIATIVE_CAPACITY;
+    new_turns = realloc(initiative->turns, new_capacity * sizeof(turn_t));
+    if (new_turns == NULL) {
+      PRINT_ERROR_MESSAGE;
+      return FAILURE;
+    }
+    initiative->turns = new_turns;
+    initiative->capacity = new_capacity;
+  }
+  turn.tick = tick;
+  turn.order = initiative->next_order++;
+  turn.combatant = p_gc->handle;
+  turn.hostile = hostile;
+
+  // Move parents down until the new turn's place is found (turns scheduled
+  // later never precede those of the same tick scheduled earlier):
+  for (i = initiative->num_turns; i > 0; i = parent) {
+    parent = (i - 1) / 2;
+    if (initiative->turns[parent].tick <= tick) {
+      break;
+    }
+    initiative->turns[i] = initiative->turns[parent];
+  }
+  initiative->turns[i] = turn;
+  initiative->num_turns++;
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: NextCombatant
+
+Description: Takes the earliest turn from the battle's schedule in O(log n)
+             time and schedules the combatant's next one (see "TurnDelay").
+             Turns of combatants who have since died or left the battle are
+             discarded as they come up, so nothing needs to be removed from the
+             schedule when a combatant does. (The player's foes, including
+             creatures they summon, are in the battle while "IN_COMBAT.")
+
+     Inputs: session  - Pointer to the current game session.
+             end_tick - Only turns before this tick (e.g., the end of the
+                        current round) are taken.
+             hostile  - Set to true if the combatant is one of the player's
+                        foes.
+
+    Outputs: Pointer to the combatant whose turn it is, or NULL if no turn
+             remains before "end_tick."
+*******************************************************************************/
+game_character_t *NextCombatant(game_session_t *session, int end_tick,
+                                bool *hostile) {
+  int i, child;
+  turn_t turn, last;
+  initiative_t *initiative = &session->initiative;
+  game_character_t *p_gc;
+
+  while (initiative->num_turns > 0 && initiative->turns[0].tick < end_tick) {
+    turn = initiative->turns[0];
+
+    // Move the last turn to the root, then down until its place is found:
+    last = initiative->turns[--initiative->num_turns];
+    for (i = 0; (child = 2 * i + 1) < initiative->num_turns; i = child) {
+      if (child + 1 < initiative->num_turns &&
+          (initiative->turns[child + 1].tick < initiative->turns[child].tick ||
+           (initiative->turns[child + 1].tick ==
+              initiative->turns[child].tick &&
+            initiative->turns[child + 1].order <
+              initiative->turns[child].order))) {
+        child++;
+      }
+      if (last.tick < initiative->turns[child].tick ||
+          (last.tick == initiative->turns[child].tick &&
+           last.order < initiative->turns[child].order)) {
+        break;
+      }
+      initiative->turns[i] = initiative->turns[child];
+    }
+    initiative->turns[i] = last;
+
+    p_gc = GetCharacter(session, turn.combatant);
+    if (p_gc == NULL || p_gc->hp <= 0 ||
+        (turn.hostile && p_gc->status[IN_COMBAT] == false)) {
+      continue;  // Dead or no longer fighting.
+    }
+    initiative->now = turn.tick;
+    ScheduleTurn(session, p_gc, turn.tick + TurnDelay(p_gc), turn.hostile);
+    *hostile = turn.hostile;
+
+    return p_gc;
+  }
+
+  return NULL;
+}
+
+/*******************************************************************************
+   Function: TurnDelay
+
+Description: Determines how long a combatant waits between turns: one round
+             (ROUND_TICKS) at DEFAULT_SPEED, half that at twice the speed, etc.
+
+     Inputs: p_gc - Pointer to the combatant of interest.
+
+    Outputs: Number of ticks between the combatant's turns.
+*******************************************************************************/
+int TurnDelay(game_character_t *p_gc) {
+  return ROUND_TICKS * DEFAULT_SPEED / (p_gc->speed > 0 ? p_gc->speed : 1);
+}
+
+/*******************************************************************************
+   Function: PrintEnemyStats
+
+Description: Prints combat-relevant information about the session's enemies.
+             Each stack (see "StackEnemies") takes a single line, with a count,
+             so that even a battle against a horde of prisoners or wolves takes
+             only a few lines.
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: None.
+*******************************************************************************/
+void PrintEnemyStats(game_session_t *session) {
+  int i, j, low, high;
+  enemy_stack_t *stack;
+  game_character_t *p_gc;
+
+  if (session->silent) {
+    return;  // Nothing would be printed anyway.
+  }
+  for (i = 0; i < session->num_enemies; i++) {
+    p_gc = GetEnemy(session, i);
+    stack = p_gc->stack;
+    if (stack != NULL) {
+      low = high = p_gc->hp;
+      for (j = 0; j < stack->count; j++) {
+        low = stack->hp[j] < low ? stack->hp[j] : low;
+        high = stack->hp[j] > high ? stack->hp[j] : high;
       }
+      if (low == high) {
+        PrintFormatted(session, "%s x%d (%d/%d each)\n", p_gc->template->name,
+                       StackSize(p_gc), high, p_gc->max_hp);
+      } else {
+        PrintFormatted(session, "%s x%d (%d-%d/%d)\n", p_gc->template->name,
+                       StackSize(p_gc), low, high, p_gc->max_hp);
+      }
+      continue;
+    }
+    PrintCombatStatus(session, p_gc);
+    if (p_gc->summoned_creature != NO_CHARACTER) {
+      PrintFormatted(session, "%s's summoned creature: ",
+                     p_gc->template->name);
+      PrintCombatStatus(session,
+                        GetCharacter(session, p_gc->summoned_creature));
     }
+  }
+}
+
+/*******************************************************************************
+   Function: StackEnemies
 
-      /* -- ENEMY'S TURN-- */
-    if (CheckStatus()) {
-      for (i = 0; i < NumberOfEnemies(); i++) {
-        EnemyAI(i);
+Description: Gathers identical generic enemies (see "Stackable") into stacks,
+             in a single pass over "enemies" that keeps each stack's leader
+             where the first of its members was. Every other member is kept
+             only as an entry in its leader's "hp" array: its own record is
+             deleted, so it no longer takes up a character slot, a place in
+             the turn schedule, etc.
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: None.
+*******************************************************************************/
+void StackEnemies(game_session_t *session) {
+  int i, j, num_kept = 0;
+  game_character_t *p_gc;
+
+  for (i = 0; i < session->num_enemies; i++) {
+    p_gc = GetEnemy(session, i);
+    if (p_gc == NULL) {
+      continue;  // No longer exists.
+    }
+    for (j = num_kept - 1; j >= 0; j--) {  // Most likely the latest stack.
+      if (Stackable(GetEnemy(session, j), p_gc)) {
+        break;
       }
-      printf("\n");
     }
+    if (j >= 0) {
+      JoinStack(session, GetEnemy(session, j), p_gc);
+    } else {
+      session->enemies[num_kept++] = session->enemies[i];
+    }
+  }
+  session->num_enemies = num_kept;
+}
+
+/*******************************************************************************
+   Function: Stackable
 
-    // Increment "round" here if the player had the initiative:
-    if (playerFirst) {
-      round++;
+Description: Determines whether two game characters may fight as a single
+             stack, i.e., whether both are generic NPCs of the same kind whose
+             state is identical but for their HP (which a stack keeps for
+             each member). Spellcasters, summoners, the afflicted by timed
+             statuses and the owners of items are never stacked, since they
+             need a record of their own.
+
+     Inputs: p_gc  - Pointer to a game character.
+             other - Pointer to another game character.
+
+    Outputs: true if the two characters may be stacked.
+*******************************************************************************/
+bool Stackable(game_character_t *p_gc, game_character_t *other) {
+  int i;
+
+  for (i = FIRST_TIMED_STATUS; i < FIRST_TIMED_STATUS + NUM_TIMED_STATUSES;
+       i++) {
+    if (p_gc->status[i] || other->status[i]) {
+      return false;
     }
-  }while (CheckStatus() && NumberOfEnemies() > 0);
-  g_player.status[IN_COMBAT] = false;
+  }
 
-  return NumberOfEnemies();
+  return p_gc != other &&
+         p_gc->template == other->template &&
+         p_gc->template->unique == false &&
+         IsSpellcaster(p_gc) == false &&
+         p_gc->type == other->type &&
+         p_gc->max_hp == other->max_hp &&
+         p_gc->physical_power == other->physical_power &&
+         p_gc->physical_defense == other->physical_defense &&
+         p_gc->speed == other->speed &&
+         p_gc->mental_power == other->mental_power &&
+         p_gc->mental_defense == other->mental_defense &&
+         p_gc->soul == other->soul &&
+         p_gc->relationship == other->relationship &&
+         p_gc->location == other->location &&
+         memcmp(p_gc->status, other->status, sizeof(p_gc->status)) == 0 &&
+         p_gc->summoned_creature == NO_CHARACTER &&
+         other->summoned_creature == NO_CHARACTER &&
+         p_gc->details->conversations == other->details->conversations &&
+         p_gc->details->knows_player == other->details->knows_player &&
+         p_gc->details->known_to_player == other->details->known_to_player &&
+         p_gc->details->gold == other->details->gold &&
+         p_gc->details->inventory.count == 0 &&
+         other->details->inventory.count == 0;
+}
+
+/*******************************************************************************
+   Function: JoinStack
+
+Description: Adds a game character to an enemy's stack (creating the stack if
+             need be), then deletes the character: only its HP is kept. Any
+             members of the character's own stack join as well. The caller is
+             responsible for the character's entry in "enemies," if any.
+
+     Inputs: session - Pointer to the current game session.
+             leader  - Pointer to the enemy leading the stack.
+             p_gc    - Pointer to the joining game character, which must be
+                       stackable with the leader (see "Stackable").
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int JoinStack(game_session_t *session, game_character_t *leader,
+              game_character_t *p_gc) {
+  int i, new_capacity, *new_hp;
+  enemy_stack_t *stack = leader->stack;
+
+  if (stack == NULL) {
+    stack = calloc(1, sizeof(enemy_stack_t));
+    if (stack == NULL) {
+      PRINT_ERROR_MESSAGE;
+      return FAILURE;
+    }
+    leader->stack = stack;
+  }
+  if (stack->count + StackSize(p_gc) > stack->capacity) {
+    new_capacity = stack->capacity > 0 ? stack->capacity : STACK_CAPACITY;
+    while (new_capacity < stack->count + StackSize(p_gc)) {
+      new_capacity *= 2;
+    }
+    new_hp = realloc(stack->hp, new_capacity * sizeof(int));
+    if (new_hp == NULL) {
+      PRINT_ERROR_MESSAGE;
+      return FAILURE;
+    }
+    stack->hp = new_hp;
+    stack->capacity = new_capacity;
+  }
+  stack->hp[stack->count++] = p_gc->hp;
+  if (p_gc->stack != NULL) {
+    for (i = 0; i < p_gc->stack->count; i++) {
+      stack->hp[stack->count++] = p_gc->stack->hp[i];
+    }
+    DiscardStack(p_gc);
+  }
+  p_gc->status[IN_COMBAT] = false;
+
+  return DeleteInhabitant(session, session->world[p_gc->location], p_gc);
+}
+
+/*******************************************************************************
+   Function: SplitFromStack
+
+Description: Turns the last member of an enemy's stack back into a game
+             character of its own: an inhabitant of the leader's location,
+             identical to the leader but for its HP (and not in the session's
+             "enemies" array). A stack left without members is discarded.
+
+     Inputs: session - Pointer to the current game session.
+             leader  - Pointer to the enemy leading the stack.
+
+    Outputs: Pointer to the new game character (or NULL if there was none).
+*******************************************************************************/
+game_character_t *SplitFromStack(game_session_t *session,
+                                 game_character_t *leader) {
+  character_handle_t handle;
+  character_details_t *details;
+  game_character_t *member;
+  enemy_stack_t *stack = leader->stack;
+
+  if (stack == NULL || stack->count == 0) {
+    PRINT_ERROR_MESSAGE;
+    return NULL;
+  }
+  member = AllocateCharacter(session);
+  if (member == NULL) {
+    PRINT_ERROR_MESSAGE;
+    exit(1);
+  }
+  handle = member->handle;
+  details = member->details;
+  *member = *leader;
+  *details = *leader->details;
+  details->inventory.overflow = NULL;  // Empty (see "Stackable").
+  details->inventory.overflow_capacity = 0;
+  member->handle = handle;
+  member->details = details;
+  member->hp = stack->hp[--stack->count];
+  member->stack = NULL;
+  member->next = member->previous = NO_CHARACTER;
+  member->next_fighter = member->previous_fighter = NO_CHARACTER;
+  LinkInhabitant(session, session->world[leader->location], member);
+  if (stack->count == 0) {
+    DiscardStack(leader);
+  }
+
+  return member;
+}
+
+/*******************************************************************************
+   Function: DiscardStack
+
+Description: Frees an enemy's stack, along with any members left in it.
+
+     Inputs: leader - Pointer to the enemy leading the stack.
+
+    Outputs: None.
+*******************************************************************************/
+void DiscardStack(game_character_t *leader) {
+  if (leader->stack != NULL) {
+    free(leader->stack->hp);
+    free(leader->stack);
+    leader->stack = NULL;
+  }
+}
+
+/*******************************************************************************
+   Function: StackSize
+
+Description: Returns the number of characters a game character stands for: one,
+             plus the members of any stack it leads.
+
+     Inputs: p_gc - Pointer to the game character of interest.
+
+    Outputs: The number of characters represented.
+*******************************************************************************/
+int StackSize(game_character_t *p_gc) {
+  return 1 + (p_gc->stack != NULL ? p_gc->stack->count : 0);
 }
 
 /*******************************************************************************
@@ -513,235 +1151,528 @@ int Combat(void) {
 
 Description: Prints combat-relevant information about a given game character.
 
-     Inputs: p_gc - Pointer to the game character of interest.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character of interest.
 
     Outputs: None.
 *******************************************************************************/
-void PrintCombatStatus(game_character_t *p_gc) {
+void PrintCombatStatus(game_session_t *session, game_character_t *p_gc) {
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return;
   }
 
-  printf("%s (%d/%d", p_gc->name, p_gc->hp, p_gc->max_hp);
+  PrintFormatted(session, "%s (%d/%d", p_gc->template->name, p_gc->hp,
+                 p_gc->max_hp);
   // Code for printing status will go here.
-  printf(")\n");
+  PrintFormatted(session, ")\n");
 }
 
 /*******************************************************************************
    Function: EnemyAI
 
-Description: Handles enemy NPC decision-making during combat.
+Description: Handles enemy NPC decision-making during combat. Every member of
+             a stack attacks at once (see "StackAttack").
 
-     Inputs: index - Index value of the active enemy in the "g_enemies" array.
+     Inputs: session - Pointer to the current game session.
+             enemy   - Pointer to the enemy whose turn it is.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int EnemyAI(int index) {
+int EnemyAI(game_session_t *session, game_character_t *enemy) {
   int i;
+  uint32_t words;
   bool actionPerformed = false;
-  game_character_t *targets[MAX_TARGETS] = {NULL};
+  character_handle_t targets[2] = {NO_CHARACTER, NO_CHARACTER};  // One each.
 
-  if (g_enemies[index] == NULL) {
+  if (enemy == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  if (g_enemies[index]->status[INANIMATE] == true) {
+  if (enemy->status[INANIMATE] == true || CanAct(enemy) == false) {
     return SUCCESS;
-  } else if (IsSpellcaster(g_enemies[index])) {
-    if (RandomInt(1, 10) > 1) {  // 90% chance of casting a spell.
-      for (i = 0; i < NumberOfEnemies(); i++) {
-        if (g_enemies[i]->hp <= (g_enemies[i]->max_hp / 4) &&
-            g_enemies[i]->words[WORD_OF_HEALTH] == KNOWN) {
-          targets[0] = g_enemies[i];
-          CastSpell(g_enemies[index], "Y", targets);  // Healing spell.
+  } else if (enemy->stack != NULL) {  // Never spellcasters (see "Stackable").
+    return StackAttack(session, enemy, &session->player);
+  } else if (IsSpellcaster(enemy)) {
+    words = enemy->template->known_words;
+    if (RandomInt(session, 1, 10) > 1) {  // 90% chance of casting a spell.
+      for (i = 0; i < NumberOfEnemies(session); i++) {
+        if (GetEnemy(session, i)->hp > 0 &&  // Not yet swept (see "Combat").
+            GetEnemy(session, i)->hp <= (GetEnemy(session, i)->max_hp / 4) &&
+            GetEnemy(session, i)->template->known_words &
+              WORD_BIT(WORD_OF_HEALTH)) {
+          targets[0] = session->enemies[i];
+          CastSpell(session, enemy, "Y",
+                    targets);  // Healing spell.
           actionPerformed = true;
         }
       }
-      while (actionPerformed == false) {
-        if (g_enemies[i]->words[WORD_OF_FIRE] == KNOWN ||
-            g_enemies[i]->words[WORD_OF_AIR] == KNOWN ||
-            g_enemies[i]->words[WORD_OF_WATER] == KNOWN ||
-            g_enemies[i]->words[WORD_OF_EARTH] == KNOWN)
-        switch (RandomInt(1, 4)) {
+      while (actionPerformed == false && (words & ELEMENTAL_WORDS)) {
+        switch (RandomInt(session, 1, 4)) {
           case 1:
-            if (g_enemies[i]->words[WORD_OF_AIR] == KNOWN) {
-              targets[0] = &g_player;
-              CastSpell(g_enemies[index], "E", targets);  // Wind spell.
+            if (words & WORD_BIT(WORD_OF_AIR)) {
+              targets[0] = session->player.handle;
+              CastSpell(session, enemy, "E",
+                        targets);  // Wind spell.
               actionPerformed = true;
             }
             break;
           case 2:
-            if (g_enemies[i]->words[WORD_OF_WATER] == KNOWN) {
-              targets[0] = &g_player;
-              CastSpell(g_enemies[index], "S", targets);  // Water spell.
+            if (words & WORD_BIT(WORD_OF_WATER)) {
+              targets[0] = session->player.handle;
+              CastSpell(session, enemy, "S",
+                        targets);  // Water spell.
               actionPerformed = true;
             }
             break;
           case 3:
-            if (g_enemies[i]->words[WORD_OF_EARTH] == KNOWN) {
-              targets[0] = &g_player;
-              CastSpell(g_enemies[index], "P", targets);  // Earth spell.
+            if (words & WORD_BIT(WORD_OF_EARTH)) {
+              targets[0] = session->player.handle;
+              CastSpell(session, enemy, "P",
+                        targets);  // Earth spell.
               actionPerformed = true;
             }
             break;
           default:
-            if (g_enemies[i]->words[WORD_OF_FIRE] == KNOWN) {
-              targets[0] = &g_player;
-              CastSpell(g_enemies[index], "B", targets);  // Fire spell.
+            if (words & WORD_BIT(WORD_OF_FIRE)) {
+              targets[0] = session->player.handle;
+              CastSpell(session, enemy, "B",
+                        targets);  // Fire spell.
               actionPerformed = true;
             }
             break;
         }
       }
+      if (actionPerformed == false) {  // No offensive Words known.
+        Attack(session, enemy, &session->player);
+      }
     } else {
-      Attack(g_enemies[index], &g_player);
+      Attack(session, enemy, &session->player);
     }
   } else {  // The active NPC is not a spellcaster.
-    Attack(g_enemies[index], &g_player);
+    Attack(session, enemy, &session->player);
+  }
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: AllyAI
+
+Description: Handles decision-making during combat for NPCs fighting alongside
+             the player (companions and summoned creatures), who simply attack
+             the first enemy they can see.
+
+     Inputs: session - Pointer to the current game session.
+             ally    - Pointer to the ally whose turn it is.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int AllyAI(game_session_t *session, game_character_t *ally) {
+  int i;
+  game_character_t *enemy;
+
+  if (ally == NULL) {
+    PRINT_ERROR_MESSAGE;
+    return FAILURE;
+  }
+
+  if (ally->status[INANIMATE] == true || CanAct(ally) == false) {
+    return SUCCESS;
+  }
+  for (i = 0; i < NumberOfEnemies(session); i++) {
+    enemy = GetEnemy(session, i);
+    if (enemy->hp > 0 && enemy->status[INVISIBLE] == false) {
+      return Attack(session, ally, enemy);
+    }
+  }
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: ApplyStatus
+
+Description: Afflicts a game character with a timed status (e.g., "POISONED")
+             for a given number of rounds. If the status is already in effect,
+             it lasts for whichever number of rounds is greater. An afflicted
+             stack's leader leaves its stack to a member split from it (see
+             "SplitFromStack"), which joins the battle in its place.
+
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character of interest.
+             status  - A timed status ("ASLEEP" through "SILENCED").
+             rounds  - Number of rounds the status is to last.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int ApplyStatus(game_session_t *session, game_character_t *p_gc, int status,
+                int rounds) {
+  int i, j;
+  status_effects_t *effects = &session->status_effects;
+  game_character_t *heir;
+
+  if (p_gc == NULL ||
+      status < FIRST_TIMED_STATUS ||
+      status >= FIRST_TIMED_STATUS + NUM_TIMED_STATUSES ||
+      rounds <= 0) {
+    PRINT_ERROR_MESSAGE;
+    return FAILURE;
+  }
+
+  if (p_gc->stack != NULL) {
+    heir = SplitFromStack(session, p_gc);
+    heir->stack = p_gc->stack;  // Unless the heir was the last member.
+    p_gc->stack = NULL;
+    AddEnemy(session, heir);
+  }
+
+  i = FindAfflicted(effects, p_gc);
+  if (i == effects->num_afflicted) {  // Not yet afflicted: add a column.
+    if (GrowStatusEffects(session, p_gc->handle & HANDLE_INDEX_MASK) ==
+        FAILURE) {
+      return FAILURE;
+    }
+    effects->afflicted[i] = p_gc->handle;
+    effects->columns[p_gc->handle & HANDLE_INDEX_MASK] = i;
+    for (j = 0; j < NUM_TIMED_STATUSES; j++) {
+      effects->rounds[j][i] = 0;
+    }
+    effects->num_afflicted++;
+  }
+  if (rounds > INT16_MAX) {
+    rounds = INT16_MAX;
+  }
+  if (effects->rounds[status - FIRST_TIMED_STATUS][i] < rounds) {
+    effects->rounds[status - FIRST_TIMED_STATUS][i] = rounds;
+  }
+  p_gc->status[status] = true;
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: FindAfflicted
+
+Description: Looks up a game character's column in a table of timed statuses
+             in constant time, via the character's slot in the character
+             table.
+
+     Inputs: effects - Pointer to the table of timed statuses.
+             p_gc    - Pointer to the game character of interest.
+
+    Outputs: Index of the character's column within "afflicted," or
+             "num_afflicted" if the character has no timed statuses.
+*******************************************************************************/
+int FindAfflicted(status_effects_t *effects, game_character_t *p_gc) {
+  int slot = p_gc->handle & HANDLE_INDEX_MASK, index;
+
+  if (slot >= effects->num_columns) {
+    return effects->num_afflicted;
+  }
+  index = effects->columns[slot];
+  if (index >= effects->num_afflicted ||
+      effects->afflicted[index] != p_gc->handle) {
+    return effects->num_afflicted;  // The entry is left over from before.
+  }
+
+  return index;
+}
+
+/*******************************************************************************
+   Function: GrowStatusEffects
+
+Description: Makes room in the table of timed statuses for one more column and
+             for a given slot of the character table, doubling the table's
+             capacity as needed.
+
+     Inputs: session - Pointer to the current game session.
+             slot    - Character table slot of the character to be added.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int GrowStatusEffects(game_session_t *session, int slot) {
+  int i, new_capacity, *new_columns;
+  int16_t *new_rounds;
+  character_handle_t *new_afflicted;
+  status_effects_t *effects = &session->status_effects;
+
+  if (effects->num_afflicted == effects->capacity) {
+    new_capacity = effects->capacity > 0 ? effects->capacity * 2 :
+                                           AFFLICTED_CAPACITY;
+    new_afflicted = realloc(effects->afflicted,
+                            new_capacity * sizeof(character_handle_t));
+    if (new_afflicted == NULL) {
+      PRINT_ERROR_MESSAGE;
+      return FAILURE;
+    }
+    effects->afflicted = new_afflicted;
+    for (i = 0; i < NUM_TIMED_STATUSES; i++) {
+      new_rounds = realloc(effects->rounds[i], new_capacity * sizeof(int16_t));
+      if (new_rounds == NULL) {
+        PRINT_ERROR_MESSAGE;
+        return FAILURE;
+      }
+      effects->rounds[i] = new_rounds;
+    }
+    effects->capacity = new_capacity;
+  }
+  if (slot >= effects->num_columns) {  // Cover the whole character table.
+    new_capacity = session->characters.capacity > slot ?
+                   session->characters.capacity : slot + 1;
+    new_columns = realloc(effects->columns, new_capacity * sizeof(int));
+    if (new_columns == NULL) {
+      PRINT_ERROR_MESSAGE;
+      return FAILURE;
+    }
+    memset(new_columns + effects->num_columns, 0,
+           (new_capacity - effects->num_columns) * sizeof(int));
+    effects->columns = new_columns;
+    effects->num_columns = new_capacity;
   }
 
   return SUCCESS;
 }
 
+/*******************************************************************************
+   Function: TickStatusEffects
+
+Description: Advances every timed status in the world by one round: poisoned
+             characters take damage (which never reduces them below 1 HP), and
+             statuses whose rounds have run out expire. The rounds of all
+             afflicted characters are decremented together, one status type
+             at a time, without examining the characters themselves (except
+             for poison, which is ticked along with the damage it does).
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: None.
+*******************************************************************************/
+void TickStatusEffects(game_session_t *session) {
+  int i, j, damage;
+  bool afflicted;
+  status_effects_t *effects = &session->status_effects;
+  int16_t *poison;
+  game_character_t *p_gc;
+
+  if (effects->num_afflicted == 0) {
+    return;
+  }
+  for (i = 0; i < NUM_TIMED_STATUSES; i++) {
+    if (i == POISONED - FIRST_TIMED_STATUS) {
+      continue;
+    }
+    for (j = 0; j < effects->num_afflicted; j++) {
+      effects->rounds[i][j] -= effects->rounds[i][j] > 0;
+    }
+  }
+
+  // Apply the results, working backward so removals don't disturb the rest:
+  poison = effects->rounds[POISONED - FIRST_TIMED_STATUS];
+  for (j = effects->num_afflicted - 1; j >= 0; j--) {
+    p_gc = GetCharacter(session, effects->afflicted[j]);
+    if (p_gc == NULL) {  // Deleted since being afflicted.
+      RemoveAfflicted(effects, j);
+      continue;
+    }
+    if (poison[j] > 0) {
+      poison[j]--;
+      damage = p_gc->hp > POISON_DAMAGE ? POISON_DAMAGE : p_gc->hp - 1;
+      if (damage > 0) {
+        p_gc->hp -= damage;
+        PrintFormatted(session, "%s takes %d points of poison damage.\n",
+                       p_gc->template->name, damage);
+      }
+    }
+    afflicted = false;
+    for (i = 0; i < NUM_TIMED_STATUSES; i++) {
+      p_gc->status[FIRST_TIMED_STATUS + i] = effects->rounds[i][j] > 0;
+      afflicted |= effects->rounds[i][j] > 0;
+    }
+    if (!afflicted) {
+      RemoveAfflicted(effects, j);
+    }
+  }
+}
+
+/*******************************************************************************
+   Function: RemoveAfflicted
+
+Description: Removes a character's column from a table of timed statuses by
+             moving the last column into its place.
+
+     Inputs: effects - Pointer to the table of timed statuses.
+             index   - Index of the column within "afflicted".
+
+    Outputs: None.
+*******************************************************************************/
+void RemoveAfflicted(status_effects_t *effects, int index) {
+  int i, last = --effects->num_afflicted;
+
+  effects->afflicted[index] = effects->afflicted[last];
+  effects->columns[effects->afflicted[index] & HANDLE_INDEX_MASK] = index;
+  for (i = 0; i < NUM_TIMED_STATUSES; i++) {
+    effects->rounds[i][index] = effects->rounds[i][last];
+  }
+}
+
+/*******************************************************************************
+   Function: CanAct
+
+Description: Determines whether a game character is able to take its turn in
+             combat (i.e., is neither asleep nor paralyzed).
+
+     Inputs: p_gc - Pointer to the game character of interest.
+
+    Outputs: true if the character can act, otherwise false.
+*******************************************************************************/
+bool CanAct(game_character_t *p_gc) {
+  return !p_gc->status[ASLEEP] && !p_gc->status[PARALYZED];
+}
+
 /*******************************************************************************
    Function: HandleAttackMenuInput
 
 Description: Takes the player through the process of selecting whom to attack.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int HandleAttackMenuInput(void) {
+int HandleAttackMenuInput(game_session_t *session) {
   int i, input, temp;
   bool repeat_options;
   game_character_t *target;
 
-  if (g_enemies[0] != NULL && g_enemies[0]->type == DUMMY) {
-    printf("%s: \"You're a wizard, not a warrior. Cast a spell!\"\n",
-           FindInhabitant(ARCHWIZARD_OF_ELEMENTS)->name);
-    FlushInput();
+  if (session->num_enemies > 0 &&
+      GetEnemy(session, 0)->type == DUMMY) {
+    PrintFormatted(session,
+                   "%s: \"You're a wizard, not a warrior. Cast a spell!\"\n",
+                   FindInhabitant(session,
+                                  ARCHWIZARD_OF_ELEMENTS)->template->name);
+    FlushInput(session);
     return FAILURE;
   }
 
-  UpdateVisibleGameCharCounter();
+  UpdateVisibleGameCharCounter(session);
   temp = 0;
   for (i = 0; i < NUM_GC_TYPES; i++) {
-    g_character_type_described[i] = false;
+    session->character_type_described[i] = false;
   }
 
   // Display potential targets (unless only one is available):
-  if (g_player.status[IN_COMBAT]) {
-    if (VisibleEnemies() == 1) {
-      Attack(&g_player, g_enemies[0]);
+  if (session->player.status[IN_COMBAT]) {
+    if (VisibleEnemies(session) == 1) {
+      Attack(session, &session->player, GetEnemy(session, 0));
       return SUCCESS;
     } else {
-      printf("Select a target:\n");
-      for (i = 0; i < NumberOfEnemies(); i++) {
-        if (g_enemies[i]->status[INVISIBLE] == false &&
-            g_character_type_described[g_enemies[i]->type] == false) {
+      PrintFormatted(session, "Select a target:\n");
+      for (i = 0; i < NumberOfEnemies(session); i++) {
+        if (GetEnemy(session, i)->status[INVISIBLE] == false &&
+            session->character_type_described[
+                GetEnemy(session, i)->type] == false) {
           temp++;
-          printf("[%d] %s", temp, g_enemies[i]->name);
-          if (g_num_visible_of_type[g_enemies[i]->type] > 1) {
-            printf(" (%d available)",
-                   g_num_visible_of_type[g_enemies[i]->type]);
+          PrintFormatted(session, "[%d] %s", temp,
+                         GetEnemy(session, i)->template->name);
+          if (session->num_visible_of_type[GetEnemy(session, i)->type] > 1) {
+            PrintFormatted(session, " (%d available)",
+                           session->num_visible_of_type[
+                               GetEnemy(session, i)->type]);
           }
-          printf("\n");
-          g_character_type_described[g_enemies[i]->type] = true;
+          PrintFormatted(session, "\n");
+          session->character_type_described[GetEnemy(session, i)->type] = true;
         }
       }
     }
   } else {  // Not in combat mode: player attacks a local inhabitant.
-    if (VisibleInhabitants(g_world[g_player.location]) == 0) {
-      printf("There is nobody here to attack.\n");
-      FlushInput();
+    if (VisibleInhabitants(session,
+                           session->world[session->player.location]) == 0) {
+      PrintFormatted(session, "There is nobody here to attack.\n");
+      FlushInput(session);
       return FAILURE;
     }
-    if (VisibleInhabitants(g_world[g_player.location]) == 1) {
-      for (target = g_world[g_player.location]->inhabitants;
+    if (VisibleInhabitants(session,
+                           session->world[session->player.location]) == 1) {
+      for (target = FirstLocalInhabitant(session);
            target != NULL;
-           target = target->next) {
+           target = GetCharacter(session, target->next)) {
         if (target->status[INVISIBLE] == false) {
-          Attack(&g_player, target);
+          Attack(session, &session->player, target);
           return SUCCESS;
         }
       }
     } else {  // Multiple visible inhabitants to choose from.
-      printf("Select a target:\n");
-      for (target = g_world[g_player.location]->inhabitants;
+      PrintFormatted(session, "Select a target:\n");
+      for (target = FirstLocalInhabitant(session);
            target != NULL;
-           target = target->next) {
+           target = GetCharacter(session, target->next)) {
         if (target->status[INVISIBLE] == false &&
-            g_character_type_described[target->type] == false) {
+            session->character_type_described[target->type] == false) {
           temp++;
-          printf("[%d] %s", temp, target->name);
-          if (g_num_visible_of_type[target->type] > 1) {
-            printf(" (%d available)", g_num_visible_of_type[target->type]);
+          PrintFormatted(session, "[%d] %s", temp, target->template->name);
+          if (session->num_visible_of_type[target->type] > 1) {
+            PrintFormatted(session, " (%d available)",
+                           session->num_visible_of_type[target->type]);
           }
-          printf("\n");
-          g_character_type_described[target->type] = true;
+          PrintFormatted(session, "\n");
+          session->character_type_described[target->type] = true;
         }
       }
     }
   }
 
   // Player chooses a target by number:
-  GetIntInput(&input, 1, temp);
+  GetIntInput(session, &input, 1, temp);
 
   // Target is now found, and attacked, by matching it with the input:
   temp = 0;
   for (i = 0; i < NUM_GC_TYPES; i++) {
-    g_character_type_described[i] = false;
+    session->character_type_described[i] = false;
   }
-  if (g_player.status[IN_COMBAT]) {
-    for (i = 0; i < NumberOfEnemies(); i++) {
-      if (g_enemies[i]->status[INVISIBLE] == false &&
-          g_character_type_described[g_enemies[i]->type] == false) {
+  if (session->player.status[IN_COMBAT]) {
+    for (i = 0; i < NumberOfEnemies(session); i++) {
+      if (GetEnemy(session, i)->status[INVISIBLE] == false &&
+          session->character_type_described[
+              GetEnemy(session, i)->type] == false) {
         temp++;
         if (temp == input) {
-          Attack(&g_player, g_enemies[i]);
+          Attack(session, &session->player, GetEnemy(session, i));
           return SUCCESS;
         }
-        g_character_type_described[g_enemies[i]->type] = true;
+        session->character_type_described[GetEnemy(session, i)->type] = true;
       }
     }
   } else {  // Not in combat mode: player attacks a local inhabitant.
-    for (target = g_world[g_player.location]->inhabitants;
+    for (target = FirstLocalInhabitant(session);
          target != NULL;
-         target = target->next) {
+         target = GetCharacter(session, target->next)) {
       if (target->status[INVISIBLE] == false &&
-          g_character_type_described[target->type] == false) {
+          session->character_type_described[target->type] == false) {
         temp++;
         if (temp == input) {
-          Attack(&g_player, target);
-          if (g_player.status[IN_COMBAT] == false) {
+          Attack(session, &session->player, target);
+          if (session->player.status[IN_COMBAT] == false) {
             if (target->hp > 0) {
               target->relationship = HOSTILE_ENEMY;
-              AddEnemy(target);
+              AddEnemy(session, target);
             } else {
-              printf("%s is dead.\n", Capitalize(GetNameDefinite(target)));
-              FlushInput();
-            }
-            for (target = g_world[g_player.location]->inhabitants;
-                 target != NULL;
-                 target = target->next) {
-              if (WillingToFight(target) &&
-                  target->status[IN_COMBAT] == false) {
-                target->relationship = HOSTILE_ENEMY;
-                AddEnemy(target);
-              }
+              PrintFormatted(session, "%s is dead.\n",
+                             Capitalize(GetNameDefinite(session, target)));
+              FlushInput(session);
             }
+            RallyDefenders(session,
+                           session->world[session->player.location], target);
           }
-          if (g_player.status[IN_COMBAT] == false && NumberOfEnemies() > 0) {
-            printf("Prepare for battle!\n");
-            FlushInput();
-            Combat();
+          if (session->player.status[IN_COMBAT] == false &&
+              NumberOfEnemies(session) > 0) {
+            PrintFormatted(session, "Prepare for battle!\n");
+            FlushInput(session);
+            Combat(session);
           }
           return SUCCESS;
         }
-        g_character_type_described[target->type] = true;
+        session->character_type_described[target->type] = true;
       }
     }
   }
@@ -755,36 +1686,167 @@ int HandleAttackMenuInput(void) {
 
 Description: Handles a physical attack between two game characters.
 
-     Inputs: attacker - The GC performing the attack.
+     Inputs: session  - Pointer to the current game session.
+             attacker - The GC performing the attack.
              defender - The GC being attacked.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int Attack(game_character_t *attacker, game_character_t *defender) {
-  int damage;
+int Attack(game_session_t *session, game_character_t *attacker,
+           game_character_t *defender) {
+  hit_t hit;
 
   if (attacker == NULL || defender == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  printf("%s attacks %s", attacker->name, defender->name);
-  if (RandomInt(1, 10) > 2) {  // 80% chance of a successful hit.
-    damage = RandomInt(1, attacker->physical_power);
-    damage -= RandomInt(0, defender->physical_defense);
-    if (damage <= 0) {
-      damage = 1;
-    }
-    defender->hp -= damage;
-    printf(" for %d damage.", damage);
+  PrepareAttack(&hit, attacker, defender);
+  RollHits(session, 1, &hit);
+  ResolveHits(1, &hit, 1);
+  defender->hp = hit.hp;
+  PrintFormatted(session, "%s attacks %s", attacker->template->name,
+                 defender->template->name);
+  if (hit.landed) {
+    PrintFormatted(session, " for %d damage.", hit.damage);
   } else {
-    printf(", but misses.");
+    PrintFormatted(session, ", but misses.");
   }
-  FlushInput();
+  FlushInput(session);
 
   return SUCCESS;
 }
 
+/*******************************************************************************
+   Function: StackAttack
+
+Description: Handles a physical attack by every member of a stack on a single
+             game character, resolved as one batch of hits (see "ResolveHits")
+             and reported in a single line.
+
+     Inputs: session  - Pointer to the current game session.
+             leader   - The enemy leading the stack.
+             defender - The GC being attacked.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int StackAttack(game_session_t *session, game_character_t *leader,
+                game_character_t *defender) {
+  int i, count, num_landed = 0, damage = 0;
+  hit_t *hits;
+  arena_mark_t mark;
+
+  if (leader == NULL || defender == NULL) {
+    PRINT_ERROR_MESSAGE;
+    return FAILURE;
+  }
+
+  count = StackSize(leader);
+  mark = ArenaMark(&session->scratch);
+  hits = ArenaAllocate(&session->scratch, count * sizeof(hit_t));
+  if (hits == NULL) {
+    PRINT_ERROR_MESSAGE;
+    return FAILURE;
+  }
+  for (i = 0; i < count; i++) {  // The members differ only in HP.
+    PrepareAttack(&hits[i], leader, defender);
+  }
+  RollHits(session, count, hits);
+  ResolveHits(count, hits, 1);
+  for (i = 0; i < count; i++) {
+    num_landed += hits[i].landed;
+    damage += hits[i].damage;
+  }
+  ArenaRelease(&session->scratch, mark);
+  defender->hp -= damage;
+  PrintFormatted(session, "%s x%d attack %s", leader->template->name, count,
+                 defender->template->name);
+  if (num_landed > 0) {
+    PrintFormatted(session, ": %d hit for %d damage.", num_landed, damage);
+  } else {
+    PrintFormatted(session, ", but all miss.");
+  }
+  FlushInput(session);
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: PrepareAttack
+
+Description: Fills in the stats of a physical attack's attacker and defender
+             (but not its random numbers) for resolution by "ResolveHits."
+
+     Inputs: hit      - Pointer to the hit to be prepared.
+             attacker - The GC performing the attack.
+             defender - The GC being attacked.
+
+    Outputs: None.
+*******************************************************************************/
+void PrepareAttack(hit_t *hit, game_character_t *attacker,
+                   game_character_t *defender) {
+  hit->accuracy = ATTACK_ACCURACY;
+  hit->low = 1;
+  hit->high = attacker->physical_power > 1 ? attacker->physical_power : 1;
+  hit->defense = defender->physical_defense > 0 ? defender->physical_defense :
+                                                  0;
+  hit->hp = defender->hp;
+}
+
+/*******************************************************************************
+   Function: RollHits
+
+Description: Draws all the random numbers a batch of hits will need, so that
+             "ResolveHits" itself draws none.
+
+     Inputs: session - Pointer to the current game session.
+             count   - Number of hits in the batch.
+             hits    - The hits.
+
+    Outputs: None.
+*******************************************************************************/
+void RollHits(game_session_t *session, int count, hit_t hits[]) {
+  int i, j;
+
+  for (i = 0; i < count; i++) {
+    for (j = 0; j < NUM_HIT_ROLLS; j++) {
+      hits[i].rolls[j] = rand_r(&session->random_seed);
+    }
+  }
+}
+
+/*******************************************************************************
+   Function: ResolveHits
+
+Description: Resolves a batch of hits, each between an attacker and a
+             defender, from stats and random numbers supplied beforehand (see
+             "PrepareAttack" and "RollHits"): whether each hit lands, its base
+             damage, the damage prevented by the defender's defense, and the
+             defender's resulting HP. Nothing is printed, so callers report the
+             results afterward, and a whole batch (e.g., every target of a
+             spell) is resolved in one pass.
+
+     Inputs: count   - Number of hits in the batch.
+             hits    - The hits (updated in place).
+             minimum - The least damage any hit that lands may deal.
+
+    Outputs: None.
+*******************************************************************************/
+void ResolveHits(int count, hit_t hits[], int minimum) {
+  int i, amount;
+  hit_t *hit;
+
+  for (i = 0; i < count; i++) {
+    hit = &hits[i];
+    hit->landed = hit->rolls[0] % 100 < hit->accuracy;
+    amount = hit->low + hit->rolls[1] % (hit->high - hit->low + 1) -
+             hit->rolls[2] % (hit->defense + 1);
+    amount = amount > minimum ? amount : minimum;
+    hit->damage = hit->landed ? amount : 0;
+    hit->hp -= hit->damage;
+  }
+}
+
 /*******************************************************************************
    Function: WillingToFight
 
@@ -796,51 +1858,7 @@ Description: Determines whether a given NPC will fight the player if the player
     Outputs: 'true' or 'false'
 *******************************************************************************/
 bool WillingToFight(game_character_t *p_gc) {
-  if (p_gc->type == SOLDIER ||
-      p_gc->type == KNIGHT ||
-      p_gc->type == WIZARD ||
-      p_gc->type == INNKEEPER ||
-      p_gc->type == FISHERMAN ||
-      p_gc->type == SAILOR ||
-      p_gc->type == FARMER ||
-      p_gc->type == ILLARUM_PRIEST ||
-      p_gc->type == ILLARUM_HIGH_PRIEST ||
-      p_gc->type == ARCHWIZARD_OF_ELEMENTS ||
-      p_gc->type == COURT_WIZARD ||
-      p_gc->type == WIZARD_OF_ELEMENTS ||
-      p_gc->type == WIZARD_OF_MIND ||
-      p_gc->type == ARCHWIZARD_OF_MIND ||
-      p_gc->type == VENTARRIS_PRIEST ||
-      p_gc->type == BARBARIAN_WARRIOR ||
-      p_gc->type == VENTARRIS_HIGH_PRIEST ||
-      p_gc->type == BARBARIAN ||
-      p_gc->type == BARBARIAN_SHAMAN ||
-      p_gc->type == BARBARIAN_CHIEFTAIN ||
-      p_gc->type == ELF ||
-      p_gc->type == DWARF_MERCHANT ||
-      p_gc->type == DWARF_PRIEST ||
-      p_gc->type == ELF_LOREMASTER ||
-      p_gc->type == DWARF || p_gc->type == DWARF_KING ||
-      p_gc->type == DWARF_MINER ||
-      p_gc->type == DWARF_GUARDIAN ||
-      p_gc->type == DWARF_LOREMASTER ||
-      p_gc->type == DWARF_HIGH_PRIEST ||
-      p_gc->type == GNOME ||
-      p_gc->type == GNOME_MINER || p_gc->type == DRUID ||
-      p_gc->type == ARCHDRUID ||
-      p_gc->type == MERFOLK_SOLDIER ||
-      p_gc->type == MERFOLK_PRIESTESS ||
-      p_gc->type == MERFOLK_HIGH_PRIESTESS ||
-      p_gc->type == MERFOLK_QUEEN ||
-      p_gc->type == VENTARRIS_KING ||
-      p_gc->type == ILLARUM_KING ||
-      p_gc->type == LICH || p_gc->type == NECROMANCER ||
-      p_gc->type == ARCHNECROMANCER ||
-      p_gc->type == SKELETAL_KNIGHT) {
-    return true;
-  }
-
-  return false;
+  return (character_types[p_gc->type].traits & TRAIT_FIGHTS) != 0;
 }
 
 /*******************************************************************************
@@ -853,33 +1871,7 @@ Description: Determines whether a given NPC will flee when losing a fight.
     Outputs: 'true' or 'false'
 *******************************************************************************/
 bool WillingToFlee(game_character_t *p_gc) {
-  return p_gc->type == PEASANT ||
-         p_gc->type == SOLDIER ||
-         p_gc->type == WIZARD ||
-         p_gc->type == INNKEEPER ||
-         p_gc->type == FISHERMAN ||
-         p_gc->type == SAILOR ||
-         p_gc->type == FARMER ||
-         p_gc->type == ILLARUM_PRIEST ||
-         p_gc->type == ILLARUM_HIGH_PRIEST ||
-         p_gc->type == ARCHWIZARD_OF_ELEMENTS ||
-         p_gc->type == COURT_WIZARD ||
-         p_gc->type == WIZARD_OF_ELEMENTS ||
-         p_gc->type == WIZARD_OF_MIND ||
-         p_gc->type == ARCHWIZARD_OF_MIND ||
-         p_gc->type == VENTARRIS_PRIEST ||
-         p_gc->type == VENTARRIS_HIGH_PRIEST ||
-         p_gc->type == ELF ||
-         p_gc->type == DWARF_MERCHANT ||
-         p_gc->type == DWARF_PRIEST ||
-         p_gc->type == ELF_LOREMASTER ||
-         p_gc->type == GNOME ||
-         p_gc->type == GNOME_MINER ||
-         p_gc->type == DRUID ||
-         p_gc->type == ARCHDRUID ||
-         p_gc->type == VENTARRIS_KING ||
-         p_gc->type == NECROMANCER ||
-         p_gc->type == ARCHNECROMANCER;
+  return (character_types[p_gc->type].traits & TRAIT_FLEES) != 0;
 }
 
 /*******************************************************************************
@@ -893,48 +1885,5 @@ Description: Determines whether a given NPC will assist allies during combat
     Outputs: 'true' or 'false'
 *******************************************************************************/
 bool WillingToHelp(game_character_t *p_gc) {
-  if (p_gc->type == SOLDIER ||
-      p_gc->type == KNIGHT ||
-      p_gc->type == WIZARD ||
-      p_gc->type == INNKEEPER ||
-      p_gc->type == FISHERMAN ||
-      p_gc->type == SAILOR ||
-      p_gc->type == FARMER ||
-      p_gc->type == ILLARUM_PRIEST ||
-      p_gc->type == ILLARUM_HIGH_PRIEST ||
-      p_gc->type == ARCHWIZARD_OF_ELEMENTS ||
-      p_gc->type == COURT_WIZARD ||
-      p_gc->type == WIZARD_OF_ELEMENTS ||
-      p_gc->type == WIZARD_OF_MIND ||
-      p_gc->type == ARCHWIZARD_OF_MIND ||
-      p_gc->type == VENTARRIS_PRIEST ||
-      p_gc->type == BARBARIAN_WARRIOR ||
-      p_gc->type == VENTARRIS_HIGH_PRIEST ||
-      p_gc->type == BARBARIAN ||
-      p_gc->type == BARBARIAN_SHAMAN ||
-      p_gc->type == BARBARIAN_CHIEFTAIN ||
-      p_gc->type == ELF ||
-      p_gc->type == DWARF_MERCHANT ||
-      p_gc->type == DWARF_PRIEST ||
-      p_gc->type == ELF_LOREMASTER ||
-      p_gc->type == DWARF ||
-      p_gc->type == DWARF_KING ||
-      p_gc->type == DWARF_MINER ||
-      p_gc->type == DWARF_GUARDIAN ||
-      p_gc->type == DWARF_LOREMASTER ||
-      p_gc->type == DWARF_HIGH_PRIEST ||
-      p_gc->type == GNOME ||
-      p_gc->type == GNOME_MINER ||
-      p_gc->type == DRUID ||
-      p_gc->type == ARCHDRUID ||
-      p_gc->type == MERFOLK_SOLDIER ||
-      p_gc->type == MERFOLK_PRIESTESS ||
-      p_gc->type == MERFOLK_HIGH_PRIESTESS ||
-      p_gc->type == MERFOLK_QUEEN ||
-      p_gc->type == VENTARRIS_KING ||
-      p_gc->type == ILLARUM_KING) {
-    return true;
-  }
-
-  return false;
+  return (character_types[p_gc->type].traits & TRAIT_HELPS) != 0;
 }
@@ -14,68 +14,71 @@ Description: Functions governing dialogue for the "Words of Power" RPG.
 Description: Takes the player through the process of selecting a game character
              with whom to speak.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int HandleTalkMenuInput(void) {
+int HandleTalkMenuInput(game_session_t *session) {
   int i, input, temp = 0;
   game_character_t *target;
 
-  UpdateVisibleGameCharCounter();
+  UpdateVisibleGameCharCounter(session);
   for (i = 0; i < NUM_GC_TYPES; i++) {
-    g_character_type_described[i] = false;
+    session->character_type_described[i] = false;
   }
 
   // Display potential targets (unless only one is available):
-  if (VisibleInhabitants(g_world[g_player.location]) == 0) {
-    PrintString("There is no one to speak with here.");
-    FlushInput();
+  if (VisibleInhabitants(session,
+                         session->world[session->player.location]) == 0) {
+    PrintString(session, "There is no one to speak with here.");
+    FlushInput(session);
     return FAILURE;
-  } else if (VisibleInhabitants(g_world[g_player.location]) == 1) {
-    for (target = g_world[g_player.location]->inhabitants;
+  } else if (VisibleInhabitants(
+                 session, session->world[session->player.location]) == 1) {
+    for (target = FirstLocalInhabitant(session);
          target != NULL;
-         target = target->next) {
+         target = GetCharacter(session, target->next)) {
       if (target->status[INVISIBLE] == false) {
-        return Dialogue(target);
+        return Dialogue(session, target);
       }
     }
   } else {  // Multiple visible inhabitants to choose from.
-    PrintString("With whom do you wish to speak?");
-    for (target = g_world[g_player.location]->inhabitants;
+    PrintString(session, "With whom do you wish to speak?");
+    for (target = FirstLocalInhabitant(session);
          target != NULL;
-         target = target->next) {
+         target = GetCharacter(session, target->next)) {
       if (target->status[INVISIBLE] == false &&
-          g_character_type_described[target->type] == false) {
+          session->character_type_described[target->type] == false) {
         temp++;
-        printf("[%d] %s", temp, target->name);
-        if (g_num_visible_of_type[target->type] > 1) {
-          printf(" (%d available)", g_num_visible_of_type[target->type]);
+        PrintFormatted(session, "[%d] %s", temp, target->template->name);
+        if (session->num_visible_of_type[target->type] > 1) {
+          PrintFormatted(session, " (%d available)",
+                         session->num_visible_of_type[target->type]);
         }
-        printf("\n");
-        g_character_type_described[target->type] = true;
+        PrintFormatted(session, "\n");
+        session->character_type_described[target->type] = true;
       }
     }
   }
 
   // Player chooses a target by number:
-  GetIntInput(&input, 1, temp);
+  GetIntInput(session, &input, 1, temp);
 
   // The target is now found by matching it with the input:
   temp = 0;
   for (i = 0; i < NUM_GC_TYPES; i++) {
-    g_character_type_described[i] = false;
+    session->character_type_described[i] = false;
   }
-  for (target = g_world[g_player.location]->inhabitants;
+  for (target = FirstLocalInhabitant(session);
        target != NULL;
-       target = target->next) {
+       target = GetCharacter(session, target->next)) {
     if (target->status[INVISIBLE] == false &&
-        g_character_type_described[target->type] == false) {
+        session->character_type_described[target->type] == false) {
       temp++;
       if (temp == input) {
-        return Dialogue(target);
+        return Dialogue(session, target);
       }
-      g_character_type_described[target->type] = true;
+      session->character_type_described[target->type] = true;
     }
   }
 
@@ -89,14 +92,14 @@ int HandleTalkMenuInput(void) {
 Description: Presents dialogue text and options when the player interacts with a
              particular NPC.
 
-     Inputs: p_gc - Pointer to the NPC with whom the player is speaking (or, in
-                    group dialogue, the main NPC).
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the NPC with whom the player is speaking (or,
+                       in group dialogue, the main NPC).
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int Dialogue(game_character_t *p_gc) {
-  int i, input;
-  bool canCommunicate;
+int Dialogue(game_session_t *session, game_character_t *p_gc) {
+  int input;
   char output[LONG_STR_LEN + 1] = "";
 
   if (p_gc == NULL) {
@@ -105,39 +108,33 @@ int Dialogue(game_character_t *p_gc) {
   }
 
   // Check for language compatibility:
-  canCommunicate = false;
-  for (i = 0; i < NUM_LANGUAGE_TYPES; i++) {
-    if (g_player.languages[i] == KNOWN && p_gc->languages[i] == KNOWN) {
-      canCommunicate = true;
-      break;
-    }
-  }
-  if (canCommunicate == false) {
+  if ((session->player.template->known_languages &
+       p_gc->template->known_languages) == 0) {
     sprintf(output,
             "All your attempts at communication have failed. It appears that "
             "you and %s do not share a common language.",
-            GetNameDefinite(p_gc));
-    PrintString(output);
-    FlushInput();
+            GetNameDefinite(session, p_gc));
+    PrintString(session, output);
+    FlushInput(session);
 
     return SUCCESS;  // Although they can't talk, no error has occurred.
   }
 
-  p_gc->conversations++;
+  p_gc->details->conversations++;
   if (p_gc->type == MERCHANT || p_gc->type == DWARF_MERCHANT) {
-    //MerchantDialogue(p_gc);
+    //MerchantDialogue(session, p_gc);
   }
   switch (p_gc->type) {
     case ARCHWIZARD_OF_ELEMENTS:
-      if (p_gc->conversations == 1) {  // Indicates new game: offer tutorial.
+      if (p_gc->details->conversations == 1) {  // New game: offer tutorial.
         sprintf(output,
                 "%s: \"Congratulations, %s! You have mastered the art of "
                 "projecting your will through the four elemental Words of "
                 "Power -- the Words of Air, Water, Earth, and Fire -- and "
                 "demonstrated great potential as a mage.\"",
-                AllCaps(p_gc->name), g_player.name);
-        PrintString(output);
-        FlushInput();
+                AllCaps(p_gc->template->name), session->player.template->name);
+        PrintString(session, output);
+        FlushInput(session);
         sprintf(output,
                 "%s: \"As such, I've decided not only to declare you a "
                 "graduate, but also to offer employment as an agent of the "
@@ -145,45 +142,53 @@ int Dialogue(game_character_t *p_gc) {
                 "you. Before discussing the details, however, would you like "
                 "to demonstrate your skills one last time for the newer "
                 "students?\"\n",
-                AllCaps(p_gc->name));
-        g_allegiances[ELEMENTS_GUILD] = GOOD_FRIEND;
-        PrintString(output);
-        printf("[1] \"Of course!\"  (Enter tutorial.)\n"
-               "[2] \"No, thanks.\" (Skip tutorial.)\n");
-        GetIntInput(&input, 1, 2);
+                AllCaps(p_gc->template->name));
+        session->allegiances[ELEMENTS_GUILD] = GOOD_FRIEND;
+        PrintString(session, output);
+        PrintFormatted(session,
+                       "[1] \"Of course!\"  (Enter tutorial.)\n"
+                       "[2] \"No, thanks.\" (Skip tutorial.)\n");
+        GetIntInput(session, &input, 1, 2);
         switch (input) {
           case 1:
             sprintf(output,
                     "%s: \"Excellent! Destroy this stuffed dummy with a "
                     "simple, one-Word spell.\"",
-                    AllCaps(p_gc->name));
-            PrintString(output);
-            FlushInput();
-            AddEnemy(AddInhabitant(g_world[g_player.location], DUMMY));
-            Combat();
+                    AllCaps(p_gc->template->name));
+            PrintString(session, output);
+            FlushInput(session);
+            AddEnemy(session,
+                     AddInhabitant(session,
+                                   session->world[session->player.location],
+                                   DUMMY));
+            Combat(session);
             sprintf(output,
                     "%s: \"Well done! We'll set up another dummy. This time, "
                     "speak two or more Words in succession. Remember, this can"
                     " be harmful to the spellcaster, so be cautious! We will "
                     "heal you if necessary while you are practicing in our "
                     "school, but elsewhere you'll have no such protection.\"",
-                    AllCaps(p_gc->name));
-            PrintString(output);
-            FlushInput();
-            AddEnemy(AddInhabitant(g_world[g_player.location], DUMMY));
-            Combat();
+                    AllCaps(p_gc->template->name));
+            PrintString(session, output);
+            FlushInput(session);
+            AddEnemy(session,
+                     AddInhabitant(session,
+                                   session->world[session->player.location],
+                                   DUMMY));
+            Combat(session);
             sprintf(output,
                     "%s: \"Fantastic! It's gratifying to see the progress "
                     "you've made. But now, let us discuss the work I have in "
                     "mind for you.\"",
-                    AllCaps(p_gc->name));
-            PrintString(output);
-            FlushInput();
-            /*while (FindInhabitant(DUMMY) != NULL) {
-              DeleteInhabitant(g_world[g_player.location],
-                               FindInhabitant(DUMMY));
+                    AllCaps(p_gc->template->name));
+            PrintString(session, output);
+            FlushInput(session);
+            /*while (FindInhabitant(session, DUMMY) != NULL) {
+              DeleteInhabitant(session,
+                               session->world[session->player.location],
+                               FindInhabitant(session, DUMMY));
             }*/
-            g_player.hp = g_player.max_hp;
+            session->player.hp = session->player.max_hp;
             // Fall through.
           default:
             sprintf(output,
@@ -192,39 +197,40 @@ int Dialogue(game_character_t *p_gc) {
                     "need them for one of my research projects. You may "
                     "encounter wild beasts while snooping around, but you "
                     "should be more than a match for them!\"",
-                    AllCaps(p_gc->name));
-            PrintString(output);
-            FlushInput();
-            g_missions[ELEMENTS1] = OPEN;
+                    AllCaps(p_gc->template->name));
+            PrintString(session, output);
+            FlushInput(session);
+            session->missions[ELEMENTS1] = OPEN;
             break;
         }
-      } else if (g_missions[ELEMENTS1] == OPEN) {
+      } else if (session->missions[ELEMENTS1] == OPEN) {
         sprintf(output,
                 "%s: \"Do you have those mushroom samples I asked for?\"\n"
                 "[1] \"Yes.\"\n"
                 "[2] \"No.\"",
-                AllCaps(p_gc->name));
-        PrintString(output);
-        GetIntInput(&input, 1, 2);
+                AllCaps(p_gc->template->name));
+        PrintString(session, output);
+        GetIntInput(session, &input, 1, 2);
         switch (input) {
           case 1:
-            if (g_player.inventory[GLOWING_MUSHROOM] >= 10) {
+            if (ItemQuantity(&session->player, GLOWING_MUSHROOM) >= 10) {
               sprintf(output,
                       "%s: \"Excellent! I knew I could count on you. Here's 20"
                       " gold to compensate you for your time.\"",
-                      AllCaps(p_gc->name));
-              PrintString(output);
-              FlushInput();
-              g_missions[ELEMENTS1] = COMPLETED;
-              g_player.inventory[GLOWING_MUSHROOM] -= 10;
-              GiveGold(p_gc, &g_player, 20);
+                      AllCaps(p_gc->template->name));
+              PrintString(session, output);
+              FlushInput(session);
+              session->missions[ELEMENTS1] = COMPLETED;
+              ChangeItemQuantity(session, &session->player, GLOWING_MUSHROOM,
+                                 -10);
+              GiveGold(session, p_gc, &session->player, 20);
               p_gc->relationship++;
-              GainExperience(STD_MISSION_EXP);
+              GainExperience(session, STD_MISSION_EXP);
             } else {
               sprintf(output,
                       "%s: \"No you don't. If this is a joke, it isn't funny. "
                       "Return when you have those ten samples!\"",
-                      AllCaps(p_gc->name));
+                      AllCaps(p_gc->template->name));
               if (p_gc->relationship > INDIFFERENT) {
                 p_gc->relationship--;
               }
@@ -233,35 +239,35 @@ int Dialogue(game_character_t *p_gc) {
           default:
             sprintf(output,
                     "%s: \"Please collect them for me as soon as possible.\"",
-                    AllCaps(p_gc->name));
-            PrintString(output);
-            FlushInput();
+                    AllCaps(p_gc->template->name));
+            PrintString(session, output);
+            FlushInput(session);
             break;
         }
-      } else if (g_missions[ELEMENTS2] == OPEN) {
+      } else if (session->missions[ELEMENTS2] == OPEN) {
         sprintf(output,
                 "%s: \"Why haven't you delivered those goods to the druids "
                 "yet, %s? Please hurry or I will not trust you with any more "
                 "errands.\"",
-                AllCaps(p_gc->name),
-                g_player.name);
-        PrintString(output);
-        FlushInput();
-      } else if (g_missions[ELEMENTS2] == COMPLETED) {
+                AllCaps(p_gc->template->name),
+                session->player.template->name);
+        PrintString(session, output);
+        FlushInput(session);
+      } else if (session->missions[ELEMENTS2] == COMPLETED) {
         sprintf(output,
                 "%s: \"Thank you for delivering those goods to the druids, %s!"
                 "Our relationship with them is crucial to Illarum's future.\"",
-                AllCaps(p_gc->name),
-                g_player.name);
-        PrintString(output);
-        FlushInput();
+                AllCaps(p_gc->template->name),
+                session->player.template->name);
+        PrintString(session, output);
+        FlushInput(session);
       } else {
         sprintf(output,
                 "%s: \"Welcome back, %s! Tell me of your travels...\"\n",
-                AllCaps(p_gc->name),
-                g_player.name);
-        PrintString(output);
-        FlushInput();
+                AllCaps(p_gc->template->name),
+                session->player.template->name);
+        PrintString(session, output);
+        FlushInput(session);
       }
       break;
     case DRUID:
@@ -270,56 +276,58 @@ int Dialogue(game_character_t *p_gc) {
               "[1] \"Nature's blessings upon you as well.\"\n"
               "[2] \"Can you teach me a new language?\"\n"
               "[3] \"Can you teach me a new Word of Power?\"",
-              AllCaps(p_gc->name));
-      PrintString(output);
-      GetIntInput(&input, 1, 3);
+              AllCaps(p_gc->template->name));
+      PrintString(session, output);
+      GetIntInput(session, &input, 1, 3);
       if (input == 2) {
-        LanguageLearningDialogue(p_gc);
+        LanguageLearningDialogue(session, p_gc);
       } else if (input == 3) {
-        WordLearningDialogue(p_gc);
+        WordLearningDialogue(session, p_gc);
       }
       break;
     case ARCHDRUID:
-      if (g_missions[ELEMENTS1] == OPEN) {
+      if (session->missions[ELEMENTS1] == OPEN) {
         sprintf(output,
                 "%s: \"Greetings, friend. You wear the garb of a Wizard of the"
                 " Elements. Do you bear goods from the Archwizard?\"\n"
                 "[1] \"Yes, he asked me to bring this food to you.\"\n"
                 "[2] \"No, I'm afraid I don't.\"",
-                AllCaps(p_gc->name));
-        PrintString(output);
-        GetIntInput(&input, 1, 2);
+                AllCaps(p_gc->template->name));
+        PrintString(session, output);
+        GetIntInput(session, &input, 1, 2);
         switch (input) {
           case 1:
-            if (g_player.inventory[FOOD] > 0) {
-              if (g_player.inventory[FOOD] < 5) {
+            if (ItemQuantity(&session->player, FOOD) > 0) {
+              if (ItemQuantity(&session->player, FOOD) < 5) {
                 sprintf(output,
                         "%s: \"Hm. This is less than we were promised, but we "
                         "will get by. Be sure to thank the Archwizard for me, "
                         "will you?\"",
-                        AllCaps(p_gc->name));
-                PrintString(output);
-                FlushInput();
-                p_gc->inventory[FOOD] += g_player.inventory[FOOD];
-                g_player.inventory[FOOD] = 0;
+                        AllCaps(p_gc->template->name));
+                PrintString(session, output);
+                FlushInput(session);
+                ChangeItemQuantity(session, p_gc, FOOD,
+                                   ItemQuantity(&session->player, FOOD));
+                ChangeItemQuantity(session, &session->player, FOOD,
+                                   -ItemQuantity(&session->player, FOOD));
               } else {
                 sprintf(output,
                         "%s: \"Wonderful! It is just as we were promised. Be "
                         "sure to thank the Archwizard for me, will you?\"",
-                        AllCaps(p_gc->name));
-                PrintString(output);
-                FlushInput();
-                p_gc->inventory[FOOD] += 5;
-                g_player.inventory[FOOD] -= 5;
+                        AllCaps(p_gc->template->name));
+                PrintString(session, output);
+                FlushInput(session);
+                ChangeItemQuantity(session, p_gc, FOOD, 5);
+                ChangeItemQuantity(session, &session->player, FOOD, -5);
               }
-              g_missions[ELEMENTS1] = COMPLETED;
+              session->missions[ELEMENTS1] = COMPLETED;
             } else {
-              printf(output,
-                     "%s: \"Yet you bring us no food. Please return once you "
-                     "have the promised supplies.\"",
-                     AllCaps(p_gc->name));
-              PrintString(output);
-              FlushInput();
+              sprintf(output,
+                      "%s: \"Yet you bring us no food. Please return once you "
+                      "have the promised supplies.\"",
+                      AllCaps(p_gc->template->name));
+              PrintString(session, output);
+              FlushInput(session);
             }
             break;
           default:
@@ -329,21 +337,21 @@ int Dialogue(game_character_t *p_gc) {
                     "this year has proven extraordinarily difficult. If you "
                     "get a chance, please remind the Archwizard of our "
                     "predicament.\"",
-                    AllCaps(p_gc->name));
-            PrintString(output);
-            FlushInput();
+                    AllCaps(p_gc->template->name));
+            PrintString(session, output);
+            FlushInput(session);
             break;
         }
       } else {
         sprintf(output,
                 "%s: \"Greetings, friend.\"\n",
-                AllCaps(p_gc->name));
-        PrintString(output);
-        FlushInput();
+                AllCaps(p_gc->template->name));
+        PrintString(session, output);
+        FlushInput(session);
       }
       break;
     default:
-      switch (RandomInt(1, 14)) {
+      switch (RandomInt(session, 1, 14)) {
         case 1:
           sprintf(output,
                   "%s: \"Ever heard of the Lonely Fisherman, otherwise known "
@@ -351,7 +359,7 @@ int Dialogue(game_character_t *p_gc) {
                   "just fishing and staring at the sea. You wouldn't know it "
                   "to look at him, but he's one of the most powerful wizards "
                   "in the world!\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 2:
           sprintf(output,
@@ -360,7 +368,7 @@ int Dialogue(game_character_t *p_gc) {
                   "only is it a known refuge for necromancers and other evil "
                   "wizards, but deep within the swamp lies the dark citadel of"
                   " a powerful lich and his undead minions.\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 3:
           sprintf(output,
@@ -368,14 +376,14 @@ int Dialogue(game_character_t *p_gc) {
                   " in the western woodlands. He doesn't usually take kindly "
                   "to strangers, but if you're a friend of the druids he may "
                   "be willing to teach you a thing or two.\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 4:
           sprintf(output,
                   "%s: \"They say a wise and powerful monk has been wandering "
                   "the northern mountains in recent years. I wonder what he's "
                   "doing there...\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 5:
           sprintf(output,
@@ -384,7 +392,7 @@ int Dialogue(game_character_t *p_gc) {
                   "folks think he's deaf or mute. I don't know anything about "
                   "that, but I do know this: he's considered by some to be the"
                   " most powerful wizard in the world!\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 6:
           sprintf(output,
@@ -392,13 +400,13 @@ int Dialogue(game_character_t *p_gc) {
                   "within the western woods. Don't bother trying to find it, "
                   "though: their magic will prevent you from ever getting "
                   "close!\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 7:
           sprintf(output,
                   "%s: \"I hear the gnomes in the northern mountains are being"
                   " harassed by a dragon.\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 8:
           sprintf(output,
@@ -406,7 +414,7 @@ int Dialogue(game_character_t *p_gc) {
                   "in the northern mountains. Their chieftain is said to have "
                   "such a frightening battle cry that orcs and goblins fall "
                   "dead at his feet when they hear it!\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 9:
           sprintf(output,
@@ -415,7 +423,7 @@ int Dialogue(game_character_t *p_gc) {
                   "have hidden several rare tomes of arcane knowledge there "
                   "in a secret vault. I bet a wizard like you would love to "
                   "get your hands on some of those books!\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 10:
           sprintf(output,
@@ -423,7 +431,7 @@ int Dialogue(game_character_t *p_gc) {
                   "tell tall tales about mermaids and such. They even claim "
                   "the merfolk live in a great city deep within the ocean to "
                   "the east of here. Ha!\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 11:
           sprintf(output,
@@ -432,7 +440,7 @@ int Dialogue(game_character_t *p_gc) {
                   " would make for a very benevelont ruler. My advice? Don't "
                   "get involved, or if you do, make sure you're on the winning"
                   " side.\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         case 12:
           sprintf(output,
@@ -441,16 +449,16 @@ int Dialogue(game_character_t *p_gc) {
                   "region. But did you know the lich of the southern swamp was"
                   " himself once a king of Ventarris? He also hopes to "
                   "dominate the region and reign once again as king.\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
         default:
           sprintf(output,
                   "%s: \"Sorry, I'm too busy to talk right now.\"",
-                  AllCaps(p_gc->name));
+                  AllCaps(p_gc->template->name));
           break;
       }
-      PrintString(output);
-      FlushInput();
+      PrintString(session, output);
+      FlushInput(session);
       break;
   }
 
@@ -462,44 +470,57 @@ int Dialogue(game_character_t *p_gc) {
 
 Description: Presents dialogue and options relevant to learning a language.
 
-     Inputs: p_gc - A pointer to the game character the player is speaking with.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - A pointer to the game character the player is speaking
+                       with.
 
     Outputs: SUCCESS if a language is learned, otherwise FAILURE.
 *******************************************************************************/
-int LanguageLearningDialogue(game_character_t *p_gc) {
+int LanguageLearningDialogue(game_session_t *session, game_character_t *p_gc) {
   int i, input, num_languages_available = 0;
-  char output[LONG_STR_LEN + 1] = "";
+  uint32_t teachable;
+  string_builder_t output;
+  arena_mark_t mark;
 
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
+  teachable = p_gc->template->known_languages &
+              ~session->player.template->known_languages;
+
+  mark = ArenaMark(&session->scratch);
+  InitStringBuilder(&output, &session->scratch);
 
   for (i = 0; i < NUM_LANGUAGE_TYPES; i++) {
-    if (p_gc->languages[i] == KNOWN && g_player.languages[i] != KNOWN) {
+    if (teachable & LANGUAGE_BIT(i)) {
       num_languages_available++;
       if (num_languages_available == 1) {
-        sprintf(output, "%s: \"What language do you want to learn?\"",
-                AllCaps(p_gc->name));
+        AppendString(&output, AllCaps(p_gc->template->name));
+        AppendString(&output, ": \"What language do you want to learn?\"");
       }
-      sprintf(output + strlen(output), "\n[%d] %s", num_languages_available,
-              LanguageName(i));
+      AppendString(&output, "\n[");
+      AppendInt(&output, num_languages_available);
+      AppendString(&output, "] ");
+      AppendString(&output, LanguageName(session, i));
     }
   }
 
   if (num_languages_available > 0) {
-    sprintf(output + strlen(output), "\n[%d] Cancel",
-            ++num_languages_available);
-    PrintString(output);
-    GetIntInput(&input, 1, num_languages_available);
+    AppendString(&output, "\n[");
+    AppendInt(&output, ++num_languages_available);
+    AppendString(&output, "] Cancel");
+    PrintString(session, output.data);
+    ArenaRelease(&session->scratch, mark);
+    GetIntInput(session, &input, 1, num_languages_available);
     num_languages_available = 0;
     for (i = 0; i < NUM_LANGUAGE_TYPES; i++) {
-      if (p_gc->languages[i] == KNOWN && g_player.languages[i] != KNOWN) {
+      if (teachable & LANGUAGE_BIT(i)) {
         num_languages_available++;
         if (input == num_languages_available) {
-          if (Transaction(p_gc,
+          if (Transaction(session, p_gc,
                           STD_LANG_FEE * GetPriceModifier(p_gc)) == SUCCESS) {
-            LearnLanguage(i);
+            LearnLanguage(session, i);
             return SUCCESS;
           } else {
             break;
@@ -508,11 +529,13 @@ int LanguageLearningDialogue(game_character_t *p_gc) {
       }
     }
   } else {
-    sprintf(output,
-            "%s: \"You already know all the languages I can teach you.\"",
-            AllCaps(p_gc->name));
-    PrintString(output);
-    FlushInput();
+    AppendFormatted(&output,
+                    "%s: \"You already know all the languages I can teach "
+                    "you.\"",
+                    AllCaps(p_gc->template->name));
+    PrintString(session, output.data);
+    ArenaRelease(&session->scratch, mark);
+    FlushInput(session);
   }
 
   return FAILURE;
@@ -523,45 +546,60 @@ int LanguageLearningDialogue(game_character_t *p_gc) {
 
 Description: Presents dialogue and options relevant to learning a Word of Power.
 
-     Inputs: p_gc - A pointer to the game character the player is speaking with.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - A pointer to the game character the player is speaking
+                       with.
 
     Outputs: SUCCESS if a Word is learned, otherwise FAILURE.
 *******************************************************************************/
-int WordLearningDialogue(game_character_t *p_gc) {
+int WordLearningDialogue(game_session_t *session, game_character_t *p_gc) {
   int i, input, num_words_available = 0;
-  char output[LONG_STR_LEN + 1] = "";
+  uint32_t teachable;
+  string_builder_t output;
+  arena_mark_t mark;
 
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
+  teachable = p_gc->template->known_words &
+              ~session->player.template->known_words;
+
+  mark = ArenaMark(&session->scratch);
+  InitStringBuilder(&output, &session->scratch);
 
   for (i = 0; i < NUM_WORD_TYPES; i++) {
-    if (p_gc->words[i] == KNOWN && g_player.words[i] != KNOWN) {
+    if (teachable & WORD_BIT(i)) {
       num_words_available++;
       if (num_words_available == 1) {
-        sprintf(output,
-                "%s: \"I am willing to teach the following Words. Which one "
-                "interests you?\"",
-                AllCaps(p_gc->name));
+        AppendString(&output, AllCaps(p_gc->template->name));
+        AppendString(&output,
+                     ": \"I am willing to teach the following Words. Which "
+                     "one interests you?\"\n");
       }
-      sprintf(output + strlen(output), "[%d] Word of %s\n", num_words_available,
-              GetWordName(i));
+      AppendChar(&output, '[');
+      AppendInt(&output, num_words_available);
+      AppendString(&output, "] Word of ");
+      AppendString(&output, GetWordName(session, i));
+      AppendChar(&output, '\n');
     }
   }
 
   if (num_words_available > 0) {
-    sprintf(output + strlen(output), "[%d] Cancel\n", ++num_words_available);
-    PrintString(output);
-    GetIntInput(&input, 1, num_words_available);
+    AppendChar(&output, '[');
+    AppendInt(&output, ++num_words_available);
+    AppendString(&output, "] Cancel\n");
+    PrintString(session, output.data);
+    ArenaRelease(&session->scratch, mark);
+    GetIntInput(session, &input, 1, num_words_available);
     num_words_available = 0;
     for (i = 0; i < NUM_WORD_TYPES; i++) {
-      if (p_gc->words[i] == KNOWN && g_player.words[i] != KNOWN) {
+      if (teachable & WORD_BIT(i)) {
         num_words_available++;
         if (input == num_words_available) {
-          if (Transaction(p_gc,
+          if (Transaction(session, p_gc,
                           STD_WORD_FEE * GetPriceModifier(p_gc)) == SUCCESS) {
-            LearnWord(i);
+            LearnWord(session, i);
             return SUCCESS;
           } else {
             break;
@@ -570,11 +608,13 @@ int WordLearningDialogue(game_character_t *p_gc) {
       }
     }
   } else {
-    sprintf(output,
-            "%s: \"You already know all the Words I'm willing to teach you.\"",
-            AllCaps(p_gc->name));
-    PrintString(output);
-    FlushInput();
+    AppendFormatted(&output,
+                    "%s: \"You already know all the Words I'm willing to "
+                    "teach you.\"",
+                    AllCaps(p_gc->template->name));
+    PrintString(session, output.data);
+    ArenaRelease(&session->scratch, mark);
+    FlushInput(session);
   }
 
   return FAILURE;
@@ -585,67 +625,86 @@ int WordLearningDialogue(game_character_t *p_gc) {
 
 Description: Presents dialogue and options relevant to buying and selling.
 
-     Inputs: merchant - Pointer to the merchant NPC.
+     Inputs: session  - Pointer to the current game session.
+             merchant - Pointer to the merchant NPC.
 
     Outputs: SUCCESS if a transaction is completed, otherwise FAILURE.
 *******************************************************************************/
-int MerchantDialogue(game_character_t *merchant) {
-  int i, input, num_options = 0;
-  char output[LONG_STR_LEN + 1] = "";
+int MerchantDialogue(game_session_t *session, game_character_t *merchant) {
+  int i, item, input, num_options = 0;
+  inventory_t *inventory;
+  item_stack_t *stack;
+  string_builder_t output;
+  arena_mark_t mark;
 
   if (merchant == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
+  inventory = &merchant->details->inventory;
+
+  mark = ArenaMark(&session->scratch);
+  InitStringBuilder(&output, &session->scratch);
 
   // Present merchant's inventory and other options to the player:
-  sprintf(output, "%s: \"What would you like to buy?\"\n",
-          merchant->name);
-  for (i = 0; i < NUM_ITEM_TYPES; i++) {
-    if (merchant->inventory[i] > 0) {
+  AppendString(&output, merchant->template->name);
+  AppendString(&output, ": \"What would you like to buy?\"\n");
+  for (i = 0; i < inventory->count; i++) {
+    stack = GetItemStack(inventory, i);
+    num_options++;
+    AppendChar(&output, '[');
+    AppendInt(&output, num_options);
+    AppendString(&output, "] ");
+    AppendString(&output, GetItemName(session, stack->type));
+    AppendString(&output, " (");
+    AppendInt(&output, GetItemValue(session, stack->type) *
+                       GetPriceModifier(merchant));
+    AppendString(&output, " gold)\n");
+    if (stack->quantity >= 10) {
       num_options++;
-      sprintf(output + strlen(output), "[%d] %s (%d gold)\n", num_options,
-              GetItemName(i),
-              (int) (GetItemValue(i) * GetPriceModifier(merchant)));
-      if (merchant->inventory[i] >= 10) {
-        num_options++;
-        sprintf(output + strlen(output), "[%d] 10 %s (%d gold)", num_options,
-                GetItemNamePlural(i),
-                (int) (10 * (GetItemValue(i) * GetPriceModifier(merchant))));
-      }
+      AppendChar(&output, '[');
+      AppendInt(&output, num_options);
+      AppendString(&output, "] 10 ");
+      AppendString(&output, GetItemNamePlural(session, stack->type));
+      AppendString(&output, " (");
+      AppendInt(&output, 10 * (GetItemValue(session, stack->type) *
+                               GetPriceModifier(merchant)));
+      AppendString(&output, " gold)\n");
     }
   }
-  sprintf(output + strlen(output),
-          "[%d] \"Actually, I'd like to sell something.\"\n"
-          "[%d] \"Nothing for now, thank you.\"\n",
-          ++num_options,
-          ++num_options);
+  AppendChar(&output, '[');
+  AppendInt(&output, ++num_options);
+  AppendString(&output, "] \"Actually, I'd like to sell something.\"\n[");
+  AppendInt(&output, ++num_options);
+  AppendString(&output, "] \"Nothing for now, thank you.\"");
+  PrintString(session, output.data);
+  ArenaRelease(&session->scratch, mark);
 
   // Get input and determine what selection the player made:
-  GetIntInput(&input, 1, num_options);
-  for (i = 0; i < NUM_ITEM_TYPES; i++) {
-    if (merchant->inventory[i] > 0) {
+  GetIntInput(session, &input, 1, num_options);
+  for (i = 0; i < inventory->count; i++) {
+    item = GetItemStack(inventory, i)->type;
+    num_options++;
+    if (num_options == input) {
+      if (Transaction(session, merchant,
+                      GetItemValue(session, item) *
+                      GetPriceModifier(merchant))) {
+        GiveItem(session, merchant, &session->player, item);
+        ChangeItemQuantity(session, merchant, item, 1);  // Infinite supply.
+        return SUCCESS;
+      }
+    }
+    if (GetItemStack(inventory, i)->quantity >= 10) {
       num_options++;
       if (num_options == input) {
-        if (Transaction(merchant,
-                        GetItemValue(i) * GetPriceModifier(merchant))) {
-          GiveItem(merchant, &g_player, i);
-          merchant->inventory[i]++;  // Merchant's supply is infinite.
+        if (Transaction(session, merchant,
+                        10 * (GetItemValue(session, item) *
+                              GetPriceModifier(merchant))) == SUCCESS) {
+          GiveItems(session, merchant, &session->player, item, 10);
+          ChangeItemQuantity(session, merchant, item, 10);  // Infinite supply.
           return SUCCESS;
         }
       }
-      if (merchant->inventory[i] >= 10) {
-        num_options++;
-        if (num_options == input) {
-          if (Transaction(merchant,
-                          10 * (GetItemValue(i) *
-                                GetPriceModifier(merchant))) == SUCCESS) {
-            GiveItems(merchant, &g_player, i, 10);
-            merchant->inventory[i] += 10;  // Merchant's supply is infinite.
-            return SUCCESS;
-          }
-        }
-      }
     }
   }
   if (input == ++num_options) {
@@ -681,12 +740,14 @@ double GetPriceModifier(game_character_t *merchant) {
 
 Description: Presents dialogue and options relevant to completing a purchase.
 
-     Inputs: merchant - Pointer to the seller of goods or services.
+     Inputs: session  - Pointer to the current game session.
+             merchant - Pointer to the seller of goods or services.
              price    - Amount of gold required to complete the transaction.
 
     Outputs: SUCCESS if a transaction is completed, otherwise FAILURE.
 *******************************************************************************/
-int Transaction(game_character_t *merchant, int price) {
+int Transaction(game_session_t *session, game_character_t *merchant,
+                int price) {
   int input;
 
   if (merchant == NULL) {
@@ -694,24 +755,26 @@ int Transaction(game_character_t *merchant, int price) {
     return FAILURE;
   }
 
-  printf("%s: \"That will cost %d gold. Do we have a deal?\"\n"
-         "[1] \"Yes.\"\n"
-         "[2] \"No.\"\n",
-         merchant->name,
-         price);
-  GetIntInput(&input, 1, 2);
+  PrintFormatted(session,
+                 "%s: \"That will cost %d gold. Do we have a deal?\"\n"
+                 "[1] \"Yes.\"\n"
+                 "[2] \"No.\"\n",
+                 merchant->template->name,
+                 price);
+  GetIntInput(session, &input, 1, 2);
   if (input == 1) {
-    if (g_player.gold < price) {
-      printf("%s: \"It seems you don't have enough gold.\"\n", merchant->name);
-      FlushInput();
+    if (session->player.details->gold < price) {
+      PrintFormatted(session, "%s: \"It seems you don't have enough gold.\"\n",
+                     merchant->template->name);
+      FlushInput(session);
       return FAILURE;
     }
-    GiveGold(&g_player, merchant, price);
+    GiveGold(session, &session->player, merchant, price);
     return SUCCESS;
   }
-  printf("%s: \"Let me know if you change your mind!\"\n",
-         merchant->name);
-  FlushInput();
+  PrintFormatted(session, "%s: \"Let me know if you change your mind!\"\n",
+                 merchant->template->name);
+  FlushInput(session);
 
   return FAILURE;
 }
@@ -721,11 +784,12 @@ int Transaction(game_character_t *merchant, int price) {
 
 Description: Returns the name of a given language as a string (e.g., "Elvish").
 
-     Inputs: language - Integer representing the language of interest.
+     Inputs: session  - Pointer to the current game session.
+             language - Integer representing the language of interest.
 
     Outputs: Pointer to the desired string.
 *******************************************************************************/
-char *LanguageName(int language) {
+char *LanguageName(game_session_t *session, int language) {
   switch (language) {
     case IMPERIAL:
       return "Imperial";
@@ -0,0 +1,184 @@
+/*******************************************************************************
+   Filename: factions.c
+
+     Author: David C. Drake (https://davidcdrake.com)
+
+Description: Factions for the text-based RPG "Words of Power." Every character
+             type belongs to one of the groups listed in "GroupType" or to none
+             (UNAFFILIATED; see "character_types.h"), and each faction defends
+             the members of certain factions. When the player harms someone,
+             only those who would defend the victim take up arms, subject to
+             the player's allegiances with their groups. Each location keeps
+             its inhabitants willing to fight in a list per faction, so only
+             those of the responding factions are ever visited.
+*******************************************************************************/
+
+#include "wop.h"
+
+// The factions whose members each faction defends, indexed by faction:
+static const uint32_t faction_defends[NUM_FACTIONS] = {
+  [ELEMENTS_GUILD] = FACTION_BIT(ELEMENTS_GUILD) | FACTION_BIT(MIND_GUILD) |
+                     FACTION_BIT(UNAFFILIATED),
+  [MIND_GUILD] = FACTION_BIT(MIND_GUILD) | FACTION_BIT(ELEMENTS_GUILD) |
+                 FACTION_BIT(UNAFFILIATED),
+  [THE_DRUIDS] = FACTION_BIT(THE_DRUIDS) | FACTION_BIT(THE_ELVES) |
+                 FACTION_BIT(THE_FARMERS),
+  [THE_ELVES] = FACTION_BIT(THE_ELVES) | FACTION_BIT(THE_DRUIDS),
+  [THE_DWARVES] = FACTION_BIT(THE_DWARVES) | FACTION_BIT(THE_GNOMES),
+  [THE_GNOMES] = FACTION_BIT(THE_GNOMES) | FACTION_BIT(THE_DWARVES),
+  [THE_MERFOLK] = FACTION_BIT(THE_MERFOLK),
+  [THE_BARBARIANS] = FACTION_BIT(THE_BARBARIANS),
+  [PRIESTS_OF_ILLARUM] = FACTION_BIT(PRIESTS_OF_ILLARUM) |
+                         FACTION_BIT(THE_FARMERS) | FACTION_BIT(UNAFFILIATED),
+  [PRIESTS_OF_VENTARRIS] = FACTION_BIT(PRIESTS_OF_VENTARRIS) |
+                           FACTION_BIT(UNAFFILIATED),
+  [PRIESTS_OF_TORR] = FACTION_BIT(PRIESTS_OF_TORR),
+  [THE_NECROMANCERS] = FACTION_BIT(THE_NECROMANCERS),
+  [THE_FARMERS] = FACTION_BIT(THE_FARMERS) | FACTION_BIT(UNAFFILIATED),
+  [UNAFFILIATED] = FACTION_BIT(UNAFFILIATED) | FACTION_BIT(ELEMENTS_GUILD) |
+                   FACTION_BIT(MIND_GUILD) | FACTION_BIT(PRIESTS_OF_ILLARUM) |
+                   FACTION_BIT(PRIESTS_OF_VENTARRIS) |
+                   FACTION_BIT(THE_FARMERS)
+};
+
+/*******************************************************************************
+   Function: RespondingFactions
+
+Description: Determines which factions will turn on the player for harming a
+             given game character. A faction responds if it defends the
+             victim's faction, unless the player is a good friend of its group
+             (and the victim is not one of the group's own). A group hostile to
+             the player responds regardless of whom the player has harmed.
+
+     Inputs: session - Pointer to the current game session.
+             victim  - Pointer to the game character harmed by the player.
+
+    Outputs: A set of factions, with bit "i" ("FACTION_BIT(i)") set if
+             faction "i" responds.
+*******************************************************************************/
+uint32_t RespondingFactions(game_session_t *session,
+                            game_character_t *victim) {
+  int i, victim_faction = character_types[victim->type].group;
+  uint32_t responders = 0;
+
+  for (i = 0; i < NUM_FACTIONS; i++) {
+    if (i != UNAFFILIATED && i != victim_faction &&
+        session->allegiances[i] >= GOOD_FRIEND) {
+      continue;
+    }
+    if ((faction_defends[i] & FACTION_BIT(victim_faction)) ||
+        (i != UNAFFILIATED && session->allegiances[i] < INDIFFERENT)) {
+      responders |= FACTION_BIT(i);
+    }
+  }
+
+  return responders;
+}
+
+/*******************************************************************************
+   Function: RallyDefenders
+
+Description: Turns the inhabitants of a location who would defend a given game
+             character (see "RespondingFactions") against the player, adding
+             them to the session's "enemies" array. Inhabitants already in
+             combat are unaffected.
+
+     Inputs: session  - Pointer to the current game session.
+             location - Pointer to the location where the victim was harmed.
+             victim   - Pointer to the game character harmed by the player.
+
+    Outputs: Number of inhabitants who have turned against the player.
+*******************************************************************************/
+int RallyDefenders(game_session_t *session, location_t *location,
+                   game_character_t *victim) {
+  int i, count = 0;
+  uint32_t responders = RespondingFactions(session, victim);
+  game_character_t *p_gc;
+
+  for (i = 0; i < NUM_FACTIONS; i++) {
+    if ((responders & FACTION_BIT(i)) == 0) {
+      continue;  // Only the responding factions' fighters are visited.
+    }
+    for (p_gc = GetCharacter(session, location->fighters[i]);
+         p_gc != NULL;
+         p_gc = GetCharacter(session, p_gc->next_fighter)) {
+      if (p_gc != victim && p_gc->status[IN_COMBAT] == false) {
+        p_gc->relationship = HOSTILE_ENEMY;
+        AddEnemy(session, p_gc);
+        count++;
+      }
+    }
+  }
+
+  return count;
+}
+
+/*******************************************************************************
+   Function: LinkFighter
+
+Description: Adds a game character willing to fight to the end of a location's
+             list of its faction's fighters in constant time.
+
+     Inputs: session  - Pointer to the current game session.
+             location - Pointer to the location of interest.
+             fighter  - Pointer to the game character to be added.
+
+    Outputs: None.
+*******************************************************************************/
+void LinkFighter(game_session_t *session, location_t *location,
+                 game_character_t *fighter) {
+  int faction = character_types[fighter->type].group;
+  game_character_t *last = GetCharacter(session,
+                                        location->last_fighter[faction]);
+
+  fighter->previous_fighter = location->last_fighter[faction];
+  fighter->next_fighter = NO_CHARACTER;
+  if (last == NULL) {
+    location->fighters[faction] = fighter->handle;
+  } else {
+    last->next_fighter = fighter->handle;
+  }
+  location->last_fighter[faction] = fighter->handle;
+}
+
+/*******************************************************************************
+   Function: UnlinkFighter
+
+Description: Removes a game character from a location's list of its faction's
+             fighters in constant time.
+
+     Inputs: session  - Pointer to the current game session.
+             location - Pointer to the location of interest.
+             fighter  - Pointer to the game character to be removed.
+
+    Outputs: SUCCESS, or FAILURE if "fighter" does not belong to the list.
+*******************************************************************************/
+int UnlinkFighter(game_session_t *session, location_t *location,
+                  game_character_t *fighter) {
+  int faction = character_types[fighter->type].group;
+  game_character_t *previous = GetCharacter(session,
+                                            fighter->previous_fighter),
+                   *next = GetCharacter(session, fighter->next_fighter);
+
+  if ((previous == NULL ? location->fighters[faction] :
+                          previous->next_fighter) != fighter->handle ||
+      (next == NULL ? location->last_fighter[faction] :
+                      next->previous_fighter) != fighter->handle) {
+    PRINT_ERROR_MESSAGE;
+    return FAILURE;
+  }
+  if (previous == NULL) {
+    location->fighters[faction] = fighter->next_fighter;
+  } else {
+    previous->next_fighter = fighter->next_fighter;
+  }
+  if (next == NULL) {
+    location->last_fighter[faction] = fighter->previous_fighter;
+  } else {
+    next->previous_fighter = fighter->previous_fighter;
+  }
+  fighter->next_fighter = NO_CHARACTER;
+  fighter->previous_fighter = NO_CHARACTER;
+
+  return SUCCESS;
+}
@@ -0,0 +1,490 @@
+/*******************************************************************************
+   Filename: io.c
+
+     Author: David C. Drake (https://davidcdrake.com)
+
+Description: Input/output backends for the text-based RPG "Words of Power." The
+             engine never touches stdin or stdout directly: all text is written
+             and all input is read through the I/O backend of the current game
+             session, which may be the terminal (stdio), an in-memory buffer, a
+             queue fed with input as it arrives (e.g., from a network
+             connection), or a null sink that discards everything written to
+             it (optionally answering every read with the same line, so that
+             a simulated game never runs out of input).
+*******************************************************************************/
+
+#include "wop.h"
+
+/*******************************************************************************
+   Function: CreateStdioBackend
+
+Description: Creates an I/O backend that reads from standard input and writes
+             to standard output (i.e., the terminal).
+
+     Inputs: None.
+
+    Outputs: Pointer to the new backend (or NULL if allocation fails).
+*******************************************************************************/
+io_backend_t *CreateStdioBackend(void) {
+  io_backend_t *io = CreateBackend(NULL);
+
+  if (io != NULL) {
+    io->write = StdioWrite;
+    io->read_line = StdioReadLine;
+  }
+
+  return io;
+}
+
+/*******************************************************************************
+   Function: CreateMemoryBackend
+
+Description: Creates an I/O backend that reads from a given string of scripted
+             input (one line per response) and appends everything written to
+             it to a growable in-memory buffer ("output").
+
+     Inputs: input - Scripted input, which may be NULL (no input available).
+
+    Outputs: Pointer to the new backend (or NULL if allocation fails).
+*******************************************************************************/
+io_backend_t *CreateMemoryBackend(const char *input) {
+  io_backend_t *io = CreateBackend(input);
+
+  if (io != NULL) {
+    io->write = MemoryWrite;
+    io->read_line = MemoryReadLine;
+  }
+
+  return io;
+}
+
+/*******************************************************************************
+   Function: CreateNullBackend
+
+Description: Creates an I/O backend that discards everything written to it.
+             Input is read from a given string of scripted input, exactly as
+             with the memory backend.
+
+     Inputs: input - Scripted input, which may be NULL (no input available).
+
+    Outputs: Pointer to the new backend (or NULL if allocation fails).
+*******************************************************************************/
+io_backend_t *CreateNullBackend(const char *input) {
+  io_backend_t *io = CreateBackend(input);
+
+  if (io != NULL) {
+    io->write = NullWrite;
+    io->read_line = MemoryReadLine;
+  }
+
+  return io;
+}
+
+/*******************************************************************************
+   Function: CreateQueueBackend
+
+Description: Creates an I/O backend like the memory backend, except that it
+             starts with no input and input is added over time via
+             "AppendInput". When no complete line of input is queued, reading
+             returns IO_AGAIN rather than IO_EOF, until "CloseInput" is called.
+
+     Inputs: None.
+
+    Outputs: Pointer to the new backend (or NULL if allocation fails).
+*******************************************************************************/
+io_backend_t *CreateQueueBackend(void) {
+  io_backend_t *io = CreateMemoryBackend(NULL);
+
+  if (io != NULL) {
+    io->input_closed = false;
+  }
+
+  return io;
+}
+
+/*******************************************************************************
+   Function: CreateRepeatingBackend
+
+Description: Creates an I/O backend that discards everything written to it and
+             answers every read with the same line of input, never running
+             out. (Used by the combat simulator, where the player's choices
+             are made by a "player_policy_t" instead.)
+
+     Inputs: line - The line of input to be repeated (without a new line).
+
+    Outputs: Pointer to the new backend (or NULL if allocation fails).
+*******************************************************************************/
+io_backend_t *CreateRepeatingBackend(const char *line) {
+  io_backend_t *io = CreateBackend(line);
+
+  if (io != NULL) {
+    io->write = NullWrite;
+    io->read_line = RepeatingReadLine;
+  }
+
+  return io;
+}
+
+/*******************************************************************************
+   Function: AppendInput
+
+Description: Adds input to the end of a backend's queued input. Input that has
+             already been read is discarded to make room.
+
+     Inputs: io     - Pointer to the backend.
+             data   - Characters to be added.
+             length - Number of characters to be added.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int AppendInput(io_backend_t *io, const char *data, int length) {
+  int new_capacity;
+  char *new_input;
+
+  if (io->input_closed) {
+    return FAILURE;
+  }
+  if (io->input_position > 0) {  // Discard input that has been read.
+    io->input_length -= io->input_position;
+    memmove(io->input, io->input + io->input_position, io->input_length);
+    io->input_position = 0;
+  }
+  if (io->input_length + length + 1 > io->input_capacity) {
+    new_capacity = io->input_capacity > 0 ? io->input_capacity :
+                                            LONG_STR_LEN + 1;
+    while (new_capacity < io->input_length + length + 1) {
+      new_capacity *= 2;
+    }
+    new_input = realloc(io->input, new_capacity);
+    if (new_input == NULL) {
+      return FAILURE;
+    }
+    io->input = new_input;
+    io->input_capacity = new_capacity;
+  }
+  memcpy(io->input + io->input_length, data, length);
+  io->input_length += length;
+  io->input[io->input_length] = '\0';
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: CloseInput
+
+Description: Indicates that no more input will be added to a backend. Once any
+             queued input has been read, reading returns IO_EOF.
+
+     Inputs: io - Pointer to the backend.
+
+    Outputs: None.
+*******************************************************************************/
+void CloseInput(io_backend_t *io) {
+  io->input_closed = true;
+}
+
+/*******************************************************************************
+   Function: DestroyBackend
+
+Description: Frees an I/O backend along with any input or output it holds.
+
+     Inputs: io - Pointer to the backend to be destroyed.
+
+    Outputs: None.
+*******************************************************************************/
+void DestroyBackend(io_backend_t *io) {
+  if (io == NULL) {
+    return;
+  }
+  free(io->input);
+  free(io->output);
+  free(io);
+}
+
+/*******************************************************************************
+   Function: CreateBackend
+
+Description: Allocates an I/O backend with no read or write functions assigned
+             and, optionally, a private copy of some scripted input.
+
+     Inputs: input - Scripted input, which may be NULL.
+
+    Outputs: Pointer to the new backend (or NULL if allocation fails).
+*******************************************************************************/
+io_backend_t *CreateBackend(const char *input) {
+  io_backend_t *io = calloc(1, sizeof(io_backend_t));
+
+  if (io == NULL) {
+    return NULL;
+  }
+  io->input_closed = true;
+  if (input != NULL) {
+    io->input_length = strlen(input);
+    io->input_capacity = io->input_length + 1;
+    io->input = malloc(io->input_capacity);
+    if (io->input == NULL) {
+      free(io);
+      return NULL;
+    }
+    strcpy(io->input, input);
+  }
+
+  return io;
+}
+
+/*******************************************************************************
+   Function: StdioWrite
+
+Description: Writes a given number of characters to standard output.
+
+     Inputs: io     - Pointer to the backend.
+             data   - Characters to be written.
+             length - Number of characters to be written.
+
+    Outputs: Number of characters written.
+*******************************************************************************/
+int StdioWrite(io_backend_t *io, const char *data, int length) {
+  (void) io;  // Standard output needs no state.
+
+  return fwrite(data, 1, length, stdout);
+}
+
+/*******************************************************************************
+   Function: StdioReadLine
+
+Description: Reads one line from standard input. The new line character is not
+             stored, and characters that do not fit in the buffer are
+             discarded.
+
+     Inputs: io     - Pointer to the backend.
+             buffer - Buffer in which to store the line (NULL-terminated).
+             size   - Size of the buffer.
+
+    Outputs: Length of the stored line, or IO_EOF if no more input exists.
+*******************************************************************************/
+int StdioReadLine(io_backend_t *io, char *buffer, int size) {
+  int c, length = 0;
+
+  (void) io;  // Standard input needs no state.
+  fflush(stdout);  // Make sure any prompt is visible before blocking.
+  while ((c = getchar()) != '\n' && c != EOF) {
+    if (length < size - 1) {
+      buffer[length++] = c;
+    }
+  }
+  buffer[length] = '\0';
+  if (c == EOF && length == 0) {
+    return IO_EOF;
+  }
+
+  return length;
+}
+
+/*******************************************************************************
+   Function: MemoryWrite
+
+Description: Appends a given number of characters to the backend's output
+             buffer, growing it as needed.
+
+     Inputs: io     - Pointer to the backend.
+             data   - Characters to be written.
+             length - Number of characters to be written.
+
+    Outputs: Number of characters written (0 if the buffer cannot grow).
+*******************************************************************************/
+int MemoryWrite(io_backend_t *io, const char *data, int length) {
+  int new_capacity;
+  char *new_output;
+
+  if (io->output_length + length + 1 > io->output_capacity) {
+    new_capacity = io->output_capacity > 0 ? io->output_capacity :
+                                             LONG_STR_LEN + 1;
+    while (new_capacity < io->output_length + length + 1) {
+      new_capacity *= 2;
+    }
+    new_output = realloc(io->output, new_capacity);
+    if (new_output == NULL) {
+      return 0;
+    }
+    io->output = new_output;
+    io->output_capacity = new_capacity;
+  }
+  memcpy(io->output + io->output_length, data, length);
+  io->output_length += length;
+  io->output[io->output_length] = '\0';
+
+  return length;
+}
+
+/*******************************************************************************
+   Function: MemoryReadLine
+
+Description: Reads the next line of the backend's scripted (or queued) input.
+             The new line character is not stored, and characters that do not
+             fit in the buffer are discarded. While input remains open, only
+             complete lines are read.
+
+     Inputs: io     - Pointer to the backend.
+             buffer - Buffer in which to store the line (NULL-terminated).
+             size   - Size of the buffer.
+
+    Outputs: Length of the stored line, IO_AGAIN if no complete line has been
+             queued yet, or IO_EOF if no more input exists.
+*******************************************************************************/
+int MemoryReadLine(io_backend_t *io, char *buffer, int size) {
+  int length = 0;
+
+  buffer[0] = '\0';
+  if (!io->input_closed &&
+      (io->input == NULL ||
+       memchr(io->input + io->input_position, '\n',
+              io->input_length - io->input_position) == NULL)) {
+    return IO_AGAIN;
+  }
+  if (io->input_position >= io->input_length) {
+    return IO_EOF;
+  }
+  while (io->input_position < io->input_length &&
+         io->input[io->input_position] != '\n') {
+    if (length < size - 1) {
+      buffer[length++] = io->input[io->input_position];
+    }
+    io->input_position++;
+  }
+  io->input_position++;  // Skip the new line character.
+  buffer[length] = '\0';
+
+  return length;
+}
+
+/*******************************************************************************
+   Function: RepeatingReadLine
+
+Description: Reads the backend's one line of input, which is never used up.
+             Characters that do not fit in the buffer are discarded.
+
+     Inputs: io     - Pointer to the backend.
+             buffer - Buffer in which to store the line (NULL-terminated).
+             size   - Size of the buffer.
+
+    Outputs: Length of the stored line.
+*******************************************************************************/
+int RepeatingReadLine(io_backend_t *io, char *buffer, int size) {
+  int length = io->input_length < size - 1 ? io->input_length : size - 1;
+
+  memcpy(buffer, io->input != NULL ? io->input : "", length);
+  buffer[length] = '\0';
+
+  return length;
+}
+
+/*******************************************************************************
+   Function: NullWrite
+
+Description: Discards a given number of characters.
+
+     Inputs: io     - Pointer to the backend.
+             data   - Characters to be discarded.
+             length - Number of characters to be discarded.
+
+    Outputs: Number of characters "written."
+*******************************************************************************/
+int NullWrite(io_backend_t *io, const char *data, int length) {
+  (void) io;  // Nothing is kept, so neither is needed.
+  (void) data;
+
+  return length;
+}
+
+/*******************************************************************************
+   Function: WrapText
+
+Description: Appends text to the session's current paragraph, inserting line
+             breaks as the text arrives so that no line exceeds the maximum
+             line length. Lines are broken at the last blank space where
+             possible (the blank space becomes the line break); a line with no
+             blank spaces is broken just before the character that would make
+             it too long. Nothing is written until "FlushWrappedText" is
+             called. (Does nothing in silent mode.)
+
+     Inputs: session - Pointer to the current game session.
+             text    - The text to be appended, which must be NULL-terminated.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int WrapText(game_session_t *session, const char *text) {
+  text_wrapper_t *wrapper = &session->wrapper;
+  int i, length, new_capacity;
+  char *new_buffer;
+
+  if (session->silent) {
+    return SUCCESS;
+  }
+  length = strlen(text);
+
+  // Make room for the text plus one inserted line break per character (the
+  // worst case), a final new line character, and a NULL-terminator:
+  if (wrapper->length + (length * 2) + 2 > wrapper->capacity) {
+    new_capacity = wrapper->capacity > 0 ? wrapper->capacity :
+                                           LONG_STR_LEN + 1;
+    while (new_capacity < wrapper->length + (length * 2) + 2) {
+      new_capacity *= 2;
+    }
+    new_buffer = realloc(wrapper->buffer, new_capacity);
+    if (new_buffer == NULL) {
+      return FAILURE;
+    }
+    wrapper->buffer = new_buffer;
+    wrapper->capacity = new_capacity;
+  }
+
+  for (i = 0; i < length; i++) {
+    wrapper->buffer[wrapper->length++] = text[i];
+    if (text[i] == '\n') {
+      wrapper->line_start = wrapper->length;
+      wrapper->last_blank_space = -1;
+      continue;
+    }
+    if (text[i] == ' ') {
+      wrapper->last_blank_space = wrapper->length - 1;
+    }
+    if (wrapper->length - wrapper->line_start == MAX_LINE_LENGTH) {
+      if (wrapper->last_blank_space >= 0) {
+        wrapper->buffer[wrapper->last_blank_space] = '\n';
+        wrapper->line_start = wrapper->last_blank_space + 1;
+      } else {  // Insert a line break before the current character.
+        wrapper->buffer[wrapper->length - 1] = '\n';
+        wrapper->buffer[wrapper->length++] = text[i];
+        wrapper->line_start = wrapper->length - 1;
+      }
+      wrapper->last_blank_space = -1;
+    }
+  }
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: FlushWrappedText
+
+Description: Ends the session's current paragraph with a new line character and
+             writes the whole paragraph to the session's I/O backend at once.
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: Number of characters written.
+*******************************************************************************/
+int FlushWrappedText(game_session_t *session) {
+  text_wrapper_t *wrapper = &session->wrapper;
+  int length;
+
+  if (session->silent || WrapText(session, "\n") == FAILURE) {
+    return 0;
+  }
+  length = session->io->write(session->io, wrapper->buffer, wrapper->length);
+  wrapper->length = 0;
+  wrapper->line_start = 0;
+  wrapper->last_blank_space = -1;
+
+  return length;
+}
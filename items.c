@@ -4,6 +4,10 @@
      Author: David C. Drake (https://davidcdrake.com)
 
 Description: Functions governing items for the text-based RPG "Words of Power."
+             Each character's inventory holds one stack per type of item the
+             character actually owns, ordered by item type: the first few
+             stacks are stored inline and any others in an overflow array
+             allocated from the session's details arena.
 *******************************************************************************/
 
 #include "wop.h"
@@ -14,36 +18,32 @@ Description: Functions governing items for the text-based RPG "Words of Power."
 Description: Displays the player's inventory and prompts the player to choose
              which item to use.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: SUCCESS if an item is used, FAILURE otherwise.
 *******************************************************************************/
-int HandleItemMenuInput(void) {
-  int i, input, temp = 0;
-
-  for (i = 0; i < NUM_ITEM_TYPES; i++) {
-    if (g_player.inventory[i] > 0) {
-      temp++;
-      printf("[%d] %s (%d)\n", temp, GetItemName(i), g_player.inventory[i]);
-    }
+int HandleItemMenuInput(game_session_t *session) {
+  int i, input;
+  inventory_t *inventory = &session->player.details->inventory;
+  item_stack_t *stack;
+
+  for (i = 0; i < inventory->count; i++) {
+    stack = GetItemStack(inventory, i);
+    PrintFormatted(session, "[%d] %s (%d)\n", i + 1,
+                   GetItemName(session, stack->type), stack->quantity);
   }
-  if (temp == 0) {
-    printf("You have no items.\n");
-    FlushInput();
+  if (inventory->count == 0) {
+    PrintFormatted(session, "You have no items.\n");
+    FlushInput(session);
     return FAILURE;
   } else {
-    temp++;
-    printf("[%d] Cancel (return to previous menu)\n", temp);
-    GetIntInput(&input, 1, temp);
-    temp = 0;
-    for (i = 0; i < NUM_ITEM_TYPES; i++) {
-      if (g_player.inventory[i] > 0) {
-        temp++;
-        if (temp == input) {
-          UseItem(&g_player, i);
-          return SUCCESS;
-        }
-      }
+    PrintFormatted(session, "[%d] Cancel (return to previous menu)\n",
+                   inventory->count + 1);
+    GetIntInput(session, &input, 1, inventory->count + 1);
+    if (input <= inventory->count) {
+      UseItem(session, &session->player,
+              GetItemStack(inventory, input - 1)->type);
+      return SUCCESS;
     }
   }
 
@@ -55,35 +55,40 @@ int HandleItemMenuInput(void) {
 
 Description: Handles the use of an item by a given character (player or NPC).
 
-     Inputs: p_gc - Pointer to the user of the item.
-             item - Integer representing the type of item to be used.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the user of the item.
+             item    - Integer representing the type of item to be used.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int UseItem(game_character_t *p_gc, int item) {
-  if (p_gc->inventory[item] < 1) {
+int UseItem(game_session_t *session, game_character_t *p_gc, int item) {
+  if (ItemQuantity(p_gc, item) < 1) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
   switch(item) {
     case HEALING_POTION:
-      printf("%s drinks a healing potion and regains %d hit points.\n",
-             Capitalize(GetNameDefinite(p_gc)),
-             HealGameCharacter(p_gc, RandomInt(DEFAULT_HP / 2, DEFAULT_HP)));
+      PrintFormatted(session,
+                     "%s drinks a healing potion and regains %d hit points.\n",
+                     Capitalize(GetNameDefinite(session, p_gc)),
+                     HealGameCharacter(session, p_gc,
+                                       RandomInt(session, DEFAULT_HP / 2,
+                                                 DEFAULT_HP)));
       break;
     case FOOD:
-      printf("%s eats food and regains %d hit points.\n",
-             Capitalize(GetNameDefinite(p_gc)),
-             HealGameCharacter(p_gc,
-                               RandomInt(DEFAULT_HP / 4, DEFAULT_HP / 2)));
+      PrintFormatted(session, "%s eats food and regains %d hit points.\n",
+                     Capitalize(GetNameDefinite(session, p_gc)),
+                     HealGameCharacter(session, p_gc,
+                                       RandomInt(session, DEFAULT_HP / 4,
+                                                 DEFAULT_HP / 2)));
       break;
     default:
       PRINT_ERROR_MESSAGE;
       return FAILURE;
   }
-  p_gc->inventory[item]--;
-  FlushInput();
+  ChangeItemQuantity(session, p_gc, item, -1);
+  FlushInput(session);
 
   return SUCCESS;
 }
@@ -94,45 +99,46 @@ int UseItem(game_character_t *p_gc, int item) {
 Description: Prints the name and quantity of each item owned by a given game
              character. Indicates which, if any, are equipped.
 
-     Inputs: p_gc - Pointer to the game character of interest.
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character of interest.
 
     Outputs: Number of item types described (or -1 if an error is encountered).
 *******************************************************************************/
-int PrintInventory(game_character_t *p_gc) {
-  int i, num_item_types_described = 0;
+int PrintInventory(game_session_t *session, game_character_t *p_gc) {
+  int i;
+  item_stack_t *stack;
 
   if (p_gc == NULL) {
     PRINT_ERROR_MESSAGE;
     return -1;
   }
 
-  printf("Inventory: ");
-  for (i = 0; i < NUM_ITEM_TYPES; i++) {
-    if (p_gc->inventory[i] > 0) {
-      if (num_item_types_described > 0) {
-        printf(", ");
-        if (num_item_types_described % 3 == 0) {
-          printf("\n\t");
-        }
+  PrintFormatted(session, "Inventory: ");
+  for (i = 0; i < p_gc->details->inventory.count; i++) {
+    stack = GetItemStack(&p_gc->details->inventory, i);
+    if (i > 0) {
+      PrintFormatted(session, ", ");
+      if (i % 3 == 0) {
+        PrintFormatted(session, "\n\t");
       }
-      if (p_gc->inventory[i] == 1) {
-        printf("%s", GetItemName(i));
+    }
+    if (stack->quantity == 1) {
+      PrintFormatted(session, "%s", GetItemName(session, stack->type));
+    } else {
+      PrintFormatted(session, "%d %s", stack->quantity,
+                     GetItemNamePlural(session, stack->type));
+    }
+    if (stack->equipped > 0) {
+      if (stack->quantity == 1) {
+        PrintFormatted(session, "(equipped)");
       } else {
-        printf("%d %s", p_gc->inventory[i], GetItemNamePlural(i));
-      }
-      if (p_gc->equipped_items[i] > 0) {
-        if (p_gc->inventory[i] == 1) {
-          printf("(equipped)");
-        } else {
-          printf("(%d equipped)", p_gc->equipped_items[i]);
-        }
+        PrintFormatted(session, "(%d equipped)", stack->equipped);
       }
-      num_item_types_described++;
     }
   }
-  printf(".\n");
+  PrintFormatted(session, ".\n");
 
-  return num_item_types_described;
+  return p_gc->details->inventory.count;
 }
 
 /*******************************************************************************
@@ -140,12 +146,13 @@ int PrintInventory(game_character_t *p_gc) {
 
 Description: Given an item type, returns the name of that item.
 
-     Inputs: item - Integer representing the item of interest.
+     Inputs: session - Pointer to the current game session.
+             item    - Integer representing the item of interest.
 
     Outputs: The item's name as a pointer to an array of characters.
 *******************************************************************************/
-char *GetItemName(int item) {
-  static char itemName[SHORT_STR_LEN + 1];
+char *GetItemName(game_session_t *session, int item) {
+  char *itemName = session->item_name;
 
   switch (item) {
     case FOOD:
@@ -170,14 +177,15 @@ char *GetItemName(int item) {
 
 Description: Given an item type, returns the plural name of that item.
 
-     Inputs: item - Integer representing the item of interest.
+     Inputs: session - Pointer to the current game session.
+             item    - Integer representing the item of interest.
 
     Outputs: The item's plural name as a pointer to an array of characters.
 *******************************************************************************/
-char *GetItemNamePlural(int item) {
-  static char itemName[SHORT_STR_LEN + 1];
+char *GetItemNamePlural(game_session_t *session, int item) {
+  char *itemName = session->item_name_plural;
 
-  strcpy(itemName, GetItemName(item));
+  strcpy(itemName, GetItemName(session, item));
   if (item != FOOD) {
     strcat(itemName, "s");
   }
@@ -190,22 +198,25 @@ char *GetItemNamePlural(int item) {
 
 Description: Transfers gold from one game character to another.
 
-     Inputs: giver    - Pointer to the GC giving gold.
+     Inputs: session  - Pointer to the current game session.
+             giver    - Pointer to the GC giving gold.
              receiver - Pointer to the GC receiving gold.
              amount   - Amount of gold to be transferred.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int GiveGold(game_character_t *giver, game_character_t *receiver, int amount) {
-  if (giver == NULL || receiver == NULL || giver->gold < amount) {
+int GiveGold(game_session_t *session, game_character_t *giver,
+             game_character_t *receiver, int amount) {
+  if (giver == NULL || receiver == NULL || giver->details->gold < amount) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  giver->gold -= amount;
-  receiver->gold += amount;
-  printf("%s gives %d gold to %s.\n", giver->name, amount, receiver->name);
-  FlushInput();
+  giver->details->gold -= amount;
+  receiver->details->gold += amount;
+  PrintFormatted(session, "%s gives %d gold to %s.\n", giver->template->name,
+                 amount, receiver->template->name);
+  FlushInput(session);
 
   return SUCCESS;
 }
@@ -215,20 +226,23 @@ int GiveGold(game_character_t *giver, game_character_t *receiver, int amount) {
 
 Description: Adds a given item to a given game character's inventory.
 
-     Inputs: receiver - Pointer to the GC receiving the item.
+     Inputs: session  - Pointer to the current game session.
+             receiver - Pointer to the GC receiving the item.
              item     - Integer representing the type of item to be added.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int AddItem(game_character_t *receiver, int item) {
+int AddItem(game_session_t *session, game_character_t *receiver, int item) {
   if (receiver == NULL) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  receiver->inventory[item]++;
+  if (ChangeItemQuantity(session, receiver, item, 1) == FAILURE) {
+    return FAILURE;
+  }
   if (receiver->type == PLAYER) {
-    printf("You discover: %s\n", GetItemName(item));
+    PrintFormatted(session, "You discover: %s\n", GetItemName(session, item));
   }
 
   return SUCCESS;
@@ -239,28 +253,29 @@ int AddItem(game_character_t *receiver, int item) {
 
 Description: Transfers an item from one game character to another.
 
-     Inputs: giver    - Pointer to the GC giving the item.
+     Inputs: session  - Pointer to the current game session.
+             giver    - Pointer to the GC giving the item.
              receiver - Pointer to the GC receiving the item.
              item     - Integer representing the type of item to be given.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int GiveItem(game_character_t *giver, game_character_t *receiver, int item) {
-  if (giver == NULL || receiver == NULL || giver->inventory[item] <= 0) {
+int GiveItem(game_session_t *session, game_character_t *giver,
+             game_character_t *receiver, int item) {
+  if (giver == NULL ||
+      receiver == NULL ||
+      ItemQuantity(giver, item) <= 0) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  giver->inventory[item]--;
-  if (giver->equipped_items[item] > giver->inventory[item]) {
-    giver->equipped_items[item]--;
-  }
-  receiver->inventory[item]++;
-  printf("%s gives %s to %s\n",
-         giver->name,
-         GetItemName(item),
-         receiver->name);
-  FlushInput();
+  ChangeItemQuantity(session, giver, item, -1);
+  ChangeItemQuantity(session, receiver, item, 1);
+  PrintFormatted(session, "%s gives %s to %s\n",
+                 giver->template->name,
+                 GetItemName(session, item),
+                 receiver->template->name);
+  FlushInput(session);
 
   return SUCCESS;
 }
@@ -271,28 +286,30 @@ int GiveItem(game_character_t *giver, game_character_t *receiver, int item) {
 Description: Transfers a specified amount of a given item from one game
              character to another.
 
-     Inputs: giver    - Pointer to the GC giving the item.
+     Inputs: session  - Pointer to the current game session.
+             giver    - Pointer to the GC giving the item.
              receiver - Pointer to the GC receiving the item.
              item     - Integer representing the type of item to be given.
              amount   - Quantity of the item to be transferred.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int GiveItems(game_character_t *giver, game_character_t *receiver, int item,
+int GiveItems(game_session_t *session, game_character_t *giver,
+              game_character_t *receiver, int item,
               int amount) {
-  if (giver == NULL || receiver == NULL || giver->inventory[item] < amount) {
+  if (giver == NULL ||
+      receiver == NULL ||
+      ItemQuantity(giver, item) < amount) {
     PRINT_ERROR_MESSAGE;
     return FAILURE;
   }
 
-  giver->inventory[item] -= amount;
-  if (giver->equipped_items[item] > giver->inventory[item]) {
-    giver->equipped_items[item] = giver->inventory[item];
-  }
-  receiver->inventory[item] += amount;
-  printf("%s gives %d %s to %s.\n", giver->name, amount,
-         GetItemNamePlural(item), receiver->name);
-  FlushInput();
+  ChangeItemQuantity(session, giver, item, -amount);
+  ChangeItemQuantity(session, receiver, item, amount);
+  PrintFormatted(session, "%s gives %d %s to %s.\n", giver->template->name,
+                 amount, GetItemNamePlural(session, item),
+                 receiver->template->name);
+  FlushInput(session);
 
   return SUCCESS;
 }
@@ -302,12 +319,13 @@ int GiveItems(game_character_t *giver, game_character_t *receiver, int item,
 
 Description: Returns the standard market value of a given item.
 
-     Inputs: item - Integer representing the item of interest.
+     Inputs: session - Pointer to the current game session.
+             item    - Integer representing the item of interest.
 
     Outputs: The standard market value of the item of interest (or -1 if an
              error is encountered).
 *******************************************************************************/
-int GetItemValue(int item) {
+int GetItemValue(game_session_t *session, int item) {
   switch (item) {
     case FOOD:
       return 1;
@@ -322,3 +340,156 @@ int GetItemValue(int item) {
 
   return -1;
 }
+
+/*******************************************************************************
+   Function: ItemQuantity
+
+Description: Returns the number of items of a given type that a given game
+             character owns (including any that are equipped).
+
+     Inputs: p_gc - Pointer to the game character of interest.
+             item - Integer representing the item type of interest.
+
+    Outputs: The number of such items owned.
+*******************************************************************************/
+int ItemQuantity(game_character_t *p_gc, int item) {
+  inventory_t *inventory = &p_gc->details->inventory;
+  int index = FindItemStack(inventory, item);
+
+  if (index < inventory->count &&
+      GetItemStack(inventory, index)->type == item) {
+    return GetItemStack(inventory, index)->quantity;
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+   Function: ChangeItemQuantity
+
+Description: Adds items of a given type to, or removes them from, a given game
+             character's inventory (with no accompanying message). A stack is
+             created for the first item of its type and removed with the last;
+             removed items are unequipped as needed.
+
+     Inputs: session - Pointer to the current game session.
+             p_gc    - Pointer to the game character of interest.
+             item    - Integer representing the type of item.
+             change  - Number of items to add (or, if negative, remove).
+
+    Outputs: SUCCESS or FAILURE (e.g., too few items to remove).
+*******************************************************************************/
+int ChangeItemQuantity(game_session_t *session, game_character_t *p_gc,
+                       int item, int change) {
+  int i, index, new_capacity;
+  inventory_t *inventory;
+  item_stack_t *stack, *new_overflow;
+
+  if (p_gc == NULL || item < 0 || item >= NUM_ITEM_TYPES) {
+    PRINT_ERROR_MESSAGE;
+    return FAILURE;
+  }
+  inventory = &p_gc->details->inventory;
+  index = FindItemStack(inventory, item);
+
+  // Adjust an existing stack, removing it if it becomes empty:
+  if (index < inventory->count &&
+      GetItemStack(inventory, index)->type == item) {
+    stack = GetItemStack(inventory, index);
+    if (stack->quantity + change < 0) {
+      PRINT_ERROR_MESSAGE;
+      return FAILURE;
+    }
+    stack->quantity += change;
+    if (stack->equipped > stack->quantity) {
+      stack->equipped = stack->quantity;
+    }
+    if (stack->quantity == 0) {
+      for (i = index + 1; i < inventory->count; i++) {
+        *GetItemStack(inventory, i - 1) = *GetItemStack(inventory, i);
+      }
+      inventory->count--;
+    }
+    return SUCCESS;
+  } else if (change < 0) {
+    PRINT_ERROR_MESSAGE;
+    return FAILURE;
+  } else if (change == 0) {
+    return SUCCESS;
+  }
+
+  // Otherwise, insert a new stack (growing the overflow array if it's full):
+  if (inventory->count == INLINE_ITEM_STACKS + inventory->overflow_capacity) {
+    new_capacity = inventory->overflow_capacity > 0 ?
+                   inventory->overflow_capacity * 2 : INLINE_ITEM_STACKS;
+    new_overflow = ArenaAllocate(&session->details_arena,
+                                 new_capacity * sizeof(item_stack_t));
+    if (new_overflow == NULL) {
+      PRINT_ERROR_MESSAGE;
+      exit(1);
+    }
+    if (inventory->overflow_capacity > 0) {
+      memcpy(new_overflow, inventory->overflow,
+             inventory->overflow_capacity * sizeof(item_stack_t));
+    }
+    inventory->overflow = new_overflow;
+    inventory->overflow_capacity = new_capacity;
+  }
+  for (i = inventory->count; i > index; i--) {
+    *GetItemStack(inventory, i) = *GetItemStack(inventory, i - 1);
+  }
+  inventory->count++;
+  stack = GetItemStack(inventory, index);
+  stack->type = item;
+  stack->equipped = 0;
+  stack->quantity = change;
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: GetItemStack
+
+Description: Returns one of the item stacks in an inventory, whether it is
+             stored inline or in the overflow array.
+
+     Inputs: inventory - Pointer to the inventory of interest.
+             index     - Position of the stack of interest (0 to "count" - 1,
+                         or "count" if space for one more has been reserved).
+
+    Outputs: Pointer to the item stack.
+*******************************************************************************/
+item_stack_t *GetItemStack(inventory_t *inventory, int index) {
+  if (index < INLINE_ITEM_STACKS) {
+    return &inventory->stacks[index];
+  }
+
+  return &inventory->overflow[index - INLINE_ITEM_STACKS];
+}
+
+/*******************************************************************************
+   Function: FindItemStack
+
+Description: Searches an inventory (via binary search) for the stack of a given
+             item type.
+
+     Inputs: inventory - Pointer to the inventory of interest.
+             item      - Integer representing the item type of interest.
+
+    Outputs: Position of the item type's stack if there is one; otherwise, the
+             position at which such a stack would be inserted.
+*******************************************************************************/
+int FindItemStack(inventory_t *inventory, int item) {
+  int low = 0, high = inventory->count, middle;
+
+  while (low < high) {
+    middle = (low + high) / 2;
+    if (GetItemStack(inventory, middle)->type < item) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  return low;
+}
@@ -13,159 +13,198 @@ Description: Functions governing magic for the text-based RPG "Words of Power."
 
 Description: Takes the player through the process of selecting targets and
              creating a spell sequence. (The spell's effects are then processed
-             via "CastSpell()".)
+             via "CastSpell(session)".)
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int HandleSpellMenuInput(void) {
-  int i, input, temp, spell_length, num_targets = 0;
+int HandleSpellMenuInput(game_session_t *session) {
+  int i, input, temp, spell_length, num_targets = 0, max_targets;
   bool repeat_options;
   char spell[MAX_SPELL_LEN + 1];
-  game_character_t *p_gc, *targets[MAX_TARGETS];
+  game_character_t *p_gc;
+  character_handle_t *targets;
+  arena_mark_t mark;
 
     /* --STATUS CHECK-- */
 
-  if (g_player.status[SILENCED]) {
-    printf("You have been silenced and cannot cast spells at this time.\n");
-    FlushInput();
+  if (session->player.status[SILENCED]) {
+    PrintFormatted(session,
+                   "You have been silenced and cannot cast spells at this "
+                   "time.\n");
+    FlushInput(session);
 
     return FAILURE;
   }
 
     /* --SELECTION OF TARGET(S)-- */
 
-  printf("Select a target:\n");
-  UpdateVisibleGameCharCounter();
-  for (i = 0; i < MAX_TARGETS; i++) {
-    targets[i] = NULL;
+  // Make room for everyone who could be targeted, plus a "NO_CHARACTER" to
+  // end the list (myself and my summoned creature are counted here):
+  max_targets = 3;
+  for (p_gc = GetCharacter(session, session->player.next);
+       p_gc != NULL;
+       p_gc = GetCharacter(session, p_gc->next)) {
+    max_targets++;
   }
+  if (session->player.status[IN_COMBAT]) {
+    max_targets += NumberOfEnemies(session);
+  } else {
+    for (p_gc = FirstLocalInhabitant(session);
+         p_gc != NULL;
+         p_gc = GetCharacter(session, p_gc->next)) {
+      max_targets++;
+    }
+  }
+  mark = ArenaMark(&session->scratch);
+  targets = ArenaAllocate(&session->scratch,
+                          max_targets * sizeof(character_handle_t));
+  if (targets == NULL) {
+    PRINT_ERROR_MESSAGE;
+    return FAILURE;
+  }
+  for (i = 0; i < max_targets; i++) {
+    targets[i] = NO_CHARACTER;
+  }
+
+  PrintFormatted(session, "Select a target:\n");
+  UpdateVisibleGameCharCounter(session);
   do {
     temp = 0;
     for (i = 0; i < NUM_GC_TYPES; i++) {
-      g_character_type_described[i] = false;
+      session->character_type_described[i] = false;
     }
-    if (CanCastBeneficialSpells(&g_player)) {
-      if (IsTargeted(&g_player, targets) == false) {
-        printf("[%d] Myself\n", ++temp);
+    if (CanCastBeneficialSpells(&session->player)) {
+      if (IsTargeted(&session->player, targets) == false) {
+        PrintFormatted(session, "[%d] Myself\n", ++temp);
       }
-      if (g_player.summoned_creature != NULL &&
-          IsTargeted(g_player.summoned_creature, targets) == false) {
-        printf("[%d] My summoned %s\n", ++temp, p_gc->descriptor);
+      p_gc = GetCharacter(session, session->player.summoned_creature);
+      if (p_gc != NULL && IsTargeted(p_gc, targets) == false) {
+        PrintFormatted(session, "[%d] My summoned %s\n", ++temp,
+                       p_gc->template->descriptor);
       }
-      for (p_gc = g_player.next;
+      for (p_gc = GetCharacter(session, session->player.next);
            p_gc != NULL && IsTargeted(p_gc, targets) == false;
-           p_gc = p_gc->next) {
-        printf("[%d] My companion, %s\n", ++temp, GetNameDefinite(p_gc));
+           p_gc = GetCharacter(session, p_gc->next)) {
+        PrintFormatted(session, "[%d] My companion, %s\n", ++temp,
+                       GetNameDefinite(session, p_gc));
       }
     }
-    if (g_player.status[IN_COMBAT]) {  // Combat mode: display enemies.
-      for (i = 0; i < NumberOfEnemies(); i++) {
-        if (g_enemies[i]->status[INVISIBLE] == false &&
-            IsTargeted(g_enemies[i], targets) == false &&
-            g_character_type_described[g_enemies[i]->type] == false) {
-          if (g_num_visible_of_type[g_enemies[i]->type] > 1) {
-            printf("[%d] %s (%d available)\n", ++temp, g_enemies[i]->name,
-                   g_num_visible_of_type[g_enemies[i]->type]);
+    if (session->player.status[IN_COMBAT]) {  // Combat mode: display enemies.
+      for (i = 0; i < NumberOfEnemies(session); i++) {
+        if (GetEnemy(session, i)->status[INVISIBLE] == false &&
+            IsTargeted(GetEnemy(session, i), targets) == false &&
+            session->character_type_described[
+                GetEnemy(session, i)->type] == false) {
+          if (session->num_visible_of_type[GetEnemy(session, i)->type] > 1) {
+            PrintFormatted(session, "[%d] %s (%d available)\n", ++temp,
+                           GetEnemy(session, i)->template->name,
+                           session->num_visible_of_type[
+                               GetEnemy(session, i)->type]);
           } else {
-            printf("[%d] %s\n", ++temp, g_enemies[i]->name);
+            PrintFormatted(session, "[%d] %s\n", ++temp,
+                           GetEnemy(session, i)->template->name);
           }
-          g_character_type_described[g_enemies[i]->type] = true;
+          session->character_type_described[GetEnemy(session, i)->type] = true;
         }
       }
     } else {  // Not in combat mode: display local inhabitants.
-      for (p_gc = g_world[g_player.location]->inhabitants;
+      for (p_gc = FirstLocalInhabitant(session);
            p_gc != NULL;
-           p_gc = p_gc->next) {
+           p_gc = GetCharacter(session, p_gc->next)) {
         if (p_gc->status[INVISIBLE] == false &&
             IsTargeted(p_gc, targets) == false &&
-            g_character_type_described[p_gc->type] == false) {
-          if (g_num_visible_of_type[p_gc->type] > 1) {
-            printf("[%d] %s (%d available)\n", ++temp, p_gc->name,
-                   g_num_visible_of_type[p_gc->type]);
+            session->character_type_described[p_gc->type] == false) {
+          if (session->num_visible_of_type[p_gc->type] > 1) {
+            PrintFormatted(session, "[%d] %s (%d available)\n", ++temp,
+                           p_gc->template->name,
+                           session->num_visible_of_type[p_gc->type]);
           } else {
-            printf("[%d] %s\n", ++temp, p_gc->name);
+            PrintFormatted(session, "[%d] %s\n", ++temp, p_gc->template->name);
           }
-          g_character_type_described[p_gc->type] = true;
+          session->character_type_described[p_gc->type] = true;
         }
       }
     }
     if (temp == 0) {
-      printf("There is nobody here to target for a spell.\n");
-      FlushInput();
+      PrintFormatted(session, "There is nobody here to target for a spell.\n");
+      FlushInput(session);
+      ArenaRelease(&session->scratch, mark);
       return FAILURE;
     }
 
     // Player chooses a target by number:
-    GetIntInput(&input, 1, temp);
+    GetIntInput(session, &input, 1, temp);
 
     // The target is now found by matching it with the input:
     temp = 0;
     for (i = 0; i < NUM_GC_TYPES; i++) {
-      g_character_type_described[i] = false;
+      session->character_type_described[i] = false;
     }
-    if (CanCastBeneficialSpells(&g_player)) {
-      if (IsTargeted(&g_player, targets) == false) {
+    if (CanCastBeneficialSpells(&session->player)) {
+      if (IsTargeted(&session->player, targets) == false) {
         temp++;
         if (temp == input) {
-          targets[num_targets] = &g_player;
+          targets[num_targets] = session->player.handle;
           goto TargetFound;
         }
       }
-      if (g_player.summoned_creature != NULL &&
-          IsTargeted(g_player.summoned_creature, targets) == false) {
+      p_gc = GetCharacter(session, session->player.summoned_creature);
+      if (p_gc != NULL && IsTargeted(p_gc, targets) == false) {
         temp++;
         if (temp == input) {
-          targets[num_targets] = g_player.summoned_creature;
+          targets[num_targets] = p_gc->handle;
           goto TargetFound;
         }
       }
-      for (p_gc = g_player.next;
+      for (p_gc = GetCharacter(session, session->player.next);
            p_gc != NULL && IsTargeted(p_gc, targets) == false;
-           p_gc = p_gc->next) {
+           p_gc = GetCharacter(session, p_gc->next)) {
         temp++;
         if (temp == input) {
-          targets[num_targets] = p_gc;
+          targets[num_targets] = p_gc->handle;
           goto TargetFound;
         }
       }
     }
-    if (g_player.status[IN_COMBAT]) {  // Combat mode: search through enemies.
-      for (i = 0; i < NumberOfEnemies(); i++) {
-        if (g_enemies[i]->status[INVISIBLE] == false &&
-            IsTargeted(g_enemies[i], targets) == false &&
-            g_character_type_described[g_enemies[i]->type] == false) {
+    if (session->player.status[IN_COMBAT]) {  // Combat mode: search enemies.
+      for (i = 0; i < NumberOfEnemies(session); i++) {
+        if (GetEnemy(session, i)->status[INVISIBLE] == false &&
+            IsTargeted(GetEnemy(session, i), targets) == false &&
+            session->character_type_described[
+                GetEnemy(session, i)->type] == false) {
           temp++;
           if (temp == input) {
-            targets[num_targets] = g_enemies[i];
-            g_num_visible_of_type[g_enemies[i]->type]--;  // For counting.
+            targets[num_targets] = session->enemies[i];
+            // For counting purposes:
+            session->num_visible_of_type[GetEnemy(session, i)->type]--;
             goto TargetFound;
           }
-          g_character_type_described[g_enemies[i]->type] = true;
+          session->character_type_described[GetEnemy(session, i)->type] = true;
         }
       }
     } else {  // Not in combat mode: search through local inhabitants.
-      for (p_gc = g_world[g_player.location]->inhabitants;
+      for (p_gc = FirstLocalInhabitant(session);
            p_gc != NULL;
-           p_gc = p_gc->next) {
+           p_gc = GetCharacter(session, p_gc->next)) {
         if (p_gc->status[INVISIBLE] == false &&
             IsTargeted(p_gc, targets) == false &&
-            g_character_type_described[p_gc->type] == false) {
-          targets[num_targets] = g_enemies[i];
+            session->character_type_described[p_gc->type] == false) {
           temp++;
           if (temp == input) {
-            targets[num_targets] = p_gc;
-            g_num_visible_of_type[p_gc->type]--;  // For counting purposes.
+            targets[num_targets] = p_gc->handle;
+            session->num_visible_of_type[p_gc->type]--;  // For counting.
             goto TargetFound;
           }
-          g_character_type_described[p_gc->type] = true;
+          session->character_type_described[p_gc->type] = true;
         }
       }
     }
 
     // If we reach this point, the target was not found.
     PRINT_ERROR_MESSAGE;
+    ArenaRelease(&session->scratch, mark);
     return FAILURE;
 
     // If the target was found, we will have jumped to the following line. */
@@ -176,17 +215,17 @@ int HandleSpellMenuInput(void) {
     // Check for remaining legal targets:
     /*temp = 0;
     for (i = 0; i < NUM_GC_TYPES; i++) {
-      temp += g_num_visible_of_type[i];
+      temp += session->num_visible_of_type[i];
     }
     if (temp == 0) {
       repeat_options = false;
     } else {
       do {
         repeat_options = false;
-        printf("Do you wish to select another target? (Y/N) ");
-        GetCharInput(&input);
+        PrintFormatted(session, "Do you wish to select another target? (Y/N) ");
+        GetCharInput(session, &input);
         if (input != 'Y' && input != 'N') {
-          printf("Invalid response. ");
+          PrintFormatted(session, "Invalid response. ");
           repeat_options = true;
         }
       }while (repeat_options);
@@ -195,31 +234,40 @@ int HandleSpellMenuInput(void) {
       }
     }*/
   }while (repeat_options);  // Until the player's finished selecting targets.
-  UpdateVisibleGameCharCounter();
+  UpdateVisibleGameCharCounter(session);
 
     /* --CREATION OF SPELL SEQUENCE-- */
 
-  printf("Use the letters indicated to create a spell sequence of up to %d "
-         "letters\n(letters may be used more than once):\n", MAX_SPELL_LEN);
-  PrintKnownWords();
+  PrintFormatted(session,
+                 "Use the letters indicated to create a spell sequence of up "
+                 "to %d letters\n(letters may be used more than once):\n",
+                 MAX_SPELL_LEN);
+  PrintKnownWords(session);
   do {
     repeat_options = false;
-    GetStrInput(spell, MAX_SPELL_LEN + 1);
+    GetStrInput(session, spell, MAX_SPELL_LEN + 1);
     spell_length = strlen(spell);
     for (i = 0; i < spell_length; i++) {
       spell[i] = toupper(spell[i]);
-      if (GetWordTypeFromChar(spell[i]) < 0 ||
-          g_player.words[GetWordTypeFromChar(spell[i])] == UNKNOWN) {
-        printf("Invalid spell sequence. Please try again: ");
+      if (GetWordTypeFromChar(session, spell[i]) < 0 ||
+          ((session->player.template->known_words |
+            session->player.template->partially_known_words) &
+           WORD_BIT(GetWordTypeFromChar(session, spell[i]))) == 0) {
+        PrintFormatted(session, "Invalid spell sequence. Please try again: ");
         repeat_options = true;
         i = spell_length;
       }
     }
-  }while (repeat_options);
+  }while (repeat_options && !GameInterrupted(session));
+  if (GameInterrupted(session)) {
+    ArenaRelease(&session->scratch, mark);
+    return FAILURE;
+  }
 
     /* --CASTING OF SPELL-- */
 
-  CastSpell(&g_player, spell, targets);
+  CastSpell(session, &session->player, spell, targets);
+  ArenaRelease(&session->scratch, mark);
 
   return SUCCESS;
 }
@@ -229,24 +277,27 @@ int HandleSpellMenuInput(void) {
 
 Description: Carries out a spell's effects (if any) and reports them.
 
-     Inputs: spellcaster - Pointer to the caster of the spell.
+     Inputs: session     - Pointer to the current game session.
+             spellcaster - Pointer to the caster of the spell.
              spell       - String of letters, each representing a Word of Power.
-             targets     - Array of pointers to targeted game characters.
+             targets     - Array of handles of targeted game characters,
+                           ending with NO_CHARACTER.
 
     Outputs: SUCCESS or FAILURE.
 *******************************************************************************/
-int CastSpell(game_character_t *spellcaster, char *spell,
-              game_character_t *targets[]) {
+int CastSpell(game_session_t *session, game_character_t *spellcaster,
+              char *spell,
+              character_handle_t targets[]) {
   bool light = false, dark = false, holy = false, evil = false, giving = false,
        taking = false, increase = false, decrease = false, life = false,
        death = false, shield = false, counter = false, balance = false;
-  int i, num_targets, spell_length, fire_value = 0, water_value = 0,
-      air_value = 0, earth_value = 0, damage = 0, backlash_value = 0;
-  game_character_t *p_gc;  // To search through lists of game characters.
+  int i, num_targets, num_hits = 0, spell_length, fire_value = 0,
+      water_value = 0, air_value = 0, earth_value = 0, backlash_value = 0;
+  hit_t *hits;
+  game_character_t *target, **defenders;
+  arena_mark_t mark;
 
-  for (num_targets = 0;
-       num_targets < MAX_TARGETS && targets[num_targets] != NULL;
-       num_targets++)
+  for (num_targets = 0; targets[num_targets] != NO_CHARACTER; num_targets++)
     ;
   spell_length = strlen(spell);
   if (spellcaster == NULL || num_targets == 0 || spell_length == 0) {
@@ -254,235 +305,291 @@ int CastSpell(game_character_t *spellcaster, char *spell,
     return FAILURE;
   }
 
-  printf("%s: \"", spellcaster->name);
+  PrintFormatted(session, "%s: \"", spellcaster->template->name);
   for (i = 0; i < spell_length; i++) {
-    printf("%s", GetWordStartingWith(spell[i]));
+    PrintFormatted(session, "%s", GetWordStartingWith(session, spell[i]));
     if (i < spell_length - 1) {
-      printf("-");
+      PrintFormatted(session, "-");
     } else {
-      printf("!\"\n\n");
+      PrintFormatted(session, "!\"\n\n");
     }
   }
 
   if (strcmp(spell, "B") == 0) {
-    printf("Fire bursts forth from your outstretched hand!\n");
-    fire_value = RandomInt(1, spellcaster->mental_power / 4);
+    PrintFormatted(session, "Fire bursts forth from your outstretched hand!\n");
+    fire_value = RandomInt(session, 1, spellcaster->mental_power / 4);
   } else if (strcmp(spell, "BB") == 0) {
-    printf("Fire bursts forth from your outstretched hand!\n");
-    fire_value = RandomInt(spellcaster->mental_power / 4,
-                          spellcaster->mental_power / 2);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session, "Fire bursts forth from your outstretched hand!\n");
+    fire_value = RandomInt(session, spellcaster->mental_power / 4,
+                           spellcaster->mental_power / 2);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 10);
   } else if (strcmp(spell, "BBB") == 0) {
-    printf("Fire bursts forth from your outstretched hand!\n");
-    fire_value = RandomInt(spellcaster->mental_power / 2,
+    PrintFormatted(session, "Fire bursts forth from your outstretched hand!\n");
+    fire_value = RandomInt(session, spellcaster->mental_power / 2,
                            (spellcaster->mental_power * 3) / 4);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 5);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 5);
   } else if (strcmp(spell, "BBBB") == 0) {
-    printf("Fire bursts forth from your outstretched hand!\n");
-    fire_value = RandomInt(1, spellcaster->mental_power);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 3);
+    PrintFormatted(session, "Fire bursts forth from your outstretched hand!\n");
+    fire_value = RandomInt(session, 1, spellcaster->mental_power);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 3);
   } else if (strcmp(spell, "S") == 0) {
-    printf("An overpowering stream of water bursts forth from your "
-           "outstretched hand!\n");
-    water_value = RandomInt(1, spellcaster->mental_power / 4);
+    PrintFormatted(session,
+                   "An overpowering stream of water bursts forth from your "
+                   "outstretched hand!\n");
+    water_value = RandomInt(session, 1, spellcaster->mental_power / 4);
   } else if (strcmp(spell, "SS") == 0) {
-    printf("An overpowering stream of water bursts forth from your "
-           "outstretched hand!\n");
-    water_value = RandomInt(spellcaster->mental_power / 4,
-                           spellcaster->mental_power / 2);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session,
+                   "An overpowering stream of water bursts forth from your "
+                   "outstretched hand!\n");
+    water_value = RandomInt(session, spellcaster->mental_power / 4,
+                            spellcaster->mental_power / 2);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 10);
   } else if (strcmp(spell, "SSS") == 0) {
-    printf("An overpowering stream of water bursts forth from your "
-           "outstretched hand!\n");
-    water_value = RandomInt(spellcaster->mental_power / 2,
+    PrintFormatted(session,
+                   "An overpowering stream of water bursts forth from your "
+                   "outstretched hand!\n");
+    water_value = RandomInt(session, spellcaster->mental_power / 2,
                             (spellcaster->mental_power * 3) / 4);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 5);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 5);
   } else if (strcmp(spell, "SSSS") == 0) {
-    printf("An overpowering stream of water bursts forth from your "
-           "outstretched hand!\n");
-    water_value = RandomInt(1, spellcaster->mental_power);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 3);
+    PrintFormatted(session,
+                   "An overpowering stream of water bursts forth from your "
+                   "outstretched hand!\n");
+    water_value = RandomInt(session, 1, spellcaster->mental_power);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 3);
   } else if (strcmp(spell, "P") == 0) {
-    printf("A rain of stones bursts forth from your outstretched hand!\n");
-    earth_value = RandomInt(1, spellcaster->mental_power / 4);
+    PrintFormatted(session,
+                   "A rain of stones bursts forth from your outstretched "
+                   "hand!\n");
+    earth_value = RandomInt(session, 1, spellcaster->mental_power / 4);
   } else if (strcmp(spell, "PP") == 0) {
-    printf("A rain of stones bursts forth from your outstretched hand!\n");
-    earth_value = RandomInt(spellcaster->mental_power / 4,
-                           spellcaster->mental_power / 2);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session,
+                   "A rain of stones bursts forth from your outstretched "
+                   "hand!\n");
+    earth_value = RandomInt(session, spellcaster->mental_power / 4,
+                            spellcaster->mental_power / 2);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 10);
   } else if (strcmp(spell, "PPP") == 0) {
-    printf("A rain of stones bursts forth from your outstretched hand!\n");
-    earth_value = RandomInt(spellcaster->mental_power / 2,
+    PrintFormatted(session,
+                   "A rain of stones bursts forth from your outstretched "
+                   "hand!\n");
+    earth_value = RandomInt(session, spellcaster->mental_power / 2,
                             (spellcaster->mental_power * 3) / 4);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 5);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 5);
   } else if (strcmp(spell, "PPPP") == 0) {
-    printf("A rain of stones bursts forth from your outstretched hand!\n");
-    earth_value = RandomInt(8, 16) * spellcaster->mental_power;
-    backlash_value = RandomInt(0, spellcaster->mental_power / 3);
+    PrintFormatted(session,
+                   "A rain of stones bursts forth from your outstretched "
+                   "hand!\n");
+    earth_value = RandomInt(session, 8, 16) * spellcaster->mental_power;
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 3);
   } else if (strcmp(spell, "E") == 0) {
-    printf("An overpowering gust of wind bursts forth from your outstretched "
-           "hand!\n");
-    air_value = RandomInt(1, spellcaster->mental_power / 4);
+    PrintFormatted(session,
+                   "An overpowering gust of wind bursts forth from your "
+                   "outstretched hand!\n");
+    air_value = RandomInt(session, 1, spellcaster->mental_power / 4);
   } else if (strcmp(spell, "EE") == 0) {
-    printf("An overpowering gust of wind bursts forth from your outstretched "
-           "hand!\n");
-    air_value = RandomInt(spellcaster->mental_power / 4,
-                         spellcaster->mental_power / 2);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session,
+                   "An overpowering gust of wind bursts forth from your "
+                   "outstretched hand!\n");
+    air_value = RandomInt(session, spellcaster->mental_power / 4,
+                          spellcaster->mental_power / 2);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 10);
   } else if (strcmp(spell, "EEE") == 0) {
-    printf("An overpowering gust of wind bursts forth from your outstretched "
-           "hand!\n");
-    air_value = RandomInt(spellcaster->mental_power / 2,
+    PrintFormatted(session,
+                   "An overpowering gust of wind bursts forth from your "
+                   "outstretched hand!\n");
+    air_value = RandomInt(session, spellcaster->mental_power / 2,
                           (spellcaster->mental_power * 3) / 4);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 5);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 5);
   } else if (strcmp(spell, "EEEE") == 0) {
-    printf("An overpowering gust of wind bursts forth from your outstretched "
-           "hand!\n");
-    air_value = RandomInt(1, spellcaster->mental_power);
-    backlash_value = RandomInt(0, spellcaster->mental_power / 3);
+    PrintFormatted(session,
+                   "An overpowering gust of wind bursts forth from your "
+                   "outstretched hand!\n");
+    air_value = RandomInt(session, 1, spellcaster->mental_power);
+    backlash_value = RandomInt(session, 0, spellcaster->mental_power / 3);
   } else if (spell_length == 4 &&
              StrContains(spell, 'E') &&
              StrContains(spell, 'S') &&
              StrContains(spell, 'P') &&
              StrContains(spell, 'B')) {
-    printf("A colorful spray of elemental energies bursts forth from your "
-           "outstretched hand!\n");
-    air_value = RandomInt(1, spellcaster->mental_power / 4);
-    water_value = RandomInt(1, spellcaster->mental_power / 4);
-    earth_value = RandomInt(1, spellcaster->mental_power / 4);
-    fire_value = RandomInt(1, spellcaster->mental_power / 4);
+    PrintFormatted(session,
+                   "A colorful spray of elemental energies bursts forth from "
+                   "your outstretched hand!\n");
+    air_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    water_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    earth_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    fire_value = RandomInt(session, 1, spellcaster->mental_power / 4);
     for (i = 0; i < 3; i++) {
-      backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+      backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
     }
   } else if (spell_length == 3 &&
              StrContains(spell, 'S') &&
              StrContains(spell, 'P') &&
              StrContains(spell, 'B')) {
-    printf("A colorful spray of elemental energies bursts forth from your "
-           "outstretched hand!\n");
-    water_value = RandomInt(1, spellcaster->mental_power / 4);
-    earth_value = RandomInt(1, spellcaster->mental_power / 4);
-    fire_value = RandomInt(1, spellcaster->mental_power / 4);
+    PrintFormatted(session,
+                   "A colorful spray of elemental energies bursts forth from "
+                   "your outstretched hand!\n");
+    water_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    earth_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    fire_value = RandomInt(session, 1, spellcaster->mental_power / 4);
     for (i = 0; i < 2; i++) {
-      backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+      backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
     }
   } else if (spell_length == 3 &&
              StrContains(spell, 'E') &&
              StrContains(spell, 'S') &&
              StrContains(spell, 'B')) {
-    printf("A colorful spray of elemental energies bursts forth from your "
-           "outstretched hand!\n");
-    air_value = RandomInt(1, spellcaster->mental_power / 4);
-    water_value = RandomInt(1, spellcaster->mental_power / 4);
-    fire_value = RandomInt(1, spellcaster->mental_power / 4);
+    PrintFormatted(session,
+                   "A colorful spray of elemental energies bursts forth from "
+                   "your outstretched hand!\n");
+    air_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    water_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    fire_value = RandomInt(session, 1, spellcaster->mental_power / 4);
     for (i = 0; i < 2; i++) {
-      backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+      backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
     }
   } else if (spell_length == 3 &&
              StrContains(spell, 'E') &&
              StrContains(spell, 'S') &&
              StrContains(spell, 'P')) {
-    printf("A colorful spray of elemental energies bursts forth from your "
-           "outstretched hand!\n");
-    air_value = RandomInt(1, spellcaster->mental_power / 4);
-    water_value = RandomInt(1, spellcaster->mental_power / 4);
-    earth_value = RandomInt(1, spellcaster->mental_power / 4);
+    PrintFormatted(session,
+                   "A colorful spray of elemental energies bursts forth from "
+                   "your outstretched hand!\n");
+    air_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    water_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    earth_value = RandomInt(session, 1, spellcaster->mental_power / 4);
     for (i = 0; i < 2; i++)
     {
-      backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+      backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
     }
   } else if (spell_length == 3 &&
              StrContains(spell, 'E') &&
              StrContains(spell, 'P') &&
              StrContains(spell, 'B')) {
-    printf("A colorful spray of elemental energies bursts forth from your "
-           "outstretched hand!\n");
-    air_value = RandomInt(1, spellcaster->mental_power / 4);
-    earth_value = RandomInt(1, spellcaster->mental_power / 4);
-    fire_value = RandomInt(1, spellcaster->mental_power / 4);
+    PrintFormatted(session,
+                   "A colorful spray of elemental energies bursts forth from "
+                   "your outstretched hand!\n");
+    air_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    earth_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    fire_value = RandomInt(session, 1, spellcaster->mental_power / 4);
     for (i = 0; i < 2; i++) {
-      backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+      backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
     }
   } else if (strcmp(spell, "BS") == 0 || strcmp(spell, "SB") == 0) {
-    printf("A blast of boiling water sprays forth from your outstretched "
-           "hand!\n");
-    water_value = RandomInt(1, spellcaster->mental_power / 4);
-    fire_value = RandomInt(1, spellcaster->mental_power / 4);
-    backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session,
+                   "A blast of boiling water sprays forth from your "
+                   "outstretched hand!\n");
+    water_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    fire_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
   } else if (strcmp(spell, "ES") == 0 || strcmp(spell, "SE") == 0) {
-    printf("Shards of ice burst forth from your outstretched hand!\n");
-    water_value = RandomInt(1, spellcaster->mental_power / 4);
-    air_value = RandomInt(1, spellcaster->mental_power / 4);
-    backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session,
+                   "Shards of ice burst forth from your outstretched hand!\n");
+    water_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    air_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
   } else if (strcmp(spell, "BE") == 0 || strcmp(spell, "EB") == 0) {
-    printf("A bolt of lightning shoots forth from your outstretched hand!\n");
-    air_value = RandomInt(1, spellcaster->mental_power / 4);
-    fire_value = RandomInt(1, spellcaster->mental_power / 4);
-    backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session,
+                   "A bolt of lightning shoots forth from your outstretched "
+                   "hand!\n");
+    air_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    fire_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
   } else if (strcmp(spell, "BP") == 0 || strcmp(spell, "PB") == 0) {
-    printf("A stream of lava sprays forth from your outstretched hand!\n");
-    earth_value = RandomInt(1, spellcaster->mental_power / 4);
-    fire_value = RandomInt(1, spellcaster->mental_power / 4);
-    backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session,
+                   "A stream of lava sprays forth from your outstretched "
+                   "hand!\n");
+    earth_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    fire_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
   } else if (strcmp(spell, "SP") == 0 || strcmp(spell, "PS") == 0) {
-    printf("A stream of acid sprays forth from your outstretched hand!\n");
-    water_value = RandomInt(1, spellcaster->mental_power / 4);
-    earth_value = RandomInt(1, spellcaster->mental_power / 4);
-    backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session,
+                   "A stream of acid sprays forth from your outstretched "
+                   "hand!\n");
+    water_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    earth_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
   } else if (strcmp(spell, "EP") == 0 || strcmp(spell, "PE") == 0) {
-    printf("A debris-filled whirlwind bursts forth from your outstretched "
-           "hand!\n");
-    air_value = RandomInt(1, spellcaster->mental_power / 4);
-    earth_value = RandomInt(1, spellcaster->mental_power / 4);
-    backlash_value += RandomInt(0, spellcaster->mental_power / 10);
+    PrintFormatted(session,
+                   "A debris-filled whirlwind bursts forth from your "
+                   "outstretched hand!\n");
+    air_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    earth_value = RandomInt(session, 1, spellcaster->mental_power / 4);
+    backlash_value += RandomInt(session, 0, spellcaster->mental_power / 10);
   } else {
-    printf("Nothing happens.\n");
-    FlushInput();
+    PrintFormatted(session, "Nothing happens.\n");
+    FlushInput(session);
     return SUCCESS;
   }
-  for (i = 0; i < num_targets && targets[i] != NULL; i++) {
-    damage = fire_value + water_value + earth_value + air_value;
-    damage -= RandomInt(0, targets[i]->physical_defense / 10);
-    if (damage <= 0) {
-      printf("%s resists all damage.\n", targets[i]->name);
+
+  // Resolve the damage to all targets at once, then report the results:
+  mark = ArenaMark(&session->scratch);
+  hits = ArenaAllocate(&session->scratch, num_targets * sizeof(hit_t));
+  defenders = ArenaAllocate(&session->scratch,
+                            num_targets * sizeof(game_character_t *));
+  if (hits == NULL || defenders == NULL) {
+    PRINT_ERROR_MESSAGE;
+    ArenaRelease(&session->scratch, mark);
+    return FAILURE;
+  }
+  for (i = 0; i < num_targets; i++) {
+    target = GetCharacter(session, targets[i]);
+    if (target == NULL) {
+      continue;  // The target no longer exists.
+    }
+    defenders[num_hits] = target;
+    hits[num_hits].accuracy = SPELL_ACCURACY;
+    hits[num_hits].low = fire_value + water_value + earth_value + air_value;
+    hits[num_hits].high = hits[num_hits].low;
+    hits[num_hits].defense = target->physical_defense > 0 ?
+                             target->physical_defense / 10 : 0;
+    hits[num_hits].hp = target->hp;
+    num_hits++;
+  }
+  RollHits(session, num_hits, hits);
+  ResolveHits(num_hits, hits, 0);
+  for (i = 0; i < num_hits; i++) {
+    target = defenders[i];
+    target->hp = hits[i].hp;
+    if (hits[i].damage == 0) {
+      PrintFormatted(session, "%s resists all damage.\n",
+                     target->template->name);
     } else {
-      printf("%s takes %d points of damage.\n", targets[i]->name, damage);
-      targets[i]->hp -= damage;
-      if (spellcaster == &g_player && g_player.status[IN_COMBAT] == false) {
-        if (targets[i]->hp > 0) {
-          targets[i]->relationship = HOSTILE_ENEMY;
-          AddEnemy(targets[i]);
+      PrintFormatted(session, "%s takes %d points of damage.\n",
+                     target->template->name, hits[i].damage);
+      if (spellcaster == &session->player &&
+          session->player.status[IN_COMBAT] == false) {
+        if (target->hp > 0) {
+          target->relationship = HOSTILE_ENEMY;
+          AddEnemy(session, target);
         } else {
-          printf("%s is dead.\n", Capitalize(GetNameDefinite(targets[i])));
-          FlushInput();
-        }
-        for (p_gc = g_world[g_player.location]->inhabitants;
-             p_gc != NULL;
-             p_gc = p_gc->next) {
-          if (WillingToFight(p_gc) && p_gc->status[IN_COMBAT] == false) {
-            p_gc->relationship = HOSTILE_ENEMY;
-            AddEnemy(p_gc);
-          }
+          PrintFormatted(session, "%s is dead.\n",
+                         Capitalize(GetNameDefinite(session, target)));
+          FlushInput(session);
         }
+        RallyDefenders(session, session->world[session->player.location],
+                       target);
       }
     }
   }
-  backlash_value -= RandomInt(0, spellcaster->mental_defense / 4);
+  ArenaRelease(&session->scratch, mark);
+  backlash_value -= RandomInt(session, 0, spellcaster->mental_defense / 4);
   if (backlash_value > 0) {
     spellcaster->hp -= backlash_value;
-    printf("%s takes %d points of backlash damage.\n", spellcaster->name,
-           fire_value);
+    PrintFormatted(session, "%s takes %d points of backlash damage.\n",
+                   spellcaster->template->name, backlash_value);
   }
-  FlushInput();
-  /*if (spellcaster == &g_player && spell_length == MAX_SPELL_LEN)
+  FlushInput(session);
+  /*if (spellcaster == &session->player && spell_length == MAX_SPELL_LEN)
   {
-    FlushInput();  // Necessary for effective pausing in this special case.
+    FlushInput(session);  // Necessary for effective pausing in this case.
   }*/
 
-  if (g_player.status[IN_COMBAT] == false && NumberOfEnemies() > 0) {
-    printf("Prepare for battle!\n");
-    FlushInput();
-    Combat();
+  if (session->player.status[IN_COMBAT] == false &&
+      NumberOfEnemies(session) > 0) {
+    PrintFormatted(session, "Prepare for battle!\n");
+    FlushInput(session);
+    Combat(session);
   }
 
   return SUCCESS;
@@ -500,21 +607,7 @@ Description: Determines whether a given game character is capable of casting
     Outputs: true if the GC knows at least one beneficial Word, otherwise false.
 *******************************************************************************/
 bool CanCastBeneficialSpells(game_character_t *p_gc) {
-  return p_gc->words[WORD_OF_BODY]      == KNOWN ||
-         p_gc->words[WORD_OF_MIND]      == KNOWN ||
-         p_gc->words[WORD_OF_FLORA]     == KNOWN ||
-         p_gc->words[WORD_OF_FAUNA]     == KNOWN ||
-         p_gc->words[WORD_OF_LIGHT]     == KNOWN ||
-         p_gc->words[WORD_OF_DARKNESS]  == KNOWN ||
-         p_gc->words[WORD_OF_HEALTH]    == KNOWN ||
-         p_gc->words[WORD_OF_LIFE]      == KNOWN ||
-         p_gc->words[WORD_OF_HOLINESS]  == KNOWN ||
-         p_gc->words[WORD_OF_EVIL]      == KNOWN ||
-         p_gc->words[WORD_OF_INCREASE]  == KNOWN ||
-         p_gc->words[WORD_OF_DECREASE]  == KNOWN ||
-         p_gc->words[WORD_OF_SHIELDING] == KNOWN ||
-         p_gc->words[WORD_OF_TIME]      == KNOWN ||
-         p_gc->words[WORD_OF_VOID]      == KNOWN;
+  return (p_gc->template->known_words & BENEFICIAL_WORDS) != 0;
 }
 
 /*******************************************************************************
@@ -523,17 +616,18 @@ bool CanCastBeneficialSpells(game_character_t *p_gc) {
 Description: Displays each Word of Power the player knows in the following
              format: "[W]ord (Translation)".
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: Returns the number of Words displayed.
 *******************************************************************************/
-int PrintKnownWords(void) {
+int PrintKnownWords(game_session_t *session) {
   int i, j, wordLength, wordsDisplayed = 0;
   char word[SHORT_STR_LEN + 1];  // To store, format, and print each Word.
 
   for (i = 0; i < NUM_WORD_TYPES; i++) {
-    if (g_player.words[i] != UNKNOWN) {
-      strcpy(word, GetWord(i));
+    if ((session->player.template->known_words |
+         session->player.template->partially_known_words) & WORD_BIT(i)) {
+      strcpy(word, GetWord(session, i));
       wordLength = strlen(word);
 
       // The word must have room for 2 more characters: '(' and ')'.
@@ -560,10 +654,10 @@ int PrintKnownWords(void) {
             break;
         }
       }
-      if (g_player.words[i] == KNOWN) {
-        printf("%s (%s)\n", word, GetWordName(i));
-      } else {  // g_player.words[i] == PARTIALLY_KNOWN
-        printf("%s (\?\?\?)\n", word);
+      if (session->player.template->known_words & WORD_BIT(i)) {
+        PrintFormatted(session, "%s (%s)\n", word, GetWordName(session, i));
+      } else {  // Partially known.
+        PrintFormatted(session, "%s (\?\?\?)\n", word);
       }
       wordsDisplayed++;
     }
@@ -578,11 +672,12 @@ int PrintKnownWords(void) {
 Description: Given an integer representing a Word of Power, returns that Word as
              a string.
 
-     Inputs: type - Integer representing the desired Word.
+     Inputs: session - Pointer to the current game session.
+             type    - Integer representing the desired Word.
 
     Outputs: Pointer to the desired string.
 *******************************************************************************/
-char *GetWord(int type) {
+char *GetWord(game_session_t *session, int type) {
   switch (type) {
     case WORD_OF_AIR:
       return "Ethraem";
@@ -650,12 +745,13 @@ char *GetWord(int type) {
 Description: Given the first letter of a Word of Power, returns the entire Word
              as a string.
 
-     Inputs: first_letter - First letter of the desired Word.
+     Inputs: session      - Pointer to the current game session.
+             first_letter - First letter of the desired Word.
 
     Outputs: Pointer to the desired string.
 *******************************************************************************/
-char *GetWordStartingWith(char first_letter) {
-  return GetWord(GetWordTypeFromChar(first_letter));
+char *GetWordStartingWith(game_session_t *session, char first_letter) {
+  return GetWord(session, GetWordTypeFromChar(session, first_letter));
 }
 
 /*******************************************************************************
@@ -664,11 +760,12 @@ char *GetWordStartingWith(char first_letter) {
 Description: Returns the English name of a given Word of Power as a string
              (such as "Fire", "Water", etc.).
 
-     Inputs: type - Integer representing the Word of interest.
+     Inputs: session - Pointer to the current game session.
+             type    - Integer representing the Word of interest.
 
     Outputs: Pointer to the desired string.
 *******************************************************************************/
-char *GetWordName(int type) {
+char *GetWordName(game_session_t *session, int type) {
   switch (type) {
     case WORD_OF_AIR:
       return "Air";
@@ -737,18 +834,19 @@ Description: Given the first letter of a Word of Power, returns the type value
              corresponding to that Word. (Requires that no two Words share the
              same first letter.)
 
-     Inputs: first_letter - First letter of the Word of interest.
+     Inputs: session      - Pointer to the current game session.
+             first_letter - First letter of the Word of interest.
 
     Outputs: Type of the Word associated with the given letter (or -1 if no
              corresponding type is found).
 *******************************************************************************/
-int GetWordTypeFromChar(char first_letter) {
+int GetWordTypeFromChar(game_session_t *session, char first_letter) {
   int i;
   char *word;
 
   first_letter = toupper(first_letter);
   for (i = 0; i < NUM_WORD_TYPES; i++) {
-    word = GetWord(i);
+    word = GetWord(session, i);
     if (word[0] == first_letter) {
       return i;
     }
@@ -768,13 +866,5 @@ Description: Determines whether a given game character can cast spells.
     Outputs: true if the GC knows at least one Word, otherwise false.
 *******************************************************************************/
 bool IsSpellcaster(game_character_t *p_gc) {
-  int i;
-
-  for (i = 0; i < NUM_WORD_TYPES; i++) {
-    if (p_gc->words[i] == KNOWN) {
-      return true;
-    }
-  }
-
-  return false;
+  return p_gc->template->known_words != 0;
 }
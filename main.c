@@ -9,88 +9,184 @@ Description: Main C file for "Words of Power": a text-based fantasy RPG
 
 #include "wop.h"
 
+#ifndef NO_MAIN  // Defined when linking with another main (e.g., "sim.c").
 /*******************************************************************************
    Function: main
 
-Description: Main function for the "Words of Power" RPG.
+Description: Main function for the "Words of Power" RPG. Plays a single game in
+             the terminal or, given "--server ADDRESS", hosts games for remote
+             players (see "RunServer") using one worker thread per processor
+             unless "--workers N" is also given. (The combat simulator is a
+             separate program, "wop-sim," with a main function of its own;
+             see "sim.c".)
 
-     Inputs: None.
+     Inputs: argc - Number of command-line arguments.
+             argv - The command-line arguments.
 
     Outputs: Number of errors encountered.
 *******************************************************************************/
-int main(void) {
-  srand((int) time(0));
-  g_world_exists = false;
-  g_player_has_quit = false;
-
-  PrintString("\nWelcome to WORDS OF POWER: a text-based fantasy RPG by David "
-              "C. Drake!\n\0");
-  while (!g_player_has_quit) {
-    if (!g_world_exists) {
-      HandleMainMenuInput();
-    } else if (CheckStatus()) {
-      DescribeSituation();
-      HandleStandardOptionsInput();
+int main(int argc, char *argv[]) {
+  int num_workers;
+  io_backend_t *io;
+  game_session_t *session;
+
+  if ((argc == 3 || argc == 5) && strcmp(argv[1], "--server") == 0) {
+    num_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    if (argc == 5 && strcmp(argv[3], "--workers") == 0) {
+      num_workers = atoi(argv[4]);
+    } else if (argc == 5) {
+      num_workers = -1;
+    }
+    if (num_workers >= 0 && num_workers <= MAX_WORKERS) {
+      return RunServer(argv[2], num_workers);
     }
   }
-  if (g_world_exists) {
-    DestroyWorld();
+  if (argc != 1) {
+    printf("Usage: %s [--server tcp:PORT|unix:PATH [--workers N]]\n",
+           argv[0]);
+    return 1;
   }
-  printf("Farewell!\n");
-#if DEBUG
-  printf("End of main reached.\n");
-#endif
+  io = CreateStdioBackend();
+  session = CreateSession((unsigned int) time(0), io);
+  if (session == NULL) {
+    printf("ERROR: Unable to create game session.\n");
+    DestroyBackend(io);
+    return 1;
+  }
+  RunSession(session);  // Terminal input never has to be waited for.
+  DestroySession(session);
+  DestroyBackend(io);
 
   return 0;
 }
+#endif
+
+/*******************************************************************************
+   Function: CreateSession
+
+Description: Allocates and initializes a new game session, i.e., the complete
+             set of state belonging to one game in progress. No game world is
+             created until the player starts a new game. The session does not
+             take ownership of its I/O backend.
+
+     Inputs: seed - Initial value for the session's random number stream.
+             io   - Pointer to the I/O backend the session will use.
+
+    Outputs: Pointer to the new session (or NULL if an error is encountered).
+*******************************************************************************/
+game_session_t *CreateSession(unsigned int seed, io_backend_t *io) {
+  game_session_t *session;
+
+  if (io == NULL) {
+    return NULL;
+  }
+  session = calloc(1, sizeof(game_session_t));
+  if (session == NULL) {
+    return NULL;
+  }
+  session->io = io;
+  session->silent = false;
+  session->wrapper.last_blank_space = -1;
+  session->world_exists = false;
+  session->player_has_quit = false;
+  session->exiting_to_menu = false;
+  session->state = SESSION_READY;
+  session->stack = NULL;
+  session->world_arena.block_size = WORLD_ARENA_BLOCK_SIZE;
+  session->world_arena.huge_pages = WORLD_HUGE_PAGES;
+  session->details_arena.block_size = WORLD_ARENA_BLOCK_SIZE;
+  session->details_arena.huge_pages = WORLD_HUGE_PAGES;
+  session->player.template = &session->player_template;
+  session->player.details = &session->player_details;
+  session->random_seed = seed;
+
+  return session;
+}
+
+/*******************************************************************************
+   Function: DestroySession
+
+Description: Frees a game session along with its game world, if one exists.
+             (The session's I/O backend is left intact.)
+
+     Inputs: session - Pointer to the session to be destroyed.
+
+    Outputs: None.
+*******************************************************************************/
+void DestroySession(game_session_t *session) {
+  int i;
+
+  if (session == NULL) {
+    return;
+  }
+  if (session->world_exists) {
+    DestroyWorld(session);
+  }
+  free(session->wrapper.buffer);
+  DestroyArena(&session->scratch);
+  DestroyArena(&session->world_arena);
+  DestroyArena(&session->details_arena);
+  free(session->characters.slots);
+  free(session->enemies);
+  free(session->initiative.turns);
+  free(session->status_effects.afflicted);
+  for (i = 0; i < NUM_TIMED_STATUSES; i++) {
+    free(session->status_effects.rounds[i]);
+  }
+  free(session->status_effects.columns);
+  free(session->stack);
+  free(session);
+}
 
 /*******************************************************************************
    Function: HandleMainMenuInput
 
 Description: Displays main menu options and does some handling of input.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: None.
 *******************************************************************************/
-void HandleMainMenuInput(void) {
+void HandleMainMenuInput(game_session_t *session) {
   char input;
   bool repeat_options;
 
   do {
     repeat_options = false;
-    printf("Main Menu:\n"
-           "[N]ew Game\n"
-           "[L]oad Game\n"
-           "[Q]uit\n");
-    GetCharInput(&input);
+    PrintFormatted(session,
+                   "Main Menu:\n"
+                   "[N]ew Game\n"
+                   "[L]oad Game\n"
+                   "[Q]uit\n");
+    GetCharInput(session, &input);
     switch (input) {
       case 'N':  // New Game
-        if (g_world_exists) {
-          DestroyWorld();
+        if (session->world_exists) {
+          DestroyWorld(session);
         }
-        CreateWorld();
-        InitializeCharacter(&g_player, PLAYER, g_world[ILLARUM_SCHOOL]);
+        CreateWorld(session);
+        InitializeCharacter(session, &session->player, PLAYER,
+                            session->world[ILLARUM_SCHOOL]);
         break;
       case 'L':  // Load Game
-        if (g_world_exists) {
-          DestroyWorld();
+        if (session->world_exists) {
+          DestroyWorld(session);
         }
-        //LoadGame();
-        printf("Sorry, no save files found.\n\n");
+        //LoadGame(session);
+        PrintFormatted(session, "Sorry, no save files found.\n\n");
         break;
       case 'Q':  // Quit
-        if (g_world_exists) {
-          DestroyWorld();
+        if (session->world_exists) {
+          DestroyWorld(session);
         }
-        g_player_has_quit = true;
+        session->player_has_quit = true;
         break;
       default:
-        printf("Invalid response.\n\n");
+        PrintFormatted(session, "Invalid response.\n\n");
         repeat_options = true;
         break;
     }
-  }while (repeat_options);
+  }while (repeat_options && !session->player_has_quit);
 }
 
 /*******************************************************************************
@@ -99,52 +195,53 @@ void HandleMainMenuInput(void) {
 Description: Prints the standard (i.e., non-combat) player options and processes
              corresponding player input.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: None.
 *******************************************************************************/
-void HandleStandardOptionsInput(void) {
+void HandleStandardOptionsInput(game_session_t *session) {
   char input;
   bool repeat_options = true;
 
-  while (repeat_options) {
-    printf("What do you want to do?\n"
-           "[T]alk\n"
-           "[S]earch\n"
-           "[U]se an Item\n"
-           "[C]ast a Spell\n"
-           "[A]ttack\n"
-           "[V]iew Inventory and Status\n"
-           "[M]ove to Another Location\n"
-           "[Q]uit (Return to Main Menu)\n");
-    GetCharInput(&input);
+  while (repeat_options && !GameInterrupted(session)) {
+    PrintFormatted(session,
+                   "What do you want to do?\n"
+                   "[T]alk\n"
+                   "[S]earch\n"
+                   "[U]se an Item\n"
+                   "[C]ast a Spell\n"
+                   "[A]ttack\n"
+                   "[V]iew Inventory and Status\n"
+                   "[M]ove to Another Location\n"
+                   "[Q]uit (Return to Main Menu)\n");
+    GetCharInput(session, &input);
     switch (input) {
       case 'T':  // Talk
-        repeat_options = !HandleTalkMenuInput();
+        repeat_options = !HandleTalkMenuInput(session);
         break;
       case 'S':  // Search
-        SearchLocation(g_world[g_player.location]);
+        SearchLocation(session, session->world[session->player.location]);
         break;
       case 'U':  // Use an Item
-        repeat_options = !HandleItemMenuInput();
+        repeat_options = !HandleItemMenuInput(session);
         break;
       case 'C':  // Cast a Spell
-        repeat_options = !HandleSpellMenuInput();
+        repeat_options = !HandleSpellMenuInput(session);
         break;
       case 'A':  // Attack
-        repeat_options = !HandleAttackMenuInput();
+        repeat_options = !HandleAttackMenuInput(session);
         break;
       case 'M':  // Move to Another Location
-        repeat_options = !HandleMovementMenuInput();
+        repeat_options = !HandleMovementMenuInput(session);
         break;
       case 'V':  // View Inventory and Status
-        DisplayCharacterData(&g_player);
+        DisplayCharacterData(session, &session->player);
         break;
       case 'Q':  // Quit
-        repeat_options = !GetExitConfirmation();
+        repeat_options = !GetExitConfirmation(session);
         break;
       default:
-        printf("Invalid response.\n\n");
+        PrintFormatted(session, "Invalid response.\n\n");
         break;
     }
   }
@@ -157,14 +254,23 @@ Description: Attempts to save game data to a file of a given name in the same
              directory as the WoP executable. If the file doesn't exist, it is
              created; otherwise, it is overwritten.
 
-     Inputs: filename - Name of the file to be created or overwritten.
+     Inputs: session  - Pointer to the current game session.
+             filename - Name of the file to be created or overwritten.
 
     Outputs: Returns 'true' if game data are successfully saved.
 *******************************************************************************/
-bool SaveGame(const char *filename) {
+bool SaveGame(game_session_t *session, const char *filename) {
+  inventory_t *inventory = &session->player_details.inventory;
   FILE *outfile = fopen(filename, "wb");
   if (outfile) {
-    fwrite(&g_player, sizeof(game_character_t), 1, outfile);
+    fwrite(&session->player, sizeof(game_character_t), 1, outfile);
+    fwrite(&session->player_template, sizeof(character_template_t), 1,
+           outfile);
+    fwrite(&session->player_details, sizeof(character_details_t), 1, outfile);
+    if (inventory->count > INLINE_ITEM_STACKS) {  // Overflow stacks follow.
+      fwrite(inventory->overflow, sizeof(item_stack_t),
+             inventory->count - INLINE_ITEM_STACKS, outfile);
+    }
     fclose(outfile);
 
     return true;
@@ -180,14 +286,46 @@ bool SaveGame(const char *filename) {
 Description: Attempts to load game data from a file of a given name, which must
              exist in the same directory as the WoP executable.
 
-     Inputs: filename - Name of the file to be loaded.
+     Inputs: session  - Pointer to the current game session.
+             filename - Name of the file to be loaded.
 
     Outputs: Returns 'true' if game data are successfully loaded.
 *******************************************************************************/
-bool LoadGame(const char *filename) {
+bool LoadGame(game_session_t *session, const char *filename) {
+  int i;
+  inventory_t *inventory = &session->player_details.inventory;
+  character_handle_t handle = session->player.handle;
   FILE *infile = fopen(filename, "rb");
   if (infile) {
-    fread(&g_player, sizeof(game_character_t), 1, infile);
+    fread(&session->player, sizeof(game_character_t), 1, infile);
+
+    // Saved handles refer to the saving world's characters, not this one's:
+    session->player.handle = handle;
+    session->player.summoned_creature = NO_CHARACTER;
+    session->player.next = session->player.previous = NO_CHARACTER;
+    for (i = FIRST_TIMED_STATUS; i < FIRST_TIMED_STATUS + NUM_TIMED_STATUSES;
+         i++) {
+      session->player.status[i] = false;  // Durations aren't saved.
+    }
+    fread(&session->player_template, sizeof(character_template_t), 1,
+          infile);
+    fread(&session->player_details, sizeof(character_details_t), 1, infile);
+    session->player.template = &session->player_template;
+    session->player.details = &session->player_details;
+    inventory->overflow = NULL;
+    inventory->overflow_capacity = 0;
+    if (inventory->count > INLINE_ITEM_STACKS) {
+      inventory->overflow_capacity = inventory->count - INLINE_ITEM_STACKS;
+      inventory->overflow = ArenaAllocate(&session->details_arena,
+                                          inventory->overflow_capacity *
+                                          sizeof(item_stack_t));
+      if (inventory->overflow == NULL) {
+        PRINT_ERROR_MESSAGE;
+        exit(1);
+      }
+      fread(inventory->overflow, sizeof(item_stack_t),
+            inventory->overflow_capacity, infile);
+    }
     fclose(infile);
 
     return true;
@@ -202,55 +340,71 @@ bool LoadGame(const char *filename) {
 
 Description: Allocates memory for, and initializes, location structs for all
              game locations as well as game character structs for each
-             location's default inhabitants. Also sets other global variables
+             location's default inhabitants. Also sets other session variables
              to their default starting values.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: The number of failed location initializations.
 *******************************************************************************/
-int CreateWorld(void) {
+int CreateWorld(game_session_t *session) {
   int i, errors = 0;
 
 #if DEBUG
-  printf("Creating world...\n\n");
+  PrintFormatted(session, "Creating world...\n\n");
 #endif
 
-  if (g_world_exists) {
+  if (session->world_exists) {
     PRINT_ERROR_MESSAGE;
     errors++;
-    DestroyWorld();
+    DestroyWorld(session);
   }
 
-  // Initialize each location (including its inhabitants):
+  // The player is always the first entry in the world's character table:
+  if (AddCharacterSlot(session, &session->player) == FAILURE) {
+    PRINT_ERROR_MESSAGE;
+    exit(1);
+  }
+
+  // Initialize each location (including its inhabitants), all of which are
+  // allocated from the world arena:
   for (i = 0; i < NUM_LOCATION_IDS; i++) {
-    g_world[i] = malloc(sizeof(location_t));
-    if (g_world[i] != NULL) {
-      errors += InitializeLocation(g_world[i], i);
+    session->world[i] = ArenaAllocate(&session->world_arena,
+                                      sizeof(location_t));
+    if (session->world[i] != NULL) {
+      errors += InitializeLocation(session, session->world[i], i);
     } else {
       PRINT_ERROR_MESSAGE;
       exit(1);
     }
   }
 
+  // Set aside enough characters to reach the most ever in use at once, so
+  // that spawning enemies, summons, etc. will reuse them:
+  if (ReserveCharacters(session, session->characters.high_water_mark -
+                                 session->characters.num_in_use) == FAILURE) {
+    PRINT_ERROR_MESSAGE;
+    exit(1);
+  }
+
   // Set status of all missions to CLOSED:
   for (i = 0; i < NUM_MISSION_TYPES; i++) {
-    g_missions[i] = CLOSED;
+    session->missions[i] = CLOSED;
   }
 
   // Initialize player allegiances:
   for (i = 0; i < NUM_GROUP_TYPES; i++) {
-    g_allegiances[i] = INDIFFERENT;
+    session->allegiances[i] = INDIFFERENT;
   }
 
   // Initialize player's "kill" history:
   for (i = 0; i < NUM_GC_TYPES; i++) {
-    g_num_kills[i] = 0;
+    session->num_kills[i] = 0;
   }
 
-  // Initialize remaining global variables:
-  g_num_secrets_found = 0;
-  g_world_exists = true;
+  // Initialize remaining session variables:
+  session->num_secrets_found = 0;
+  session->world_exists = true;
 
   return errors;
 }
@@ -259,50 +413,58 @@ int CreateWorld(void) {
    Function: DestroyWorld
 
 Description: Deallocates all memory set aside for location structs and their
-             inhabitants.
+             inhabitants (as well as companions and summoned creatures) by
+             releasing the world arena in a single step. The arena keeps its
+             first block, so the next world is built without calling "malloc".
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: The number of errors detected.
 *******************************************************************************/
-int DestroyWorld(void) {
+int DestroyWorld(game_session_t *session) {
   int i, errors = 0;
+  game_character_t *p_gc;
 
-  if (g_world_exists == false) {
+  if (session->world_exists == false) {
     PRINT_ERROR_MESSAGE;
     errors++;
   }
 
 #if DEBUG
-  printf("Destroying world...\n\n");
+  PrintFormatted(session, "Destroying world (at most %d characters in use at "
+                 "once)...\n\n", session->characters.high_water_mark);
 #endif
 
-  for (i = 0; i < NUM_LOCATION_IDS; i++) {
-    if (g_world[i] != NULL) {
-      while (g_world[i]->inhabitants != NULL) {
-        if (DeleteInhabitant(g_world[i], g_world[i]->inhabitants) == FAILURE) {
-          errors++;
-        }
-      }
-      free(g_world[i]);
-    } else {
-      errors++;
+  for (i = 0; i < session->num_enemies; i++) {
+    p_gc = GetEnemy(session, i);
+    if (p_gc != NULL) {
+      DiscardStack(p_gc);  // Stacks are not kept in the world's arenas.
     }
   }
-  for (i = 0; i < MAX_ENEMIES; i++) {
-    g_enemies[i] = NULL;
+  ResetArena(&session->world_arena);
+  ResetArena(&session->details_arena);
+
+  // Clear all pointers and handles into the released memory:
+  for (i = 0; i < NUM_LOCATION_IDS; i++) {
+    session->world[i] = NULL;
   }
-  while (g_player.next != NULL) {
-    if (DeleteCompanion(g_player.next) == FAILURE) {
-      errors++;
-    }
+  session->num_enemies = 0;  // The roster's memory is kept, however.
+  session->initiative.num_turns = 0;  // As is the turn schedule's.
+  session->status_effects.num_afflicted = 0;
+  for (i = FIRST_TIMED_STATUS; i < FIRST_TIMED_STATUS + NUM_TIMED_STATUSES;
+       i++) {
+    session->player.status[i] = false;  // No longer being ticked.
   }
-  if (g_player.summoned_creature != NULL) {
-    if (DeleteCreatureSummonedBy(&g_player) == FAILURE) {
-      errors++;
-    }
+  for (i = 0; i < NUM_GC_TYPES; i++) {
+    session->templates[i][0] = session->templates[i][1] = NULL;
   }
-  g_world_exists = false;
+  session->characters.num_slots = 0;  // Generations are kept, however.
+  session->characters.free_list = 0;
+  session->characters.num_in_use = 0;
+  session->player.next = NO_CHARACTER;
+  session->last_companion = NO_CHARACTER;
+  session->player.summoned_creature = NO_CHARACTER;
+  session->world_exists = false;
 
   return errors;
 }
@@ -311,26 +473,29 @@ int DestroyWorld(void) {
    Function: GetExitConfirmation
 
 Description: Asks for confirmation of intent to exit to the main menu. If
-             confirmed, memory is freed via DestroyWorld.
+             confirmed, the game world is destroyed (via DestroyWorld) once
+             control has returned to the game loop, since the functions that
+             led here may still be using it.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: true if the player confirms they want to exit to the main menu.
 *******************************************************************************/
-bool GetExitConfirmation(void) {
+bool GetExitConfirmation(game_session_t *session) {
   char input;
 
   do {
-    printf("Are you sure you want to exit to the main menu (and lose unsaved "
-           "data)? (Y/N) ");
-    GetCharInput(&input);
+    PrintFormatted(session,
+                   "Are you sure you want to exit to the main menu (and lose "
+                   "unsaved data)? (Y/N) ");
+    GetCharInput(session, &input);
     if (input == 'Y') {
-      DestroyWorld();
+      session->exiting_to_menu = true;
       return true;
     } else if (input != 'N') {
-      printf("Invalid response.\n\n");
+      PrintFormatted(session, "Invalid response.\n\n");
     }
-  }while (input != 'N');
+  }while (input != 'N' && !GameInterrupted(session));
 
   return false;
 }
@@ -340,12 +505,13 @@ bool GetExitConfirmation(void) {
 
 Description: Returns a random integer between specified values (inclusive).
 
-     Inputs: low  - Lowest possible return value.
-             high - Highest possible return value.
+     Inputs: session - Pointer to the current game session.
+             low     - Lowest possible return value.
+             high    - Highest possible return value.
 
     Outputs: A randomly generated integer between "low" and "high" (inclusive).
 *******************************************************************************/
-int RandomInt(int low, int high) {
+int RandomInt(game_session_t *session, int low, int high) {
   int temp;
 
   if (low > high) {
@@ -355,7 +521,7 @@ int RandomInt(int low, int high) {
     PRINT_ERROR_MESSAGE;
   }
 
-  return rand() % (high - low + 1) + low;
+  return rand_r(&session->random_seed) % (high - low + 1) + low;
 }
 
 /*******************************************************************************
@@ -363,29 +529,39 @@ int RandomInt(int low, int high) {
 
 Description: Returns a random boolean value.
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: 'true' or 'false'
 *******************************************************************************/
-int RandomBool(void) {
-  return rand() % 2;
+int RandomBool(game_session_t *session) {
+  return rand_r(&session->random_seed) % 2;
 }
 
 /*******************************************************************************
    Function: GetCharInput
 
-Description: Takes in one character entered by the user, converts it to
-             uppercase, and flushes the input stream.
+Description: Takes in the first non-blank character of the next non-blank line
+             entered by the user and converts it to uppercase. The rest of the
+             line is discarded.
 
-     Inputs: c - Pointer to the variable that will store the input.
+     Inputs: session - Pointer to the current game session.
+             c       - Pointer to the variable that will store the input.
 
     Outputs: Returns the character read in from the user, converted to
-             uppercase.
+             uppercase (or '\0' if no more input exists).
 *******************************************************************************/
-char GetCharInput(char *c) {
-  scanf(" %c", c);
-  FlushInput();
-  printf("\n");
+char GetCharInput(game_session_t *session, char *c) {
+  char line[SHORT_STR_LEN + 1];
+  int i;
+
+  *c = '\0';
+  while (*c == '\0' && ReadLine(session, line, SHORT_STR_LEN + 1) != IO_EOF) {
+    for (i = 0; isspace(line[i]); i++) {
+      /* skip */ ;
+    }
+    *c = line[i];
+  }
+  PrintFormatted(session, "\n");
   *c = toupper(*c);
 
   return *c;
@@ -397,15 +573,19 @@ char GetCharInput(char *c) {
 Description: Reads in one integer, then repeats until an integer within given
              parameters is read.
 
-     Inputs: i    - Pointer to the variable that will store the input.
-             low  - Lowest acceptable value.
-             high - Highest acceptable value.
+     Inputs: session - Pointer to the current game session.
+             i       - Pointer to the variable that will store the input.
+             low     - Lowest acceptable value.
+             high    - Highest acceptable value.
 
-    Outputs: Returns the input value stored in "*i".
+    Outputs: Returns the input value stored in "*i". (If no more input
+             exists, "high" is chosen, which by convention is the option to
+             cancel or leave the current menu.)
 *******************************************************************************/
-int GetIntInput(int *i, int low, int high) {
+int GetIntInput(game_session_t *session, int *i, int low, int high) {
   int temp;
   bool repeat;
+  char line[SHORT_STR_LEN + 1];
 
   if (low > high) {
     temp = low;
@@ -416,14 +596,18 @@ int GetIntInput(int *i, int low, int high) {
 
   do {
     repeat = false;
-    scanf("%d", i);
-    FlushInput();
-    if (*i < low || *i > high) {
-      printf("Invalid response. Enter a number between %d and %d: ", low, high);
+    if (ReadLine(session, line, SHORT_STR_LEN + 1) == IO_EOF) {
+      *i = high;
+    } else if ((temp = sscanf(line, "%d", i)) == EOF) {
+      repeat = true;  // Blank line: keep waiting, as scanf("%d") would.
+    } else if (temp != 1 || *i < low || *i > high) {
+      PrintFormatted(session,
+                     "Invalid response. Enter a number between %d and %d: ",
+                     low, high);
       repeat = true;
     }
   }while (repeat);
-  printf("\n");
+  PrintFormatted(session, "\n");
 
   return *i;
 }
@@ -433,28 +617,22 @@ int GetIntInput(int *i, int low, int high) {
 
 Description: Takes in a string of one or more characters entered by the user.
 
-     Inputs: str - Pointer to the string that will store input.
-             n   - Maximum number of characters to read in (if greater than
-                   SHORT_STR_LEN or negative, it will be set to SHORT_STR_LEN).
+     Inputs: session - Pointer to the current game session.
+             str     - Pointer to the string that will store input.
+             n       - Maximum number of characters to read in (if greater
+                       than SHORT_STR_LEN or negative, it will be set to
+                       SHORT_STR_LEN).
 
     Outputs: Returns a pointer to the string where the input is stored.
 *******************************************************************************/
-char *GetStrInput(char *str, int n)
+char *GetStrInput(game_session_t *session, char *str, int n)
 {
-  int length;
-
   if (n < 0 || n > (SHORT_STR_LEN + 1)) {
     PRINT_ERROR_MESSAGE;
-    if (n > SHORT_STR_LEN) {
-      n = SHORT_STR_LEN;
-    }
-  }
-  fgets(str, n, stdin);
-  length = strlen(str);
-  if (length > 0 && str[length - 1] == '\n') {
-    str[length - 1] = '\0';
+    n = SHORT_STR_LEN;
   }
-  printf("\n");
+  ReadLine(session, str, n);
+  PrintFormatted(session, "\n");
 
   return str;
 }
@@ -462,45 +640,60 @@ char *GetStrInput(char *str, int n)
 /*******************************************************************************
    Function: PrintString
 
-Description: Prints a given string according to the maximum characters per
-             line, followed by a new line character. (Assumes the string is
-             NULL-terminated and contains no tabs. If no NULL-terminator is
-             encountered, assumes the size of the string is equal to
-             LONG_STR_LEN.)
+Description: Prints a given string as a paragraph, word-wrapped according to
+             the maximum characters per line and followed by a new line
+             character. (Assumes the string is NULL-terminated and contains no
+             tabs. There is no limit on the string's length.)
 
-     Inputs: str - The string to be printed, which must be NULL-terminated.
+     Inputs: session - Pointer to the current game session.
+             str     - The string to be printed, which must be NULL-terminated.
 
     Outputs: None.
 *******************************************************************************/
-void PrintString(char *str) {
-  int i, last_blank_space_index = 0, current_line_length = 0;
-  static char output[LONG_STR_LEN + 1];
-
-  strcpy(output, str);
-  for (i = 0; i < LONG_STR_LEN && output[i] != '\0'; i++) {
-    current_line_length++;
-    if (output[i] == ' ') {
-      last_blank_space_index = i;
-    }
-    if (output[i] == '\n') {
-      last_blank_space_index = 0;
-      current_line_length    = 0;
-    } else if (current_line_length == MAX_LINE_LENGTH) {
-      if (last_blank_space_index == 0) {
-        output[i]           = '\n';
-        current_line_length = 0;
-      } else {
-        i = last_blank_space_index;
-        output[i] = '\n';
-        last_blank_space_index = 0;
-        current_line_length = 0;
-      }
+void PrintString(game_session_t *session, char *str) {
+  WrapText(session, str);
+  FlushWrappedText(session);
+}
+
+/*******************************************************************************
+   Function: PrintFormatted
+
+Description: Formats a string in the manner of "printf" and writes it to the
+             session's I/O backend. (Does nothing in silent mode.)
+
+     Inputs: session - Pointer to the current game session.
+             format  - The format string, followed by any values it requires.
+
+    Outputs: Number of characters written (or -1 if an error is encountered).
+*******************************************************************************/
+int PrintFormatted(game_session_t *session, const char *format, ...) {
+  char buffer[LONG_STR_LEN + 1], *output = buffer;
+  va_list args;
+  int length;
+
+  if (session->silent) {
+    return 0;
+  }
+  va_start(args, format);
+  length = vsnprintf(buffer, LONG_STR_LEN + 1, format, args);
+  va_end(args);
+  if (length > LONG_STR_LEN) {  // Too long for the stack buffer.
+    output = malloc(length + 1);
+    if (output == NULL) {
+      return -1;
     }
+    va_start(args, format);
+    vsnprintf(output, length + 1, format, args);
+    va_end(args);
   }
-  if (i == LONG_STR_LEN) {
-    output[i] = '\0';
+  if (length > 0) {
+    length = session->io->write(session->io, output, length);
   }
-  printf("%s\n", output);
+  if (output != buffer) {
+    free(output);
+  }
+
+  return length;
 }
 
 /*******************************************************************************
@@ -563,18 +756,51 @@ bool StrContains(char *str, char c) {
 /*******************************************************************************
    Function: FlushInput
 
-Description: Removes remaining input up to and including an end of line or end
-             of file character. (Also generally an effective way of pausing the
-             game until the player hits the Enter key.)
+Description: Reads and discards one line of input. (Also generally an effective
+             way of pausing the game until the player hits the Enter key.)
 
-     Inputs: None.
+     Inputs: session - Pointer to the current game session.
 
     Outputs: None.
 *******************************************************************************/
-void FlushInput(void) {
-  int c;
+void FlushInput(game_session_t *session) {
+  char line[SHORT_STR_LEN + 1];
+
+  ReadLine(session, line, SHORT_STR_LEN + 1);
+}
+
+/*******************************************************************************
+   Function: ReadLine
+
+Description: Reads one line of input from the session's I/O backend, suspending
+             the session until the line arrives if necessary. If no more input
+             exists, the player is considered to have quit the game. (While the
+             game is being abandoned, no input is read and IO_EOF is returned,
+             so that every input loop ends promptly.)
+
+     Inputs: session - Pointer to the current game session.
+             buffer  - Buffer in which to store the line (NULL-terminated).
+             size    - Size of the buffer.
+
+    Outputs: Length of the line read, or IO_EOF if no more input exists.
+*******************************************************************************/
+int ReadLine(game_session_t *session, char *buffer, int size) {
+  int length;
 
-  while((c = getchar()) != '\n' && c != EOF) {
-    /* discard */ ;
+  if (GameInterrupted(session)) {
+    buffer[0] = '\0';
+    return IO_EOF;
+  }
+  while ((length = session->io->read_line(session->io, buffer, size)) ==
+         IO_AGAIN) {
+    if (WaitForInput(session) == FAILURE) {
+      length = IO_EOF;  // Unable to wait, so treat input as having ended.
+      break;
+    }
   }
+  if (length == IO_EOF) {
+    session->player_has_quit = true;
+  }
+
+  return length;
 }
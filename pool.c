@@ -0,0 +1,278 @@
+/*******************************************************************************
+   Filename: pool.c
+
+     Author: David C. Drake (https://davidcdrake.com)
+
+Description: A work-stealing pool of worker threads for the text-based RPG
+             "Words of Power." In server mode, each task is one turn of a game
+             session, which runs to completion on whichever worker takes it.
+             Every worker has its own queue: it takes its newest task first
+             (while the task's data is likely still in cache), and a worker
+             with nothing to do steals the oldest task of another worker.
+             Tasks share no mutable state, so turns scale across cores.
+*******************************************************************************/
+
+#include "wop.h"
+
+/*******************************************************************************
+   Function: CreateWorkerPool
+
+Description: Creates a pool of worker threads, all initially idle. A pool with
+             no workers runs each task immediately within "SubmitTask".
+
+     Inputs: num_workers - Number of worker threads (0 to MAX_WORKERS).
+
+    Outputs: Pointer to the new pool (or NULL if an error is encountered).
+*******************************************************************************/
+worker_pool_t *CreateWorkerPool(int num_workers) {
+  int i;
+  worker_pool_t *pool;
+
+  if (num_workers < 0 || num_workers > MAX_WORKERS) {
+    return NULL;
+  }
+  pool = calloc(1, sizeof(worker_pool_t));
+  if (pool == NULL) {
+    return NULL;
+  }
+  pool->workers = calloc(num_workers > 0 ? num_workers : 1, sizeof(worker_t));
+  if (pool->workers == NULL) {
+    free(pool);
+    return NULL;
+  }
+  atomic_init(&pool->next_worker, 0);
+  atomic_init(&pool->num_pending, 0);
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work_ready, NULL);
+  pool->stopping = false;
+  for (i = 0; i < num_workers; i++) {
+    pool->workers[i].pool = pool;
+    pool->workers[i].index = i;
+    pthread_mutex_init(&pool->workers[i].queue.lock, NULL);
+  }
+  pthread_mutex_lock(&pool->lock);  // Held until "num_workers" is final.
+  for (i = 0; i < num_workers; i++) {
+    if (pthread_create(&pool->workers[i].thread, NULL, RunWorker,
+                       &pool->workers[i]) != 0) {
+      break;
+    }
+    pool->num_workers++;
+  }
+  pthread_mutex_unlock(&pool->lock);
+  if (pool->num_workers < num_workers) {
+    DestroyWorkerPool(pool);
+    return NULL;
+  }
+
+  return pool;
+}
+
+/*******************************************************************************
+   Function: DestroyWorkerPool
+
+Description: Waits for every submitted task to finish, then stops the pool's
+             workers and frees the pool.
+
+     Inputs: pool - Pointer to the pool to be destroyed.
+
+    Outputs: None.
+*******************************************************************************/
+void DestroyWorkerPool(worker_pool_t *pool) {
+  int i;
+
+  if (pool == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&pool->lock);
+  pool->stopping = true;
+  pthread_cond_broadcast(&pool->work_ready);
+  pthread_mutex_unlock(&pool->lock);
+  for (i = 0; i < pool->num_workers; i++) {
+    pthread_join(pool->workers[i].thread, NULL);
+  }
+  for (i = 0; i < pool->num_workers; i++) {
+    pthread_mutex_destroy(&pool->workers[i].queue.lock);
+    free(pool->workers[i].queue.tasks);
+  }
+  pthread_cond_destroy(&pool->work_ready);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool->workers);
+  free(pool);
+}
+
+/*******************************************************************************
+   Function: SubmitTask
+
+Description: Hands a task to the pool, adding it to the workers' queues in
+             turn and waking a worker if any are idle.
+
+     Inputs: pool     - Pointer to the pool of interest.
+             run      - Function to be called by a worker.
+             argument - Argument to be passed to "run".
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int SubmitTask(worker_pool_t *pool, void (*run)(void *argument),
+               void *argument) {
+  task_t task;
+  worker_t *worker;
+
+  if (pool->num_workers == 0) {
+    run(argument);
+    return SUCCESS;
+  }
+  task.run = run;
+  task.argument = argument;
+  worker = &pool->workers[atomic_fetch_add(&pool->next_worker, 1) %
+                          pool->num_workers];
+  // Count the task before publishing it, so that a worker taking it at once
+  // can never drive the count below zero:
+  atomic_fetch_add(&pool->num_pending, 1);
+  if (PushTask(&worker->queue, task) == FAILURE) {
+    atomic_fetch_sub(&pool->num_pending, 1);
+    return FAILURE;
+  }
+  pthread_mutex_lock(&pool->lock);
+  pthread_cond_signal(&pool->work_ready);
+  pthread_mutex_unlock(&pool->lock);
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: RunWorker
+
+Description: Body of each worker thread: runs tasks from its own queue, steals
+             from other queues when its own is empty, and sleeps when there is
+             no work at all. Returns once the pool is stopping and no tasks
+             remain.
+
+     Inputs: argument - Pointer to the worker (as a "worker_t *").
+
+    Outputs: NULL.
+*******************************************************************************/
+void *RunWorker(void *argument) {
+  worker_t *worker = argument;
+  worker_pool_t *pool = worker->pool;
+  task_t task;
+  bool done;
+
+  // Wait until every worker has been started (see "CreateWorkerPool"):
+  pthread_mutex_lock(&pool->lock);
+  pthread_mutex_unlock(&pool->lock);
+
+  while (true) {
+    if (TakeTask(&worker->queue, &task, true) ||
+        StealTask(pool, worker->index, &task)) {
+      atomic_fetch_sub(&pool->num_pending, 1);
+      task.run(task.argument);
+      continue;
+    }
+    pthread_mutex_lock(&pool->lock);
+    while (atomic_load(&pool->num_pending) == 0 && !pool->stopping) {
+      pthread_cond_wait(&pool->work_ready, &pool->lock);
+    }
+    done = pool->stopping && atomic_load(&pool->num_pending) == 0;
+    pthread_mutex_unlock(&pool->lock);
+    if (done) {
+      break;
+    }
+  }
+
+  return NULL;
+}
+
+/*******************************************************************************
+   Function: TakeTask
+
+Description: Removes either the newest or the oldest task from a queue.
+
+     Inputs: queue  - Pointer to the queue of interest.
+             task   - Pointer to where the task will be stored.
+             newest - If true, the newest task is taken; otherwise, the oldest.
+
+    Outputs: true if a task was taken (false if the queue was empty).
+*******************************************************************************/
+bool TakeTask(work_queue_t *queue, task_t *task, bool newest) {
+  bool taken = false;
+
+  pthread_mutex_lock(&queue->lock);
+  if (queue->count > 0) {
+    if (newest) {
+      *task = queue->tasks[(queue->first + queue->count - 1) %
+                           queue->capacity];
+    } else {
+      *task = queue->tasks[queue->first];
+      queue->first = (queue->first + 1) % queue->capacity;
+    }
+    queue->count--;
+    taken = true;
+  }
+  pthread_mutex_unlock(&queue->lock);
+
+  return taken;
+}
+
+/*******************************************************************************
+   Function: StealTask
+
+Description: Takes the oldest task from the first other worker (starting just
+             after the thief) whose queue is not empty.
+
+     Inputs: pool  - Pointer to the pool of interest.
+             thief - Index of the worker looking for a task.
+             task  - Pointer to where the task will be stored.
+
+    Outputs: true if a task was stolen.
+*******************************************************************************/
+bool StealTask(worker_pool_t *pool, int thief, task_t *task) {
+  int i;
+
+  for (i = 1; i < pool->num_workers; i++) {
+    if (TakeTask(&pool->workers[(thief + i) % pool->num_workers].queue, task,
+                 false)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/*******************************************************************************
+   Function: PushTask
+
+Description: Adds a task to a queue as its newest task, growing the queue as
+             needed.
+
+     Inputs: queue - Pointer to the queue of interest.
+             task  - The task to be added.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int PushTask(work_queue_t *queue, task_t task) {
+  int i, new_capacity;
+  task_t *new_tasks;
+
+  pthread_mutex_lock(&queue->lock);
+  if (queue->count == queue->capacity) {
+    new_capacity = queue->capacity > 0 ? queue->capacity * 2 :
+                                         WORK_QUEUE_CAPACITY;
+    new_tasks = malloc(new_capacity * sizeof(task_t));
+    if (new_tasks == NULL) {
+      pthread_mutex_unlock(&queue->lock);
+      return FAILURE;
+    }
+    for (i = 0; i < queue->count; i++) {  // Unwrap the circular buffer.
+      new_tasks[i] = queue->tasks[(queue->first + i) % queue->capacity];
+    }
+    free(queue->tasks);
+    queue->tasks = new_tasks;
+    queue->first = 0;
+    queue->capacity = new_capacity;
+  }
+  queue->tasks[(queue->first + queue->count) % queue->capacity] = task;
+  queue->count++;
+  pthread_mutex_unlock(&queue->lock);
+
+  return SUCCESS;
+}
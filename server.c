@@ -0,0 +1,373 @@
+/*******************************************************************************
+   Filename: server.c
+
+     Author: David C. Drake (https://davidcdrake.com)
+
+Description: Server mode for the text-based RPG "Words of Power." Accepts
+             connections on a local TCP port or Unix domain socket and hosts a
+             separate game session for each connected player, all within a
+             single process. An "epoll" event loop watches every connection
+             and hands each one that is ready to a pool of worker threads (see
+             "pool.c"), where the connection's input is fed to its session (see
+             "RunSession") and the session's output is sent back as the socket
+             allows. Connections are registered with EPOLLONESHOT, so each is
+             handled by at most one worker at a time and is re-armed only when
+             that worker is finished with it.
+*******************************************************************************/
+
+#include "wop.h"
+
+/*******************************************************************************
+   Function: RunServer
+
+Description: Listens at a given address and hosts games for all who connect.
+             Returns only if the server cannot be started or fails.
+
+     Inputs: address     - "tcp:PORT" (bound to the loopback interface) or
+                           "unix:PATH".
+             num_workers - Number of worker threads to run game sessions on
+                           (if 0, sessions run on the event loop's thread).
+
+    Outputs: Number of errors encountered.
+*******************************************************************************/
+int RunServer(const char *address, int num_workers) {
+  int i, num_events, listener, epoll_fd;
+  unsigned int seed = (unsigned int) time(0);
+  struct epoll_event event, events[SERVER_MAX_EVENTS];
+  worker_pool_t *pool;
+
+  listener = OpenListener(address);
+  if (listener < 0) {
+    return 1;
+  }
+  epoll_fd = epoll_create1(0);
+  if (epoll_fd < 0) {
+    fprintf(stderr, "ERROR: epoll_create1: %s\n", strerror(errno));
+    close(listener);
+    return 1;
+  }
+  event.events = EPOLLIN;
+  event.data.ptr = NULL;  // Identifies the listener.
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listener, &event) < 0) {
+    fprintf(stderr, "ERROR: epoll_ctl: %s\n", strerror(errno));
+    close(epoll_fd);
+    close(listener);
+    return 1;
+  }
+  pool = CreateWorkerPool(num_workers);
+  if (pool == NULL) {
+    fprintf(stderr, "ERROR: Unable to start %d worker threads.\n",
+            num_workers);
+    close(epoll_fd);
+    close(listener);
+    return 1;
+  }
+  fprintf(stderr, "Listening at %s with %d worker threads\n", address,
+          num_workers);
+
+  while (true) {
+    num_events = epoll_wait(epoll_fd, events, SERVER_MAX_EVENTS, -1);
+    if (num_events < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fprintf(stderr, "ERROR: epoll_wait: %s\n", strerror(errno));
+      break;
+    }
+    for (i = 0; i < num_events; i++) {
+      if (events[i].data.ptr == NULL) {
+        AcceptConnections(epoll_fd, listener, &seed, pool);
+      } else if (SubmitTask(pool, ServiceConnection,
+                            events[i].data.ptr) == FAILURE) {
+        ServiceConnection(events[i].data.ptr);  // Handle it here instead.
+      }
+    }
+  }
+  DestroyWorkerPool(pool);
+  close(epoll_fd);
+  close(listener);
+
+  return 1;
+}
+
+/*******************************************************************************
+   Function: OpenListener
+
+Description: Creates a non-blocking socket listening at a given address.
+
+     Inputs: address - "tcp:PORT" or "unix:PATH".
+
+    Outputs: The listening socket's file descriptor, or -1 if an error is
+             encountered.
+*******************************************************************************/
+int OpenListener(const char *address) {
+  int fd, port, option = 1;
+  struct sockaddr_in tcp_address;
+  struct sockaddr_un unix_address;
+
+  if (strncmp(address, "tcp:", 4) == 0) {
+    port = atoi(address + 4);
+    if (port <= 0 || port > 65535) {
+      fprintf(stderr, "ERROR: Invalid port: %s\n", address + 4);
+      return -1;
+    }
+    memset(&tcp_address, 0, sizeof(tcp_address));
+    tcp_address.sin_family = AF_INET;
+    tcp_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    tcp_address.sin_port = htons(port);
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd >= 0) {
+      setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+      if (bind(fd, (struct sockaddr *) &tcp_address,
+               sizeof(tcp_address)) < 0) {
+        fprintf(stderr, "ERROR: bind: %s\n", strerror(errno));
+        close(fd);
+        return -1;
+      }
+    }
+  } else if (strncmp(address, "unix:", 5) == 0) {
+    if (strlen(address + 5) >= sizeof(unix_address.sun_path)) {
+      fprintf(stderr, "ERROR: Socket path too long: %s\n", address + 5);
+      return -1;
+    }
+    memset(&unix_address, 0, sizeof(unix_address));
+    unix_address.sun_family = AF_UNIX;
+    strcpy(unix_address.sun_path, address + 5);
+    unlink(unix_address.sun_path);  // Remove any stale socket file.
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && bind(fd, (struct sockaddr *) &unix_address,
+                        sizeof(unix_address)) < 0) {
+      fprintf(stderr, "ERROR: bind: %s\n", strerror(errno));
+      close(fd);
+      return -1;
+    }
+  } else {
+    fprintf(stderr, "ERROR: Address must be tcp:PORT or unix:PATH.\n");
+    return -1;
+  }
+  if (fd < 0) {
+    fprintf(stderr, "ERROR: socket: %s\n", strerror(errno));
+    return -1;
+  }
+  if (listen(fd, SERVER_BACKLOG) < 0 || SetNonBlocking(fd) == FAILURE) {
+    fprintf(stderr, "ERROR: listen: %s\n", strerror(errno));
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+/*******************************************************************************
+   Function: AcceptConnections
+
+Description: Accepts all pending connections, giving each a new game session
+             and submitting it to the worker pool so that the session runs up
+             to its first request for input. (Each connection is registered
+             with "epoll" by the worker that first services it.)
+
+     Inputs: epoll_fd - The server's "epoll" file descriptor.
+             listener - The listening socket.
+             seed     - Pointer to the value from which each new session's
+                        random seed is derived (updated for the next).
+             pool     - Pointer to the pool of worker threads.
+
+    Outputs: Number of connections accepted.
+*******************************************************************************/
+int AcceptConnections(int epoll_fd, int listener, unsigned int *seed,
+                      worker_pool_t *pool) {
+  int fd, num_accepted = 0;
+  connection_t *connection;
+
+  while ((fd = accept(listener, NULL, NULL)) >= 0) {
+    connection = calloc(1, sizeof(connection_t));
+    if (connection == NULL || SetNonBlocking(fd) == FAILURE) {
+      free(connection);
+      close(fd);
+      continue;
+    }
+    connection->fd = fd;
+    connection->epoll_fd = epoll_fd;
+    connection->registered = false;
+    connection->io = CreateQueueBackend();
+    connection->session = CreateSession((*seed)++, connection->io);
+    if (connection->session == NULL) {
+      DestroyBackend(connection->io);
+      free(connection);
+      close(fd);
+      continue;
+    }
+    num_accepted++;
+    if (SubmitTask(pool, ServiceConnection, connection) == FAILURE) {
+      ServiceConnection(connection);  // Welcome the new player here instead.
+    }
+  }
+
+  return num_accepted;
+}
+
+/*******************************************************************************
+   Function: ReadFromConnection
+
+Description: Reads everything currently available from a connection and
+             queues it as input for the connection's game session. Carriage
+             returns are dropped so that line endings may be "\r\n" or "\n".
+
+     Inputs: connection - Pointer to the connection of interest.
+
+    Outputs: SUCCESS, or FAILURE if the connection has been closed by the
+             player, has failed, or has sent too much unread input.
+*******************************************************************************/
+int ReadFromConnection(connection_t *connection) {
+  char buffer[SERVER_READ_SIZE];
+  int i, length, kept;
+  io_backend_t *io = connection->io;
+
+  if (io->input_closed) {
+    return FAILURE;
+  }
+  while (true) {
+    length = read(connection->fd, buffer, SERVER_READ_SIZE);
+    if (length < 0 && errno == EINTR) {
+      continue;
+    } else if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return SUCCESS;
+    } else if (length <= 0) {
+      return FAILURE;
+    }
+    for (i = kept = 0; i < length; i++) {
+      if (buffer[i] != '\r') {
+        buffer[kept++] = buffer[i];
+      }
+    }
+    if (AppendInput(io, buffer, kept) == FAILURE ||
+        io->input_length - io->input_position > SERVER_MAX_INPUT) {
+      return FAILURE;
+    }
+  }
+}
+
+/*******************************************************************************
+   Function: ServiceConnection
+
+Description: Reads a connection's available input, lets its game session run
+             as far as the queued input allows, sends whatever it printed, and
+             re-arms the connection with "epoll." The connection is closed once
+             the game has ended and all output has been sent. A session does
+             not run while earlier output is still waiting to be sent, so a
+             player who stops reading cannot make the server buffer output
+             without limit. (Runs as a worker pool task.)
+
+     Inputs: argument - Pointer to the connection of interest (as a
+                        "connection_t *").
+
+    Outputs: None.
+*******************************************************************************/
+void ServiceConnection(void *argument) {
+  int operation;
+  struct epoll_event event;
+  connection_t *connection = argument;
+  game_session_t *session = connection->session;
+
+  if (ReadFromConnection(connection) == FAILURE) {
+    CloseInput(connection->io);  // Let the game end normally.
+  }
+  if (connection->io->output_length == 0) {
+    RunSession(session);
+  }
+  if (FlushConnection(connection) == FAILURE) {
+    CloseInput(connection->io);
+    connection->io->output_length = 0;  // Undeliverable.
+    RunSession(session);  // Unwind the game.
+    CloseConnection(connection);
+    return;
+  }
+  if (session->state == SESSION_FINISHED &&
+      connection->io->output_length == 0) {
+    CloseConnection(connection);
+    return;
+  }
+
+  // Wait for the socket to accept more output, or else for more input. (Once
+  // re-armed, the connection may be taken up by another worker at any moment,
+  // so it must not be touched afterward.)
+  event.events = EPOLLONESHOT |
+                 (connection->io->output_length > 0 ? EPOLLOUT : EPOLLIN);
+  event.data.ptr = connection;
+  operation = connection->registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+  connection->registered = true;
+  if (epoll_ctl(connection->epoll_fd, operation, connection->fd,
+                &event) < 0) {
+    connection->registered = operation == EPOLL_CTL_MOD;
+    CloseInput(connection->io);
+    RunSession(session);  // Unwind the game.
+    CloseConnection(connection);
+  }
+}
+
+/*******************************************************************************
+   Function: FlushConnection
+
+Description: Sends as much of a connection's pending output as the socket will
+             currently accept.
+
+     Inputs: connection - Pointer to the connection of interest.
+
+    Outputs: SUCCESS (even if some output remains pending), or FAILURE if the
+             connection has failed.
+*******************************************************************************/
+int FlushConnection(connection_t *connection) {
+  int length;
+  io_backend_t *io = connection->io;
+
+  while (connection->output_sent < io->output_length) {
+    length = send(connection->fd, io->output + connection->output_sent,
+                  io->output_length - connection->output_sent, MSG_NOSIGNAL);
+    if (length < 0 && errno == EINTR) {
+      continue;
+    } else if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return SUCCESS;
+    } else if (length < 0) {
+      return FAILURE;
+    }
+    connection->output_sent += length;
+  }
+  io->output_length = 0;
+  connection->output_sent = 0;
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: CloseConnection
+
+Description: Closes a connection and frees its game session and I/O backend.
+
+     Inputs: connection - Pointer to the connection to be closed.
+
+    Outputs: None.
+*******************************************************************************/
+void CloseConnection(connection_t *connection) {
+  if (connection->registered) {
+    epoll_ctl(connection->epoll_fd, EPOLL_CTL_DEL, connection->fd, NULL);
+  }
+  close(connection->fd);
+  DestroySession(connection->session);
+  DestroyBackend(connection->io);
+  free(connection);
+}
+
+/*******************************************************************************
+   Function: SetNonBlocking
+
+Description: Puts a file descriptor into non-blocking mode.
+
+     Inputs: fd - The file descriptor of interest.
+
+    Outputs: SUCCESS or FAILURE.
+*******************************************************************************/
+int SetNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) >= 0;
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+   Filename: session.c
+
+     Author: David C. Drake (https://davidcdrake.com)
+
+Description: Resumable game sessions for the text-based RPG "Words of Power."
+             Each session's game runs on a stack of its own. Whenever the game
+             needs input that has not arrived yet, the session suspends itself
+             and control returns to whoever called "RunSession," which may then
+             run other sessions. Calling "RunSession" again (once more input is
+             available) resumes the game exactly where it left off. A single
+             thread can thereby host any number of idle players.
+*******************************************************************************/
+
+#include "wop.h"
+
+/*******************************************************************************
+   Function: RunSession
+
+Description: Runs (or resumes) a game session until it either needs input that
+             is not yet available or finishes. The first call sets up the
+             session's stack and starts a new game loop on it.
+
+     Inputs: session - Pointer to the game session to be run.
+
+    Outputs: The session's resulting state: SESSION_AWAITING_INPUT or
+             SESSION_FINISHED.
+*******************************************************************************/
+int RunSession(game_session_t *session) {
+  uintptr_t address = (uintptr_t) session;
+
+  if (session->state == SESSION_FINISHED) {
+    return SESSION_FINISHED;
+  }
+  if (session->stack == NULL) {
+    session->stack = malloc(SESSION_STACK_SIZE);
+    if (session->stack == NULL) {
+      session->player_has_quit = true;
+      session->state = SESSION_FINISHED;
+      return SESSION_FINISHED;
+    }
+    getcontext(&session->context);
+    session->context.uc_stack.ss_sp = session->stack;
+    session->context.uc_stack.ss_size = SESSION_STACK_SIZE;
+    session->context.uc_link = &session->caller;
+
+    // "makecontext" only passes "int" arguments, so split the pointer:
+    makecontext(&session->context, (void (*)(void)) StartSession, 2,
+                (unsigned int) ((address >> 16) >> 16),
+                (unsigned int) address);
+  }
+  session->state = SESSION_READY;
+  swapcontext(&session->caller, &session->context);
+  if (session->state == SESSION_FINISHED) {
+    free(session->stack);
+    session->stack = NULL;
+  }
+
+  return session->state;
+}
+
+/*******************************************************************************
+   Function: StartSession
+
+Description: Entry point of a session's stack: reassembles the session pointer
+             and plays the game. When the game ends, control returns to the
+             most recent caller of "RunSession."
+
+     Inputs: address_high - High-order bits of the session's address.
+             address_low  - Low-order 32 bits of the session's address.
+
+    Outputs: None.
+*******************************************************************************/
+void StartSession(unsigned int address_high, unsigned int address_low) {
+  game_session_t *session = (game_session_t *)
+    ((((uintptr_t) address_high << 16) << 16) | address_low);
+
+  PlayGame(session);
+  session->state = SESSION_FINISHED;
+}
+
+/*******************************************************************************
+   Function: PlayGame
+
+Description: The game loop: welcomes the player, then alternates between the
+             main menu and the game world until the player quits.
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: None.
+*******************************************************************************/
+void PlayGame(game_session_t *session) {
+  PrintString(session, "\nWelcome to WORDS OF POWER: a text-based fantasy RPG "
+              "by David C. Drake!\n\0");
+  while (!session->player_has_quit) {
+    if (!session->world_exists) {
+      HandleMainMenuInput(session);
+    } else if (CheckStatus(session)) {
+      DescribeSituation(session);
+      HandleStandardOptionsInput(session);
+    }
+
+    // Only destroy the world once every function using it has returned:
+    if (session->exiting_to_menu) {
+      session->exiting_to_menu = false;
+      if (session->world_exists) {
+        DestroyWorld(session);
+      }
+    }
+  }
+  PrintFormatted(session, "Farewell!\n");
+#if DEBUG
+  PrintFormatted(session, "End of game loop reached.\n");
+#endif
+}
+
+/*******************************************************************************
+   Function: WaitForInput
+
+Description: Suspends a game session until "RunSession" is called again
+             (presumably once more input is available).
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: SUCCESS, or FAILURE if the session is not running via
+             "RunSession" and therefore cannot wait.
+*******************************************************************************/
+int WaitForInput(game_session_t *session) {
+  if (session->stack == NULL) {
+    return FAILURE;
+  }
+  session->state = SESSION_AWAITING_INPUT;
+  swapcontext(&session->context, &session->caller);
+
+  return SUCCESS;
+}
+
+/*******************************************************************************
+   Function: GameInterrupted
+
+Description: Determines whether the current game is being abandoned, either
+             because the player has quit or because they have chosen to exit
+             to the main menu. Loops awaiting input check this so that nested
+             menus, dialogue and combat all return promptly.
+
+     Inputs: session - Pointer to the current game session.
+
+    Outputs: true if the current game is being abandoned.
+*******************************************************************************/
+bool GameInterrupted(game_session_t *session) {
+  return session->player_has_quit || session->exiting_to_menu;
+}
@@ -0,0 +1,490 @@
+/*******************************************************************************
+   Filename: sim.c
+
+     Author: David C. Drake (https://davidcdrake.com)
+
+Description: A headless combat simulator for balancing the text-based RPG
+             "Words of Power." A player of a given level fights a given party
+             of enemies over and over, and the win rate and the distributions
+             of turns and damage are reported. Each fight is an ordinary
+             call to "Combat" in a silent session, so the game's own rules
+             (including "EnemyAI," "Attack" and "CastSpell") decide every
+             outcome; only the player's choices are scripted (see
+             "player_policy_t"). The fights are split into batches that run
+             in parallel on a worker pool. Each fight draws its random numbers
+             from its own stream, split from a master seed by the fight's
+             index, so results never depend on how fights were scheduled.
+
+             The simulator is built as a program of its own ("make wop-sim"),
+             so the game itself carries none of it:
+
+             Usage: wop-sim FIGHTS LEVEL TYPE[:COUNT]... [--spell WORDS]
+                    [--seed N] [--workers N]
+
+             For example, "wop-sim 100000 3 WOLF:4 --spell BB" pits a Level 3
+             player casting "BB" every turn against a pack of four wolves.
+             Given the same seed, the report is the same for any number of
+             workers (including 0, which runs every fight on the calling
+             thread; see "make check").
+*******************************************************************************/
+
+#include "wop.h"
+
+// Each game character type's identifier (e.g., "WOLF"), indexed by type:
+static const char *character_type_ids[NUM_GC_TYPES] = {
+#define CHARACTER_TYPE(type, ...) [type] = #type,
+#include "character_types.h"
+#undef CHARACTER_TYPE
+};
+
+/*******************************************************************************
+   Function: main
+
+Description: Main function for "wop-sim," the combat simulator.
+
+     Inputs: argc - Number of command-line arguments.
+             argv - The command-line arguments.
+
+    Outputs: 0 if the simulation was run, otherwise 1.
+*******************************************************************************/
+int main(int argc, char *argv[]) {
+  return RunSimulation(argc, argv);
+}
+
+/*******************************************************************************
+   Function: RunSimulation
+
+Description: Runs the simulation described by the command line (see above) and
+             prints a report of the results.
+
+     Inputs: argc - Number of command-line arguments.
+             argv - The command-line arguments.
+
+    Outputs: 0 if the simulation was run, otherwise 1.
+*******************************************************************************/
+int RunSimulation(int argc, char *argv[]) {
+  int i, num_workers, num_batches, fights_per_batch;
+  bool failed = false;
+  simulation_t simulation;
+  sim_batch_t *batches, total;
+  worker_pool_t *pool;
+
+  if (ParseSimulation(argc, argv, &simulation, &num_workers) == FAILURE) {
+    printf("Usage: %s FIGHTS LEVEL TYPE[:COUNT]... [--spell WORDS] "
+           "[--seed N]\n"
+           "       [--workers N]\n", argv[0]);
+    return 1;
+  }
+
+  // Split the fights into batches, several per worker to balance the load:
+  num_batches = (num_workers > 0 ? num_workers : 1) * SIM_BATCHES_PER_WORKER;
+  if (num_batches > simulation.num_fights) {
+    num_batches = simulation.num_fights;
+  }
+  fights_per_batch = (simulation.num_fights + num_batches - 1) / num_batches;
+  num_batches = (simulation.num_fights + fights_per_batch - 1) /
+                fights_per_batch;
+  batches = calloc(num_batches, sizeof(sim_batch_t));
+  pool = CreateWorkerPool(num_workers);
+  if (batches == NULL || pool == NULL) {
+    printf("ERROR: Unable to start %d worker threads.\n", num_workers);
+    free(batches);
+    DestroyWorkerPool(pool);
+    return 1;
+  }
+  for (i = 0; i < num_batches; i++) {
+    batches[i].simulation = &simulation;
+    batches[i].first_fight = i * fights_per_batch;
+    batches[i].num_fights = simulation.num_fights - batches[i].first_fight;
+    if (batches[i].num_fights > fights_per_batch) {
+      batches[i].num_fights = fights_per_batch;
+    }
+    if (SubmitTask(pool, RunSimulationBatch, &batches[i]) == FAILURE) {
+      RunSimulationBatch(&batches[i]);  // Run it here instead.
+    }
+  }
+  DestroyWorkerPool(pool);  // Waits for every batch to finish.
+
+  // Combine the batches' results in order, then report them:
+  memset(&total, 0, sizeof(sim_batch_t));
+  for (i = 0; i < num_batches; i++) {
+    failed = failed || batches[i].failed;
+    MergeBatch(&total, &batches[i]);
+  }
+  free(batches);
+  if (failed) {
+    printf("ERROR: Unable to create a game session for the simulation.\n");
+    return 1;
+  }
+  PrintSimulationReport(&simulation, &total);
+
+  return 0;
+}
+
+/*******************************************************************************
+   Function: ParseSimulation
+
+Description: Reads the description of a simulation from the command line.
+
+     Inputs: argc        - Number of command-line arguments.
+             argv        - The command-line arguments.
+             simulation  - Pointer to the simulation to be described.
+             num_workers - Pointer to the variable that will store the number
+                           of worker threads (by default, one per core).
+
+    Outputs: SUCCESS, or FAILURE if the command line is invalid.
+*******************************************************************************/
+int ParseSimulation(int argc, char *argv[], simulation_t *simulation,
+                    int *num_workers) {
+  int i, j, type, count;
+  char id[SHORT_STR_LEN + 1], *separator;
+
+  memset(simulation, 0, sizeof(simulation_t));
+  simulation->seed = (uint64_t) time(0);
+  *num_workers = sysconf(_SC_NPROCESSORS_ONLN);
+  if (argc < 4) {
+    return FAILURE;
+  }
+  simulation->num_fights = atoi(argv[1]);
+  simulation->level = atoi(argv[2]);
+  if (simulation->num_fights < 1 || simulation->level < 1) {
+    return FAILURE;
+  }
+  for (i = 3; i < argc; i++) {
+    if (strcmp(argv[i], "--spell") == 0 && i + 1 < argc) {
+      if (strlen(argv[++i]) > MAX_SPELL_LEN) {
+        return FAILURE;
+      }
+      for (j = 0; argv[i][j] != '\0'; j++) {
+        simulation->spell[j] = toupper(argv[i][j]);
+      }
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      simulation->seed = strtoull(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+      *num_workers = atoi(argv[++i]);
+      if (*num_workers < 0 || *num_workers > MAX_WORKERS) {
+        return FAILURE;
+      }
+    } else if (simulation->party_size < SIM_MAX_PARTY &&
+               strlen(argv[i]) <= SHORT_STR_LEN) {  // "TYPE[:COUNT]"
+      strcpy(id, argv[i]);
+      count = 1;
+      separator = strchr(id, ':');
+      if (separator != NULL) {
+        *separator = '\0';
+        count = atoi(separator + 1);
+      }
+      type = FindCharacterType(id);
+      if (type < 0 || type == PLAYER || count < 1) {
+        return FAILURE;
+      }
+      simulation->enemy_types[simulation->party_size] = type;
+      simulation->enemy_counts[simulation->party_size] = count;
+      simulation->party_size++;
+    } else {
+      return FAILURE;
+    }
+  }
+
+  return simulation->party_size > 0 ? SUCCESS : FAILURE;
+}
+
+/*******************************************************************************
+   Function: FindCharacterType
+
+Description: Finds the game character type with a given identifier (e.g.,
+             "WOLF" or "wolf" for WOLF), considering only types that can be
+             spawned.
+
+     Inputs: id - The identifier of interest.
+
+    Outputs: The game character type, or -1 if none is found.
+*******************************************************************************/
+int FindCharacterType(const char *id) {
+  int i;
+
+  for (i = 0; i < NUM_GC_TYPES; i++) {
+    if (character_type_ids[i] != NULL &&
+        strcasecmp(character_type_ids[i], id) == 0) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/*******************************************************************************
+   Function: RunSimulationBatch
+
+Description: Runs a batch of fights in a game session of its own, recording
+             the results in the batch. The session's world is created once:
+             the player is restored to the same starting state before each
+             fight, and the enemies are deleted after it.
+
+     Inputs: argument - Pointer to the batch (as a "sim_batch_t *").
+
+    Outputs: None.
+*******************************************************************************/
+void RunSimulationBatch(void *argument) {
+  int i;
+  sim_batch_t *batch = argument;
+  io_backend_t *io;
+  game_session_t *session = NULL;
+  game_character_t start;
+  player_policy_t policy;
+
+  io = CreateRepeatingBackend(SIM_PLAYER_NAME);
+  if (io != NULL) {
+    session = CreateSession((unsigned int) batch->simulation->seed, io);
+  }
+  if (session == NULL) {
+    batch->failed = true;
+    DestroyBackend(io);
+    return;
+  }
+  session->silent = true;
+  CreateWorld(session);
+  InitializeCharacter(session, &session->player, PLAYER,
+                      session->world[ILLARUM_SCHOOL]);
+  for (i = 1; i < batch->simulation->level; i++) {
+    LevelUp(session);
+  }
+  start = session->player;
+  policy.take_turn = SimulatedTurn;
+  policy.spell = batch->simulation->spell;
+  session->policy = &policy;
+
+  for (i = 0; i < batch->num_fights; i++) {
+    SimulateFight(session, &start, batch->first_fight + i, batch);
+  }
+  DestroySession(session);
+  DestroyBackend(io);
+}
+
+/*******************************************************************************
+   Function: SimulateFight
+
+Description: Runs one fight of a simulation and records its result. The fight
+             depends only on its index (via its random number stream), never
+             on the fights run before it in the same session. Identical
+             enemies join the first of their type as they are created (see
+             "JoinStack"), so even a party of thousands needs few characters.
+
+     Inputs: session - Pointer to the batch's game session.
+             start   - The player's state at the start of every fight.
+             fight   - Index of the fight within the simulation.
+             batch   - Pointer to the batch, in which the result is recorded.
+
+    Outputs: None.
+*******************************************************************************/
+void SimulateFight(game_session_t *session, const game_character_t *start,
+                   int fight, sim_batch_t *batch) {
+  int i, j, enemy_hp = 0, damage_taken, turns;
+  const simulation_t *simulation = batch->simulation;
+  location_t *location = session->world[start->location];
+  game_character_t *p_gc, *leader;
+
+  session->random_seed = SplitSeed(simulation->seed, fight) >> 32;
+  session->player = *start;
+  for (i = 0; i < simulation->party_size; i++) {
+    leader = NULL;
+    for (j = 0; j < simulation->enemy_counts[i]; j++) {
+      p_gc = AddInhabitant(session, location, simulation->enemy_types[i]);
+      p_gc->relationship = HOSTILE_ENEMY;
+      enemy_hp += p_gc->hp;
+      if (leader != NULL && Stackable(leader, p_gc)) {
+        JoinStack(session, leader, p_gc);
+      } else {
+        AddEnemy(session, p_gc);
+        leader = p_gc;
+      }
+    }
+  }
+  session->policy->turns_taken = 0;
+  Combat(session);
+
+  // Record the outcome:
+  turns = session->policy->turns_taken;
+  if (session->exiting_to_menu) {
+    batch->draws++;
+    session->exiting_to_menu = false;
+  } else if (session->player.hp <= 0) {
+    batch->losses++;
+  } else {
+    batch->wins++;
+  }
+  damage_taken = start->hp - (session->player.hp > 0 ? session->player.hp : 0);
+  batch->total_turns += turns;
+  batch->total_damage_taken += damage_taken;
+  batch->turns[turns < SIM_HISTOGRAM_SIZE ? turns :
+                                            SIM_HISTOGRAM_SIZE - 1]++;
+  batch->damage_taken[damage_taken < SIM_HISTOGRAM_SIZE ?
+                      damage_taken : SIM_HISTOGRAM_SIZE - 1]++;
+
+  // Delete any surviving enemies, along with their timed statuses:
+  while (NumberOfEnemies(session) > 0) {
+    p_gc = GetEnemy(session, 0);
+    enemy_hp -= p_gc->hp > 0 ? p_gc->hp : 0;
+    for (j = 0; p_gc->stack != NULL && j < p_gc->stack->count; j++) {
+      enemy_hp -= p_gc->stack->hp[j] > 0 ? p_gc->stack->hp[j] : 0;
+    }
+    DiscardStack(p_gc);  // Rather than splitting the survivors off.
+    RemoveEnemy(session, p_gc);
+    DeleteInhabitant(session, session->world[p_gc->location], p_gc);
+  }
+  batch->total_damage_dealt += enemy_hp;
+  session->status_effects.num_afflicted = 0;
+}
+
+/*******************************************************************************
+   Function: SimulatedTurn
+
+Description: Takes the player's turn in a simulated fight: the player casts the
+             policy's spell (unless silenced) or attacks, always targeting the
+             first visible enemy. A fight that has gone on too long is
+             abandoned as a draw.
+
+     Inputs: session - Pointer to the current game session.
+             policy  - Pointer to the player's policy.
+
+    Outputs: None.
+*******************************************************************************/
+void SimulatedTurn(game_session_t *session, player_policy_t *policy) {
+  int i;
+  game_character_t *target = GetEnemy(session, 0);
+  character_handle_t targets[2] = {NO_CHARACTER, NO_CHARACTER};
+
+  if (++policy->turns_taken > SIM_MAX_TURNS) {
+    session->exiting_to_menu = true;
+    return;
+  }
+  for (i = 0; i < NumberOfEnemies(session); i++) {
+    if (GetEnemy(session, i)->status[INVISIBLE] == false) {
+      target = GetEnemy(session, i);
+      break;
+    }
+  }
+  if (policy->spell[0] != '\0' && session->player.status[SILENCED] == false) {
+    targets[0] = target->handle;
+    CastSpell(session, &session->player, (char *) policy->spell, targets);
+  } else {
+    Attack(session, &session->player, target);
+  }
+}
+
+/*******************************************************************************
+   Function: SplitSeed
+
+Description: Splits an independent random number stream off a master seed:
+             the seed and the stream's index are combined and thoroughly mixed
+             (as by the SplitMix64 generator), so that streams with nearby
+             indices are unrelated.
+
+     Inputs: seed  - The master seed.
+             index - Index of the stream of interest.
+
+    Outputs: A 64-bit seed for the stream.
+*******************************************************************************/
+uint64_t SplitSeed(uint64_t seed, uint64_t index) {
+  uint64_t z = seed + (index + 1) * 0x9E3779B97F4A7C15ull;
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+  return z ^ (z >> 31);
+}
+
+/*******************************************************************************
+   Function: MergeBatch
+
+Description: Adds a batch's results to a running total.
+
+     Inputs: total - Pointer to the total.
+             batch - Pointer to the batch of interest.
+
+    Outputs: None.
+*******************************************************************************/
+void MergeBatch(sim_batch_t *total, const sim_batch_t *batch) {
+  int i;
+
+  total->num_fights += batch->num_fights;
+  total->wins += batch->wins;
+  total->losses += batch->losses;
+  total->draws += batch->draws;
+  total->total_turns += batch->total_turns;
+  total->total_damage_taken += batch->total_damage_taken;
+  total->total_damage_dealt += batch->total_damage_dealt;
+  for (i = 0; i < SIM_HISTOGRAM_SIZE; i++) {
+    total->turns[i] += batch->turns[i];
+    total->damage_taken[i] += batch->damage_taken[i];
+  }
+}
+
+/*******************************************************************************
+   Function: PrintSimulationReport
+
+Description: Prints a simulation's results: the win rate, and the mean and
+             percentiles of the player's turns and damage taken per fight.
+
+     Inputs: simulation - Pointer to the simulation of interest.
+             total      - Pointer to the combined results of all its fights.
+
+    Outputs: None.
+*******************************************************************************/
+void PrintSimulationReport(const simulation_t *simulation,
+                           const sim_batch_t *total) {
+  int i;
+  double fights = total->num_fights;
+
+  printf("%d fights: Level %d player (%s%s) vs.", total->num_fights,
+         simulation->level, simulation->spell[0] != '\0' ? "casting " :
+                                                          "attacking",
+         simulation->spell);
+  for (i = 0; i < simulation->party_size; i++) {
+    printf("%s %d %s", i > 0 ? "," : "", simulation->enemy_counts[i],
+           character_type_ids[simulation->enemy_types[i]]);
+  }
+  printf(" (seed %llu)\n", (unsigned long long) simulation->seed);
+  printf("Wins: %ld (%.2f%%)  Losses: %ld (%.2f%%)  Draws: %ld (%.2f%%)\n",
+         total->wins, 100 * total->wins / fights, total->losses,
+         100 * total->losses / fights, total->draws,
+         100 * total->draws / fights);
+  printf("Player turns per fight: mean %.2f, 10th/50th/90th percentile "
+         "%d/%d/%d\n", total->total_turns / fights,
+         Percentile(total->turns, total->num_fights, 10),
+         Percentile(total->turns, total->num_fights, 50),
+         Percentile(total->turns, total->num_fights, 90));
+  printf("Damage taken per fight: mean %.2f, 10th/50th/90th percentile "
+         "%d/%d/%d\n", total->total_damage_taken / fights,
+         Percentile(total->damage_taken, total->num_fights, 10),
+         Percentile(total->damage_taken, total->num_fights, 50),
+         Percentile(total->damage_taken, total->num_fights, 90));
+  printf("Damage dealt per fight: mean %.2f\n",
+         total->total_damage_dealt / fights);
+}
+
+/*******************************************************************************
+   Function: Percentile
+
+Description: Finds a percentile of the values counted by a histogram.
+
+     Inputs: histogram - Number of occurrences of each value, from 0 up.
+             count     - Total number of occurrences.
+             percent   - The percentile of interest (0 to 100).
+
+    Outputs: The smallest value at or below which at least "percent" percent of
+             occurrences lie.
+*******************************************************************************/
+int Percentile(const long histogram[], long count, int percent) {
+  int i;
+  long seen = 0;
+
+  for (i = 0; i < SIM_HISTOGRAM_SIZE - 1; i++) {
+    seen += histogram[i];
+    if (seen * 100 >= count * percent) {
+      break;
+    }
+  }
+
+  return i;
+}
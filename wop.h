@@ -11,12 +11,25 @@ Description: Header file for the text-based fantasy RPG "Words of Power."
 
 #define _CRT_SECURE_NO_DEPRECATE
 
-#include <stdio.h>  // printf, scanf
-#include <stdlib.h>  // srand, rand
+#include <stdio.h>  // fwrite, getchar, vsnprintf
+#include <stdarg.h>  // va_list, va_start, va_end
+#include <stdlib.h>  // rand_r, malloc, free
 #include <time.h>  // time
 #include <ctype.h>  // toupper, isalnum
 #include <string.h>  // strlen, strcpy, strcmp
 #include <stdbool.h>  // bool, true, false
+#include <stdint.h>  // uintptr_t
+#include <ucontext.h>  // ucontext_t, getcontext, makecontext, swapcontext
+#include <errno.h>  // errno, EAGAIN, EINTR
+#include <fcntl.h>  // fcntl, O_NONBLOCK
+#include <unistd.h>  // read, close, unlink
+#include <sys/epoll.h>  // epoll_create1, epoll_ctl, epoll_wait
+#include <sys/socket.h>  // socket, bind, listen, accept, send
+#include <sys/un.h>  // sockaddr_un
+#include <netinet/in.h>  // sockaddr_in, htons, htonl
+#include <pthread.h>  // pthread_create, pthread_mutex_t, pthread_cond_t
+#include <stdatomic.h>  // atomic_int, atomic_fetch_add, atomic_fetch_sub
+#include <sys/mman.h>  // mmap, munmap, MAP_HUGETLB
 
 /*******************************************************************************
   Constants
@@ -27,21 +40,50 @@ Description: Header file for the text-based fantasy RPG "Words of Power."
 #define FAILURE false
 #define SUCCESS true
 #if DEBUG
-#define PRINT_ERROR_MESSAGE printf("ERROR: %s, line %d\n", __FILE__, __LINE__); FlushInput()
+#define PRINT_ERROR_MESSAGE PrintFormatted(session, "ERROR: %s, line %d\n", \
+                                           __FILE__, __LINE__); \
+                            FlushInput(session)
 #else
-#define PRINT_ERROR_MESSAGE FlushInput()
+#define PRINT_ERROR_MESSAGE FlushInput(session)
 #endif
 
 // String lengths and other max. values:
 #define SHORT_STR_LEN    50
 #define LONG_STR_LEN     500
 #define MAX_LINE_LENGTH  80  // including new line character
-#define MAX_ENEMIES      100  // per battle
-#define MAX_TARGETS      (MAX_ENEMIES * 2)  // per spell
 #define TOTAL_SECRETS    200  // to evaluate player progress
 #define MAX_MENU_OPTIONS 100
+
+// Arena memory allocation:
+#define ARENA_BLOCK_SIZE 4096  // Minimum size of each block of arena memory.
+#define ARENA_ALIGNMENT  16  // Alignment of each arena allocation (power of 2).
+#define HUGE_PAGE_SIZE   (2 * 1024 * 1024)
+#define WORLD_ARENA_BLOCK_SIZE (HUGE_PAGE_SIZE - 64)  // Most worlds fit in one.
+#define WORLD_HUGE_PAGES false  // If true, try to back worlds with huge pages.
 #define MAX_DESTINATIONS 20
 
+// Game character handles (see "character_handle_t"):
+#define NO_CHARACTER      0  // Refers to no character at all.
+#define HANDLE_INDEX_BITS 20  // Low bits hold a slot index, high a generation.
+#define HANDLE_INDEX_MASK ((1u << HANDLE_INDEX_BITS) - 1)
+#define CHARACTER_TABLE_CAPACITY 1024  // Initial size of a character table.
+#define ENEMY_ROSTER_CAPACITY    16  // Initial size of a battle's roster.
+#define STACK_CAPACITY           16  // Initial number of members per stack.
+
+// Timed status effects (see "status_effects_t"):
+#define FIRST_TIMED_STATUS ASLEEP  // Timed statuses run from "ASLEEP"...
+#define NUM_TIMED_STATUSES (SILENCED - ASLEEP + 1)  // ...to "SILENCED".
+#define AFFLICTED_CAPACITY 32  // Initial size of the table of timed statuses.
+#define POISON_DAMAGE      2  // HP lost per round while poisoned.
+
+// Resolution of attacks and spells (see "ResolveHits"):
+#define ATTACK_ACCURACY 80  // Percent chance of a physical attack hitting.
+#define SPELL_ACCURACY  100  // Spells never miss.
+#define NUM_HIT_ROLLS   3  // Random numbers per hit: to hit, damage, defense.
+
+// Inventories (see "inventory_t"):
+#define INLINE_ITEM_STACKS 2  // Item stacks held without an overflow array.
+
 // Default stats, representative of an average adult human:
 #define DEFAULT_HP               30
 #define DEFAULT_PHYSICAL_POWER   10
@@ -49,6 +91,8 @@ Description: Header file for the text-based fantasy RPG "Words of Power."
 #define DEFAULT_MENTAL_POWER     10
 #define DEFAULT_MENTAL_DEFENSE   10
 #define DEFAULT_SPEED            5
+#define ROUND_TICKS              1000  // Timeline ticks per round of combat.
+#define INITIATIVE_CAPACITY      32  // Initial size of the turn schedule.
 #define DEFAULT_EXP              10
 
 // Standard prices and price modifiers for goods and services:
@@ -62,9 +106,9 @@ Description: Header file for the text-based fantasy RPG "Words of Power."
 
 // Amount of experience needed to level-up:
 #define EXP_PER_LEVEL           100
-#define HP_LEVEL_UP_VALUE       RandomInt(5, 10)
-#define PHYSICAL_LEVEL_UP_VALUE RandomInt(0, 2)
-#define MENTAL_LEVEL_UP_VALUE   RandomInt(0, 2)
+#define HP_LEVEL_UP_VALUE       RandomInt(session, 5, 10)
+#define PHYSICAL_LEVEL_UP_VALUE RandomInt(session, 0, 2)
+#define MENTAL_LEVEL_UP_VALUE   RandomInt(session, 0, 2)
 
 // Values for different kinds of "souls":
 #define EXTREMELY_EVIL -30
@@ -75,6 +119,44 @@ Description: Header file for the text-based fantasy RPG "Words of Power."
 #define VERY_GOOD      15
 #define EXTREMELY_GOOD 30
 
+// Character type traits (see "character_types.h"):
+#define TRAIT_UNIQUE         (1 << 0)  // Only one such character exists.
+#define TRAIT_ACQUAINTED     (1 << 1)  // Knows, and is known to, the player.
+#define TRAIT_LOCAL_LANGUAGE (1 << 2)  // Speaks Ventarri or Imperial by region.
+#define TRAIT_INANIMATE      (1 << 3)  // Begins with status "INANIMATE".
+#define TRAIT_FIGHTS         (1 << 4)  // Fights if the player attacks others.
+#define TRAIT_FLEES          (1 << 5)  // Flees when losing a fight.
+#define TRAIT_HELPS          (1 << 6)  // Assists allies during combat.
+
+// Factions (see "factions.c"):
+#define UNAFFILIATED       NUM_GROUP_TYPES  // Faction of types in no group.
+#define NUM_FACTIONS       (NUM_GROUP_TYPES + 1)
+#define FACTION_BIT(group) (1u << (group))
+
+// Knowledge bitmasks (bit "i" stands for Word of Power or language "i"):
+#define WORD_BIT(word)         (1u << (word))
+#define LANGUAGE_BIT(language) (1u << (language))
+#define ALL_WORDS              ((1u << NUM_WORD_TYPES) - 1)
+#define ELEMENTAL_WORDS        (WORD_BIT(WORD_OF_FIRE)  | \
+                                WORD_BIT(WORD_OF_AIR)   | \
+                                WORD_BIT(WORD_OF_WATER) | \
+                                WORD_BIT(WORD_OF_EARTH))
+#define BENEFICIAL_WORDS       (WORD_BIT(WORD_OF_BODY)      | \
+                                WORD_BIT(WORD_OF_MIND)      | \
+                                WORD_BIT(WORD_OF_FLORA)     | \
+                                WORD_BIT(WORD_OF_FAUNA)     | \
+                                WORD_BIT(WORD_OF_LIGHT)     | \
+                                WORD_BIT(WORD_OF_DARKNESS)  | \
+                                WORD_BIT(WORD_OF_HEALTH)    | \
+                                WORD_BIT(WORD_OF_LIFE)      | \
+                                WORD_BIT(WORD_OF_HOLINESS)  | \
+                                WORD_BIT(WORD_OF_EVIL)      | \
+                                WORD_BIT(WORD_OF_INCREASE)  | \
+                                WORD_BIT(WORD_OF_DECREASE)  | \
+                                WORD_BIT(WORD_OF_SHIELDING) | \
+                                WORD_BIT(WORD_OF_TIME)      | \
+                                WORD_BIT(WORD_OF_VOID))
+
 // Values for important relationship thresholds:
 #define HOSTILE_ENEMY -10
 #define BAD_ENEMY     -5
@@ -87,10 +169,43 @@ Description: Header file for the text-based fantasy RPG "Words of Power."
 // Maximum number of Words allowed in a single spell:
 #define MAX_SPELL_LEN 8
 
+// Input/output:
+#define IO_EOF   -1  // Returned by "read_line" when no more input exists.
+#define IO_AGAIN -2  // Returned by "read_line" when input isn't here yet.
+
+// Resumable game sessions:
+#define SESSION_STACK_SIZE (256 * 1024)  // Bytes of stack per session.
+
+// Server mode:
+#define SERVER_BACKLOG      128  // Pending connections allowed by "listen".
+#define SERVER_MAX_EVENTS   64  // Events handled per call to "epoll_wait".
+#define SERVER_READ_SIZE    4096  // Bytes read from a connection at a time.
+#define SERVER_MAX_INPUT    (64 * 1024)  // Max. unread input per connection.
+
+// Worker pool:
+#define MAX_WORKERS         256
+#define WORK_QUEUE_CAPACITY 64  // Initial number of tasks per worker's queue.
+
+// Combat simulator (see "sim.c"):
+#define SIM_MAX_PARTY         16  // Enemy types per simulated fight.
+#define SIM_MAX_TURNS         1000  // Player turns before a fight is a draw.
+#define SIM_HISTOGRAM_SIZE    (SIM_MAX_TURNS + 2)  // Last bucket: "or more."
+#define SIM_BATCHES_PER_WORKER 16  // Fights are split into this many batches.
+#define SIM_PLAYER_NAME       "Tester"
+
+// Checks of the combat engine (see "check.c"):
+#define CHECK_SEED 7
+
 /*******************************************************************************
 Enumerations
 *******************************************************************************/
 
+enum SessionState {
+  SESSION_READY,  // Able to run (or running).
+  SESSION_AWAITING_INPUT,  // Suspended until more input is available.
+  SESSION_FINISHED  // The player has quit or input has ended.
+};
+
 enum WordType {
   WORD_OF_AIR,
   WORD_OF_WATER,
@@ -423,23 +538,70 @@ enum GroupType {
   NUM_GROUP_TYPES
 };
 
-enum Knowledge {
-  UNKNOWN,
-  PARTIALLY_KNOWN,
-  KNOWN
-};
-
 /*******************************************************************************
 Structures
 *******************************************************************************/
 
-typedef struct GameCharacter {
-  int type;
+// Refers to a game character by its slot in the world's character table and
+// the slot's generation, which changes whenever the slot's character is
+// deleted (see "GetCharacter"):
+typedef uint32_t character_handle_t;
+
+typedef struct CharacterType {
+  const char *name;  // NULL for types without an entry.
+  const char *descriptor;
+  unsigned int traits;  // TRAIT_UNIQUE, TRAIT_ACQUAINTED, etc.
+  int max_hp;
+  int physical_power;
+  int physical_defense;
+  int mental_power;
+  int mental_defense;
+  int speed;
+  int soul;
+  int relationship;
+  int level;
+  int experience;
+  int min_gold;
+  int max_gold;
+  uint32_t languages;  // Bit "i" set: language "i" is known.
+  uint32_t words;  // Bit "i" set: Word of Power "i" is known.
+  int group;  // The type's faction: a "GroupType" or UNAFFILIATED.
+} character_type_t;  // A game character type's defining data.
+
+typedef struct CharacterTemplate {
   bool unique;  // False for generic NPCs.
   char name[SHORT_STR_LEN + 1];  // Capitalized, even for generic NPCs.
   char descriptor[SHORT_STR_LEN + 1];  // Brief generic description.
   int level;
   int experience;  // "Total exp." for player, "exp. obtainable" for NPCs.
+  uint32_t known_words;  // Bitmask of Words of Power (see "WORD_BIT").
+  uint32_t partially_known_words;  // Seen but not understood (never known).
+  uint32_t known_languages;  // Bitmask of languages (see "LANGUAGE_BIT").
+} character_template_t;  // Data shared by all identical NPCs of a type.
+
+typedef struct ItemStack {
+  uint16_t type;
+  uint16_t equipped;  // Never more than "quantity".
+  int quantity;  // Always positive: empty stacks are removed.
+} item_stack_t;  // All of a character's items of a given type.
+
+typedef struct Inventory {
+  uint16_t count;  // Number of stacks, kept in order of item type.
+  uint16_t overflow_capacity;
+  item_stack_t stacks[INLINE_ITEM_STACKS];  // The first few stacks.
+  item_stack_t *overflow;  // Any further stacks (in arena memory).
+} inventory_t;  // Sized by the items held, not by the number of item types.
+
+typedef struct CharacterDetails {
+  int conversations;  // Number of conversations held with player.
+  bool knows_player;
+  bool known_to_player;
+  int gold;
+  inventory_t inventory;  // Includes equipped items.
+} character_details_t;  // Character data rarely needed in scans ("cold").
+
+typedef struct GameCharacter {  // Fields needed by scans and combat ("hot").
+  int type;
   int max_hp;
   int hp;
   int physical_power;
@@ -448,19 +610,18 @@ typedef struct GameCharacter {
   int mental_power;
   int mental_defense;
   int soul;  // Ranges from EXTREMELY_EVIL to EXTREMELY_GOOD.
-  enum Knowledge words[NUM_WORD_TYPES];  // Records known Words of Power.
-  enum Knowledge languages[NUM_LANGUAGE_TYPES];
-  int conversations;  // Number of conversations held with player.
-  bool knows_player;
-  bool known_to_player;
   int relationship;  // Relative to player: FRIEND, ENEMY, INDIFFERENT, etc.
-  int status[NUM_STATUS_TYPES];
-  int gold;
-  int inventory[NUM_ITEM_TYPES];  // Includes equipped items.
-  int equipped_items[NUM_ITEM_TYPES];
   int location;
-  struct GameCharacter *summoned_creature;  // Only one allowed at a time.
-  struct GameCharacter *next;  // For forming linked lists.
+  bool status[NUM_STATUS_TYPES];  // A byte each, not an "int," to stay small.
+  character_template_t *template;  // Shared unless unique (see above).
+  character_details_t *details;  // Kept apart so scans skip over it.
+  struct EnemyStack *stack;  // Identical enemies fighting with this one.
+  character_handle_t handle;  // Refers to this character.
+  character_handle_t summoned_creature;  // Only one allowed at a time.
+  character_handle_t next;  // For forming linked lists.
+  character_handle_t previous;  // For unlinking without a search.
+  character_handle_t next_fighter;  // For a location's lists of fighters.
+  character_handle_t previous_fighter;
 } game_character_t;
 
 typedef struct Location {
@@ -469,141 +630,527 @@ typedef struct Location {
   bool hidden;  // If true, special effort is required to find the location.
   int visits;  // Number of times player has visited the location.
   int searches;  // Number of times player has searched the location.
-  game_character_t *inhabitants;  // Linked list of local NPCs.
+  character_handle_t inhabitants;  // Linked list of local NPCs.
+  character_handle_t last_inhabitant;  // Tail of "inhabitants".
+  character_handle_t fighters[NUM_FACTIONS];  // Those willing to fight, by
+  character_handle_t last_fighter[NUM_FACTIONS];  // faction (see "factions.c").
 } location_t;
 
+typedef struct CharacterSlot {
+  game_character_t *p_gc;
+  uint32_t generation;  // Advanced whenever the character is deleted.
+} character_slot_t;  // An entry in a world's character table.
+
+typedef struct CharacterPool {
+  character_slot_t *slots;  // The world's character table (slot 0 unused).
+  int num_slots;
+  int capacity;
+  int free_list;  // A deleted character's slot, linked via "next" (or 0).
+  int num_in_use;  // Characters of the current world not yet deleted.
+  int high_water_mark;  // Most characters ever in use at once (any world).
+} character_pool_t;  // Recycles the game characters of a session's worlds.
+
+typedef struct IOBackend {
+  int (*write)(struct IOBackend *io, const char *data, int length);
+  int (*read_line)(struct IOBackend *io, char *buffer, int size);
+  char *input;  // Scripted input (memory, queue and null backends only).
+  int input_length;
+  int input_position;
+  int input_capacity;
+  bool input_closed;  // If false, more input may yet be appended.
+  char *output;  // Captured output (memory backend only).
+  int output_length;
+  int output_capacity;
+} io_backend_t;
+
+typedef struct TextWrapper {
+  char *buffer;  // The paragraph being wrapped (not NULL-terminated).
+  int length;
+  int capacity;
+  int line_start;  // Index of the first character of the current line.
+  int last_blank_space;  // Index of the current line's last blank (or -1).
+} text_wrapper_t;
+
+typedef struct ArenaBlock {
+  struct ArenaBlock *previous;  // The block allocated before this one.
+  size_t size;  // Number of bytes available in "data".
+  size_t used;  // Number of bytes of "data" already allocated.
+  bool mapped;  // If true, allocated via "mmap" rather than "malloc".
+  _Alignas(ARENA_ALIGNMENT) char data[];  // Aligned like each allocation.
+} arena_block_t;
+
+typedef struct Arena {
+  arena_block_t *current;  // Most recently added block (or NULL).
+  size_t block_size;  // Minimum size of new blocks (0: ARENA_BLOCK_SIZE).
+  bool huge_pages;  // If true, blocks are backed by huge pages if possible.
+} arena_t;
+
+typedef struct ArenaMark {
+  arena_block_t *block;
+  size_t used;
+} arena_mark_t;  // A saved arena position (see "ArenaMark").
+
+typedef struct StringBuilder {
+  arena_t *arena;  // Source of the string's memory.
+  char *data;  // The string being built (always NULL-terminated).
+  int length;
+  int capacity;
+} string_builder_t;
+
+typedef struct Hit {
+  int accuracy;  // Percent chance of hitting.
+  int low;  // Least base damage (from the attacker's stats).
+  int high;  // Most base damage (from the attacker's stats).
+  int defense;  // Most damage the defender's defense may prevent.
+  int rolls[NUM_HIT_ROLLS];  // Drawn beforehand (see "RollHits").
+  int hp;  // The defender's HP (updated by "ResolveHits").
+  int damage;  // Damage dealt (0 on a miss).
+  bool landed;
+} hit_t;  // One attacker/defender pair in a batch of hits.
+
+typedef struct EnemyStack {
+  int count;  // Members besides the leader (the enemy holding the stack).
+  int capacity;
+  int *hp;  // HP of each member besides the leader.
+} enemy_stack_t;  // Identical generic enemies fighting as one (see "Combat").
+
+typedef struct StatusEffects {
+  int num_afflicted;
+  int capacity;  // Grows as needed, so any number may be afflicted at once.
+  character_handle_t *afflicted;
+
+  // Rounds remaining, by timed status (minus "FIRST_TIMED_STATUS") and then by
+  // index within "afflicted" (0 if the status is not in effect):
+  int16_t *rounds[NUM_TIMED_STATUSES];
+
+  // Index within "afflicted" by character table slot, valid only if the entry
+  // there holds the character's handle (see "FindAfflicted"):
+  int *columns;
+  int num_columns;
+} status_effects_t;  // The world's timed statuses, packed by status type.
+
+typedef struct Turn {
+  int tick;  // When the combatant acts, on the battle's timeline.
+  int order;  // Breaks ties: whoever was scheduled first acts first.
+  character_handle_t combatant;
+  bool hostile;  // True for the player's foes (see "EnemyAI").
+} turn_t;
+
+typedef struct Initiative {
+  turn_t *turns;  // Binary min-heap, ordered by "tick" and then "order".
+  int num_turns;
+  int capacity;  // Grows as needed, so battles have no size limit.
+  int now;  // Tick of the turn most recently taken.
+  int next_order;
+} initiative_t;  // Decides who acts next in combat (see "NextCombatant").
+
+typedef struct GameSession {
+  io_backend_t *io;  // Destination of all output and source of all input.
+  bool silent;  // If true, no text is formatted or written (input still is).
+  text_wrapper_t wrapper;  // Word-wraps text passed to "PrintString".
+  arena_t scratch;  // Short-lived memory (e.g., text being composed).
+  arena_t world_arena;  // Holds the game world's locations and characters.
+  arena_t details_arena;  // Holds the details of the world's characters.
+  character_pool_t characters;  // Recycles the world's characters.
+  location_t *world[NUM_LOCATION_IDS];  // Pointers to all game locations.
+  bool world_exists;  // Indicates whether game world exists in memory.
+  bool player_has_quit;  // Indicates player's desire to quit the game.
+  bool exiting_to_menu;  // Indicates player's desire to exit to main menu.
+  int state;  // SESSION_READY, SESSION_AWAITING_INPUT or SESSION_FINISHED.
+  char *stack;  // Stack on which the game runs (see "RunSession").
+  ucontext_t context;  // Where the game left off while awaiting input.
+  ucontext_t caller;  // Where "RunSession" was called from.
+  int num_secrets_found;  // Number of "secrets" discovered by the player.
+  game_character_t player;  // "player.next" heads the list of companions.
+  character_template_t player_template;
+  character_details_t player_details;
+  character_template_t *templates[NUM_GC_TYPES][2];  // Shared, by region.
+  character_handle_t last_companion;  // Tail of the companions.
+  character_handle_t *enemies;  // The current battle's roster of enemies.
+  int num_enemies;  // Number of entries in use at the front of "enemies".
+  int enemies_capacity;  // Grows as needed, so battles have no size limit.
+  status_effects_t status_effects;  // Ticked by "TickStatusEffects".
+  initiative_t initiative;  // Turn order of the current battle.
+  struct PlayerPolicy *policy;  // If set, chooses the player's actions.
+  int missions[NUM_MISSION_TYPES];  // To track player progress.
+  int allegiances[NUM_GROUP_TYPES];  // Player's relationships with groups.
+  int num_kills[NUM_GC_TYPES];  // Number of each GC type killed.
+  int num_visible_of_type[NUM_GC_TYPES];  // Number of each GC type visible.
+  bool character_type_described[NUM_GC_TYPES];  // Helps when describing NPCs.
+  char name_definite[SHORT_STR_LEN + 1];  // Returned by "GetNameDefinite".
+  char name_indefinite[SHORT_STR_LEN + 1];  // Returned by "GetNameIndefinite".
+  char name_plural[SHORT_STR_LEN + 1];  // Returned by "GetNamePlural".
+  char item_name[SHORT_STR_LEN + 1];  // Returned by "GetItemName".
+  char item_name_plural[SHORT_STR_LEN + 1];  // By "GetItemNamePlural".
+  unsigned int random_seed;  // State for the session's random number stream.
+} game_session_t;  // All state belonging to a single game in progress.
+
+typedef struct PlayerPolicy {
+  void (*take_turn)(game_session_t *session, struct PlayerPolicy *policy);
+  const char *spell;  // Cast each turn, unless empty (then attack instead).
+  int turns_taken;
+} player_policy_t;  // Plays the player's combat turns (see "sim.c").
+
+typedef struct Connection {
+  int fd;
+  int epoll_fd;  // The server's "epoll" instance.
+  bool registered;  // Indicates whether "fd" has been added to "epoll_fd".
+  io_backend_t *io;  // Queue backend: socket input in, game output out.
+  game_session_t *session;
+  int output_sent;  // Number of characters of "io->output" already sent.
+} connection_t;  // A remote player connected to the server.
+
+typedef struct Task {
+  void (*run)(void *argument);
+  void *argument;
+} task_t;
+
+typedef struct WorkQueue {
+  pthread_mutex_t lock;
+  task_t *tasks;  // Circular buffer of tasks.
+  int first;  // Index of the oldest task.
+  int count;
+  int capacity;
+} work_queue_t;  // Owner takes the newest task; thieves take the oldest.
+
+typedef struct Worker {
+  struct WorkerPool *pool;
+  int index;
+  pthread_t thread;
+  work_queue_t queue;
+} worker_t;
+
+typedef struct WorkerPool {
+  worker_t *workers;
+  int num_workers;
+  atomic_uint next_worker;  // Receives the next submitted task.
+  atomic_int num_pending;  // Number of tasks waiting in all queues.
+  pthread_mutex_t lock;  // Guards "stopping" and sleeping on "work_ready".
+  pthread_cond_t work_ready;
+  bool stopping;
+} worker_pool_t;
+
+typedef struct Simulation {
+  int num_fights;
+  int level;  // The player's level.
+  int enemy_types[SIM_MAX_PARTY];
+  int enemy_counts[SIM_MAX_PARTY];  // Number of enemies of each type.
+  int party_size;  // Number of entries in "enemy_types" and "enemy_counts".
+  char spell[MAX_SPELL_LEN + 1];  // The player's spell (if empty, attack).
+  uint64_t seed;  // Every fight's random number stream is split from this.
+} simulation_t;  // A matchup to be fought over and over (see "sim.c").
+
+typedef struct SimBatch {
+  const simulation_t *simulation;
+  int first_fight;  // Index of the batch's first fight.
+  int num_fights;
+  bool failed;  // If true, the batch could not be run.
+  long wins;
+  long losses;
+  long draws;  // Fights abandoned after SIM_MAX_TURNS player turns.
+  long total_turns;  // Player turns, summed over all fights.
+  long total_damage_taken;  // Player HP lost, summed over all fights.
+  long total_damage_dealt;  // Enemy HP lost, summed over all fights.
+  long turns[SIM_HISTOGRAM_SIZE];  // Number of fights by player turns.
+  long damage_taken[SIM_HISTOGRAM_SIZE];  // Number of fights by HP lost.
+} sim_batch_t;  // Consecutive fights run as one task, and their results.
+
 /*******************************************************************************
-Global Variables
+Global Constants
 *******************************************************************************/
 
-location_t *g_world[NUM_LOCATION_IDS];  // Pointers to all game locations.
-bool g_world_exists;  // Indicates whether game world exists in memory.
-bool g_player_has_quit;  // Indicates player's desire to quit the game.
-int g_num_secrets_found;  // Number of "secrets" discovered by the player.
-game_character_t g_player;
-game_character_t *g_enemies[MAX_ENEMIES];
-int g_missions[NUM_MISSION_TYPES];  // To track player progress.
-int g_allegiances[NUM_GROUP_TYPES];  // Player's relationships with groups.
-int g_num_kills[NUM_GC_TYPES];  // Number of each GC type killed.
-int g_num_visible_of_type[NUM_GC_TYPES];  // Number of each GC type visible.
-bool g_character_type_described[NUM_GC_TYPES];  // Helps when describing NPCs.
+extern const character_type_t character_types[NUM_GC_TYPES];
 
 /*******************************************************************************
 Function Prototypes
 *******************************************************************************/
 
 // Function prototypes for "main.c":
-int main(void);
-void HandleMainMenuInput(void);
-void HandleStandardOptionsInput(void);
-bool SaveGame(const char *filename);
-bool LoadGame(const char *filename);
-int CreateWorld(void);
-int DestroyWorld(void);
-bool GetExitConfirmation(void);
-int RandomInt(int low, int high);
-int RandomBool(void);
-char GetCharInput(char *c);
-int GetIntInput(int *i, int low, int high);
-char *GetStrInput(char *str, int n);
-void PrintString(char *str);
+int main(int argc, char *argv[]);
+game_session_t *CreateSession(unsigned int seed, io_backend_t *io);
+void DestroySession(game_session_t *session);
+void HandleMainMenuInput(game_session_t *session);
+void HandleStandardOptionsInput(game_session_t *session);
+bool SaveGame(game_session_t *session, const char *filename);
+bool LoadGame(game_session_t *session, const char *filename);
+int CreateWorld(game_session_t *session);
+int DestroyWorld(game_session_t *session);
+bool GetExitConfirmation(game_session_t *session);
+int RandomInt(game_session_t *session, int low, int high);
+int RandomBool(game_session_t *session);
+char GetCharInput(game_session_t *session, char *c);
+int GetIntInput(game_session_t *session, int *i, int low, int high);
+char *GetStrInput(game_session_t *session, char *str, int n);
+void PrintString(game_session_t *session, char *str);
+int PrintFormatted(game_session_t *session, const char *format, ...);
 char *Capitalize(char *str);
 char *AllCaps(char *str);
 bool StrContains(char *str, char c);
-void FlushInput(void);
+void FlushInput(game_session_t *session);
+int ReadLine(game_session_t *session, char *buffer, int size);
+
+// Function prototypes for "io.c":
+io_backend_t *CreateStdioBackend(void);
+io_backend_t *CreateMemoryBackend(const char *input);
+io_backend_t *CreateNullBackend(const char *input);
+io_backend_t *CreateQueueBackend(void);
+io_backend_t *CreateRepeatingBackend(const char *line);
+int AppendInput(io_backend_t *io, const char *data, int length);
+void CloseInput(io_backend_t *io);
+void DestroyBackend(io_backend_t *io);
+io_backend_t *CreateBackend(const char *input);
+int StdioWrite(io_backend_t *io, const char *data, int length);
+int StdioReadLine(io_backend_t *io, char *buffer, int size);
+int MemoryWrite(io_backend_t *io, const char *data, int length);
+int MemoryReadLine(io_backend_t *io, char *buffer, int size);
+int RepeatingReadLine(io_backend_t *io, char *buffer, int size);
+int NullWrite(io_backend_t *io, const char *data, int length);
+int WrapText(game_session_t *session, const char *text);
+int FlushWrappedText(game_session_t *session);
+
+// Function prototypes for "session.c":
+int RunSession(game_session_t *session);
+void StartSession(unsigned int address_high, unsigned int address_low);
+void PlayGame(game_session_t *session);
+int WaitForInput(game_session_t *session);
+bool GameInterrupted(game_session_t *session);
+
+// Function prototypes for "server.c":
+int RunServer(const char *address, int num_workers);
+int OpenListener(const char *address);
+int AcceptConnections(int epoll_fd, int listener, unsigned int *seed,
+                      worker_pool_t *pool);
+int ReadFromConnection(connection_t *connection);
+void ServiceConnection(void *argument);
+int FlushConnection(connection_t *connection);
+void CloseConnection(connection_t *connection);
+int SetNonBlocking(int fd);
+
+// Function prototypes for "sim.c":
+int RunSimulation(int argc, char *argv[]);
+int ParseSimulation(int argc, char *argv[], simulation_t *simulation,
+                    int *num_workers);
+int FindCharacterType(const char *id);
+void RunSimulationBatch(void *argument);
+void SimulateFight(game_session_t *session, const game_character_t *start,
+                   int fight, sim_batch_t *batch);
+void SimulatedTurn(game_session_t *session, player_policy_t *policy);
+uint64_t SplitSeed(uint64_t seed, uint64_t index);
+void MergeBatch(sim_batch_t *total, const sim_batch_t *batch);
+void PrintSimulationReport(const simulation_t *simulation,
+                           const sim_batch_t *total);
+int Percentile(const long histogram[], long count, int percent);
+
+// Function prototypes for "check.c":
+int CheckEnemySummonActs(bool mid_battle);
+int CheckEnemyStack(void);
+
+// Function prototypes for "pool.c":
+worker_pool_t *CreateWorkerPool(int num_workers);
+void DestroyWorkerPool(worker_pool_t *pool);
+int SubmitTask(worker_pool_t *pool, void (*run)(void *argument),
+               void *argument);
+void *RunWorker(void *argument);
+bool TakeTask(work_queue_t *queue, task_t *task, bool newest);
+bool StealTask(worker_pool_t *pool, int thief, task_t *task);
+int PushTask(work_queue_t *queue, task_t task);
+
+// Function prototypes for "arena.c":
+void *ArenaAllocate(arena_t *arena, size_t size);
+bool ArenaExtend(arena_t *arena, void *memory, size_t old_size,
+                 size_t new_size);
+arena_mark_t ArenaMark(arena_t *arena);
+void ArenaRelease(arena_t *arena, arena_mark_t mark);
+void ResetArena(arena_t *arena);
+void DestroyArena(arena_t *arena);
+arena_block_t *AddArenaBlock(arena_t *arena, size_t size);
+void FreeArenaBlock(arena_block_t *block);
+void InitStringBuilder(string_builder_t *sb, arena_t *arena);
+int AppendString(string_builder_t *sb, const char *str);
+int AppendChar(string_builder_t *sb, char c);
+int AppendInt(string_builder_t *sb, int value);
+int AppendFormatted(string_builder_t *sb, const char *format, ...);
+void ClearString(string_builder_t *sb);
+int ReserveString(string_builder_t *sb, int extra);
 
 // Function prototypes for "locations.c":
-int InitializeLocation(location_t *location, int id);
+int InitializeLocation(game_session_t *session, location_t *location, int id);
 bool InVentarrisTerritory(location_t *location);
-game_character_t *AddInhabitant(location_t *location, int type);
-int AddInhabitants(location_t *location, int type, int amount);
-game_character_t *FindInhabitant(int type);
-int MoveInhabitant(game_character_t *inhabitant, int destination);
-int RemoveInhabitant(location_t *location, game_character_t *inhabitant);
-int DeleteInhabitant(location_t *location, game_character_t *inhabitant);
-int VisibleInhabitants(location_t *location);
-int HandleMovementMenuInput(void);
-int MovePlayer(int destination);
-int SearchLocation(location_t *location);
-void DescribeSituation(void);
+game_character_t *AddInhabitant(game_session_t *session, location_t *location,
+                                int type);
+int AddInhabitants(game_session_t *session, location_t *location, int type,
+                   int amount);
+game_character_t *FirstLocalInhabitant(game_session_t *session);
+game_character_t *FindInhabitant(game_session_t *session, int type);
+void LinkInhabitant(game_session_t *session, location_t *location,
+                    game_character_t *inhabitant);
+int UnlinkInhabitant(game_session_t *session, location_t *location,
+                     game_character_t *inhabitant);
+int MoveInhabitant(game_session_t *session, game_character_t *inhabitant,
+                   int destination);
+int RemoveInhabitant(game_session_t *session, location_t *location,
+                     game_character_t *inhabitant);
+int DeleteInhabitant(game_session_t *session, location_t *location,
+                     game_character_t *inhabitant);
+int VisibleInhabitants(game_session_t *session, location_t *location);
+int HandleMovementMenuInput(game_session_t *session);
+int MovePlayer(game_session_t *session, int destination);
+int SearchLocation(game_session_t *session, location_t *location);
+void DescribeSituation(game_session_t *session);
 
 // Function prototypes for "characters.c":
-int InitializeCharacter(game_character_t *p_gc, int type,
+int InitializeCharacter(game_session_t *session, game_character_t *p_gc,
+                        int type,
                         location_t *location);
-int AddCompanion(game_character_t *companion);
-int RemoveCompanion(game_character_t *companion);
-int DeleteCompanion(game_character_t *companion);
-game_character_t *AddSummonedCreature(game_character_t *summoner, int type);
-int DeleteCreatureSummonedBy(game_character_t *summoner);
-int DisplayCharacterData(game_character_t *p_gc);
-int PrintSoulDescription(game_character_t *p_gc);
+character_template_t *GetTemplate(game_session_t *session, int type,
+                                  const character_type_t *prototype,
+                                  location_t *location);
+void BuildTemplate(character_template_t *template,
+                   const character_type_t *prototype, location_t *location);
+game_character_t *AllocateCharacter(game_session_t *session);
+void ReleaseCharacter(game_session_t *session, game_character_t *p_gc);
+int ReserveCharacters(game_session_t *session, int amount);
+int AddCharacterSlot(game_session_t *session, game_character_t *p_gc);
+game_character_t *GetCharacter(game_session_t *session,
+                               character_handle_t handle);
+void AppendCharacter(game_session_t *session, character_handle_t *head,
+                     character_handle_t *tail, game_character_t *p_gc);
+int UnlinkCharacter(game_session_t *session, character_handle_t *head,
+                    character_handle_t *tail, game_character_t *p_gc);
+int AddCompanion(game_session_t *session, game_character_t *companion);
+int RemoveCompanion(game_session_t *session, game_character_t *companion);
+int DeleteCompanion(game_session_t *session, game_character_t *companion);
+game_character_t *AddSummonedCreature(game_session_t *session,
+                                      game_character_t *summoner, int type);
+int DeleteCreatureSummonedBy(game_session_t *session,
+                             game_character_t *summoner);
+int DisplayCharacterData(game_session_t *session, game_character_t *p_gc);
+int PrintSoulDescription(game_session_t *session, game_character_t *p_gc);
 bool IsGood(game_character_t *p_gc);
 bool IsEvil(game_character_t *p_gc);
 bool IsNeutral(game_character_t *p_gc);
-int NumberOfLanguagesKnown(game_character_t *p_gc);
-int NumberOfWordsKnown(game_character_t *p_gc);
-char *GetNameDefinite(game_character_t *p_gc);
-char *GetNameIndefinite(game_character_t *p_gc);
-char *GetNamePlural(game_character_t *p_gc);
-bool CheckStatus(void);
-void UpdateVisibleGameCharCounter(void);
-game_character_t *GetTarget(void);
-bool IsTargeted(game_character_t *p_gc, game_character_t *targets[]);
-int HealGameCharacter(game_character_t *p_gc, int amount);
-int DamageGameCharacter(game_character_t *p_gc, int amount);
-int GainExperience(int amount);
-void LevelUp(void);
-void LearnLanguage(int language);
-void LearnWord(int word);
+int NumberOfLanguagesKnown(game_session_t *session, game_character_t *p_gc);
+int NumberOfWordsKnown(game_session_t *session, game_character_t *p_gc);
+char *GetNameDefinite(game_session_t *session, game_character_t *p_gc);
+char *GetNameIndefinite(game_session_t *session, game_character_t *p_gc);
+char *GetNamePlural(game_session_t *session, game_character_t *p_gc);
+bool CheckStatus(game_session_t *session);
+void UpdateVisibleGameCharCounter(game_session_t *session);
+game_character_t *GetTarget(game_session_t *session);
+bool IsTargeted(game_character_t *p_gc, character_handle_t targets[]);
+int HealGameCharacter(game_session_t *session, game_character_t *p_gc,
+                      int amount);
+int DamageGameCharacter(game_session_t *session, game_character_t *p_gc,
+                        int amount);
+int GainExperience(game_session_t *session, int amount);
+void LevelUp(game_session_t *session);
+void LearnLanguage(game_session_t *session, int language);
+void LearnWord(game_session_t *session, int word);
 
 // Function prototypes for "combat.c":
-int AddEnemy(game_character_t *p_gc);
-int AddRandomEnemy(location_t *location);
-int RemoveEnemy(game_character_t *p_gc);
-int DeleteEnemy(game_character_t *p_gc);
-int NumberOfEnemies(void);
-int VisibleEnemies(void);
-int Combat(void);
-void PrintCombatStatus(game_character_t *p_gc);
-int EnemyAI(int index);
-int HandleAttackMenuInput(void);
-int Attack(game_character_t *attacker, game_character_t *defender);
+int AddEnemy(game_session_t *session, game_character_t *p_gc);
+int AddRandomEnemy(game_session_t *session, location_t *location);
+int RemoveEnemy(game_session_t *session, game_character_t *p_gc);
+int DeleteEnemy(game_session_t *session, game_character_t *p_gc);
+int NumberOfEnemies(game_session_t *session);
+int RemoveDeadEnemies(game_session_t *session, string_builder_t *report);
+int SweepStack(game_session_t *session, game_character_t *leader,
+               string_builder_t *report);
+game_character_t *GetEnemy(game_session_t *session, int index);
+int VisibleEnemies(game_session_t *session);
+int Combat(game_session_t *session);
+void PrintEnemyStats(game_session_t *session);
+void StackEnemies(game_session_t *session);
+bool Stackable(game_character_t *p_gc, game_character_t *other);
+int JoinStack(game_session_t *session, game_character_t *leader,
+              game_character_t *p_gc);
+game_character_t *SplitFromStack(game_session_t *session,
+                                 game_character_t *leader);
+void DiscardStack(game_character_t *leader);
+int StackSize(game_character_t *p_gc);
+void PrintCombatStatus(game_session_t *session, game_character_t *p_gc);
+void StartInitiative(game_session_t *session);
+int ScheduleCombatant(game_session_t *session, game_character_t *p_gc,
+                      bool hostile);
+int ScheduleTurn(game_session_t *session, game_character_t *p_gc, int tick,
+                 bool hostile);
+game_character_t *NextCombatant(game_session_t *session, int end_tick,
+                                bool *hostile);
+int TurnDelay(game_character_t *p_gc);
+int HandleCombatMenuInput(game_session_t *session);
+int EnemyAI(game_session_t *session, game_character_t *enemy);
+int AllyAI(game_session_t *session, game_character_t *ally);
+int ApplyStatus(game_session_t *session, game_character_t *p_gc, int status,
+                int rounds);
+void TickStatusEffects(game_session_t *session);
+int FindAfflicted(status_effects_t *effects, game_character_t *p_gc);
+int GrowStatusEffects(game_session_t *session, int slot);
+void RemoveAfflicted(status_effects_t *effects, int index);
+bool CanAct(game_character_t *p_gc);
+int HandleAttackMenuInput(game_session_t *session);
+int Attack(game_session_t *session, game_character_t *attacker,
+           game_character_t *defender);
+int StackAttack(game_session_t *session, game_character_t *leader,
+                game_character_t *defender);
+void PrepareAttack(hit_t *hit, game_character_t *attacker,
+                   game_character_t *defender);
+void RollHits(game_session_t *session, int count, hit_t hits[]);
+void ResolveHits(int count, hit_t hits[], int minimum);
 bool WillingToFight(game_character_t *p_gc);
 bool WillingToFlee(game_character_t *p_gc);
 bool WillingToHelp(game_character_t *p_gc);
 
+// Function prototypes for "factions.c":
+uint32_t RespondingFactions(game_session_t *session,
+                            game_character_t *victim);
+int RallyDefenders(game_session_t *session, location_t *location,
+                   game_character_t *victim);
+void LinkFighter(game_session_t *session, location_t *location,
+                 game_character_t *fighter);
+int UnlinkFighter(game_session_t *session, location_t *location,
+                  game_character_t *fighter);
+
 // Function prototypes for "dialogue.c":
-int HandleTalkMenuInput(void);
-int Dialogue(game_character_t *p_gc);
-int LanguageLearningDialogue(game_character_t *p_gc);
-int WordLearningDialogue(game_character_t *p_gc);
+int HandleTalkMenuInput(game_session_t *session);
+int Dialogue(game_session_t *session, game_character_t *p_gc);
+int LanguageLearningDialogue(game_session_t *session, game_character_t *p_gc);
+int WordLearningDialogue(game_session_t *session, game_character_t *p_gc);
 double GetPriceModifier(game_character_t *merchant);
-int Transaction(game_character_t *merchant, int price);
-char *LanguageName(int type);
+int Transaction(game_session_t *session, game_character_t *merchant, int price);
+char *LanguageName(game_session_t *session, int type);
 
 // Function prototypes for "magic.c":
-int HandleSpellMenuInput(void);
-int CastSpell(game_character_t *spellcaster, char *spell,
-              game_character_t *targets[]);
+int HandleSpellMenuInput(game_session_t *session);
+int CastSpell(game_session_t *session, game_character_t *spellcaster,
+              char *spell,
+              character_handle_t targets[]);
 bool CanCastBeneficialSpells(game_character_t *p_gc);
-int PrintKnownWords(void);
-char *GetWord(int type);
-char *GetWordStartingWith(char first_letter);
-char *GetWordName(int type);
-int GetWordTypeFromChar(char first_letter);
+int PrintKnownWords(game_session_t *session);
+char *GetWord(game_session_t *session, int type);
+char *GetWordStartingWith(game_session_t *session, char first_letter);
+char *GetWordName(game_session_t *session, int type);
+int GetWordTypeFromChar(game_session_t *session, char first_letter);
 bool IsSpellcaster(game_character_t *p_gc);
 
-// Function prototypes for "item.c":
-int HandleItemMenuInput(void);
-int UseItem(game_character_t *p_gc, int item);
-int PrintInventory(game_character_t *p_gc);
-char *GetItemName(int item);
-char *GetItemNamePlural(int item);
-int GiveGold(game_character_t *giver, game_character_t *receiver, int amount);
-int AddItem(game_character_t *receiver, int item);
-int GiveItem(game_character_t *giver, game_character_t *receiver, int item);
-int GiveItems(game_character_t *giver, game_character_t *receiver, int item,
+// Function prototypes for "items.c":
+int HandleItemMenuInput(game_session_t *session);
+int UseItem(game_session_t *session, game_character_t *p_gc, int item);
+int PrintInventory(game_session_t *session, game_character_t *p_gc);
+char *GetItemName(game_session_t *session, int item);
+char *GetItemNamePlural(game_session_t *session, int item);
+int GiveGold(game_session_t *session, game_character_t *giver,
+             game_character_t *receiver, int amount);
+int AddItem(game_session_t *session, game_character_t *receiver, int item);
+int GiveItem(game_session_t *session, game_character_t *giver,
+             game_character_t *receiver, int item);
+int GiveItems(game_session_t *session, game_character_t *giver,
+              game_character_t *receiver, int item,
               int amount);
-int GetItemValue(int type);
+int GetItemValue(game_session_t *session, int type);
+int ItemQuantity(game_character_t *p_gc, int item);
+int ChangeItemQuantity(game_session_t *session, game_character_t *p_gc,
+                       int item, int change);
+item_stack_t *GetItemStack(inventory_t *inventory, int index);
+int FindItemStack(inventory_t *inventory, int item);
 
 #endif  // WOP_H_